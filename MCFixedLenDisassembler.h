@@ -15,6 +15,8 @@
 #ifndef CS_LLVM_MC_MCFIXEDLENDISASSEMBLER_H
 #define CS_LLVM_MC_MCFIXEDLENDISASSEMBLER_H
 
+#include <capstone/platform.h>
+
 // Disassembler state machine opcodes.
 enum DecoderOps {
 	MCD_OPC_ExtractField = 1, // OPC_ExtractField(uint8_t Start, uint8_t Len)
@@ -26,7 +28,24 @@ enum DecoderOps {
         MCD_OPC_TryDecode,        // OPC_TryDecode(uleb128 Opcode, uleb128 DIdx,
                                   //               uint16_t NumToSkip)	
 	MCD_OPC_SoftFail,         // OPC_SoftFail(uleb128 PMask, uleb128 NMask)
-	MCD_OPC_Fail              // OPC_Fail()
+	MCD_OPC_Fail,             // OPC_Fail()
+	MCD_OPC_ExtractFieldDispatch // OPC_ExtractFieldDispatch(uint8_t Start, uint8_t Len,
+				     //                          uint24_t NumToSkip[1 << Len])
 };
 
+/// Checks the key table of a decoder table (<TABLE>Keys), before probing it.
+/// It starts with the Start and Len of the key field, followed by a bitset
+/// of the field values the table can decode.
+/// Returns false if the table can not decode \p insn. Decoding it would fail
+/// without any change to the MCInst.
+static inline bool decoderTableMayDecode(const uint8_t *Keys, uint64_t insn)
+{
+#ifdef CAPSTONE_DECODER_BYTECODE
+	return true;
+#else
+	unsigned Key = (insn >> Keys[0]) & ((1u << Keys[1]) - 1);
+	return Keys[2 + Key / 8] & (1u << (Key % 8));
+#endif
+}
+
 #endif
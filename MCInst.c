@@ -4,6 +4,7 @@
 #include <Availability.h>
 #include <libkern/libkern.h>
 #else
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #endif
@@ -14,41 +15,39 @@
 #include "MCInst.h"
 #include "utils.h"
 
-#define MCINST_CACHE (ARR_SIZE(mcInst->Operands) - 1)
+#define MCINST_CACHE (MAX_MC_OPS - 1)
 
-void MCInst_Init(MCInst *inst, cs_arch arch)
+/// Initializes the fields which only some architectures use.
+/// Everybody else never reads them, so they are left untouched.
+static void MCInst_initArchFields(MCInst *inst, cs_arch arch)
 {
-	memset(inst, 0, sizeof(MCInst));
-	// unnecessary to initialize in loop . its expensive and inst->size should be honored
-	inst->Operands[0].Kind = kInvalid;
-	inst->Operands[0].ImmVal = 0;
-
-	inst->Opcode = 0;
-	inst->OpcodePub = 0;
-	inst->size = 0;
-	inst->has_imm = false;
-	inst->op1_size = 0;
-	inst->ac_idx = 0;
-	inst->popcode_adjust = 0;
-	inst->assembly[0] = '\0';
-	inst->wasm_data.type = WASM_OP_INVALID;
-	inst->xAcquireRelease = 0;
-	for (int i = 0; i < MAX_MC_OPS; ++i)
-		inst->tied_op_idx[i] = -1;
-	inst->isAliasInstr = false;
-	inst->fillDetailOps = false;
-	memset(&inst->hppa_ext, 0, sizeof(inst->hppa_ext));
-
-	// Set default assembly dialect.
 	switch (arch) {
 	default:
 		break;
 	case CS_ARCH_SYSTEMZ:
+		// Set default assembly dialect.
 		inst->MAI.assemblerDialect = SYSTEMZASMDIALECT_AD_HLASM;
 		break;
+	case CS_ARCH_EVM:
+		memset(inst->evm_data, 0, sizeof(inst->evm_data));
+		break;
+	case CS_ARCH_WASM:
+		memset(&inst->wasm_data, 0, sizeof(inst->wasm_data));
+		inst->wasm_data.type = WASM_OP_INVALID;
+		break;
+	case CS_ARCH_HPPA:
+		memset(&inst->hppa_ext, 0, sizeof(inst->hppa_ext));
+		break;
 	}
 }
 
+void MCInst_Init(MCInst *inst, cs_arch arch)
+{
+	memset(inst, 0, offsetof(MCInst, evm_data));
+	memset(inst->tied_op_idx, -1, sizeof(inst->tied_op_idx));
+	MCInst_initArchFields(inst, arch);
+}
+
 void MCInst_clear(MCInst *inst)
 {
 	inst->size = 0;
@@ -101,12 +101,13 @@ MCOperand *MCOperand_CreateImm1(MCInst *inst, int64_t Val);
 /// MCInst - Instances of this class represent a single low-level machine
 /// instruction.
 struct MCInst {
+	/// The fields up to the architecture specific ones are cleared for
+	/// every instruction by MCInst_Init().
 	unsigned OpcodePub;  // public opcode (<arch>_INS_yyy in header files <arch>.h)
 	uint8_t size;	// number of operands
 	bool has_imm;	// indicate this instruction has an X86_OP_IMM operand - used for ATT syntax
 	uint8_t op1_size; // size of 1st operand - for X86 Intel syntax
 	unsigned Opcode;  // private opcode
-	MCOperand Operands[MAX_MC_OPS];
 	cs_insn *flat_insn;	// insn to be exposed to public
 	uint64_t address;	// address of this insn
 	cs_struct *csh;	// save the main csh
@@ -123,20 +124,26 @@ struct MCInst {
 	uint8_t x86_prefix[4];
 	uint8_t imm_size;	// immediate size for X86_OP_IMM operand
 	bool writeback;		// writeback for ARM
-	int8_t tied_op_idx
-		[MAX_MC_OPS]; ///< Tied operand indices. Index = Src op; Value: Dest op
 	// operand access index for list of registers sharing the same access right (for ARM)
 	uint8_t ac_idx;
 	uint8_t popcode_adjust;   // Pseudo X86 instruction adjust
 	char assembly[8];	// for special instruction, so that we don't need printer
-	unsigned char evm_data[32];	// for EVM PUSH operand
-	cs_wasm_op wasm_data;    // for WASM operand
 	MCRegisterInfo *MRI;
 	uint8_t xAcquireRelease;   // X86 xacquire/xrelease
 	bool isAliasInstr; // Flag if this MCInst is an alias.
 	bool fillDetailOps; // If set, detail->operands gets filled.
-	hppa_ext hppa_ext;	///< for HPPA operand. Contains info about modifiers and their effect on the instruction
+	cs_opt_value detail_opt; ///< The detail to fill for this instruction. Set by the decode loop, usually to the CS_OPT_DETAIL option of the handle.
+	cs_opt_value detail_parts; ///< CS_OPT_DETAIL_<part> values of the parts to fill. 0 if detail is off.
 	MCAsmInfo MAI; ///< The equivalent to MCAsmInfo in LLVM. It holds flags relevant for the asm style to print.
+	int8_t tied_op_idx
+		[MAX_MC_OPS]; ///< Tied operand indices. Index = Src op; Value: Dest op
+	MCOperand Operands[MAX_MC_OPS];
+
+	/// Architecture specific fields. Only the architecture using them
+	/// initializes them.
+	unsigned char evm_data[32];	// for EVM PUSH operand
+	cs_wasm_op wasm_data;    // for WASM operand
+	hppa_ext hppa_ext;	///< for HPPA operand. Contains info about modifiers and their effect on the instruction
 };
 
 void MCInst_Init(MCInst *inst, cs_arch arch);
@@ -5,40 +5,10 @@
 #include "cs_priv.h"
 #include <capstone/platform.h>
 
-extern bool ARM_getFeatureBits(unsigned int mode, unsigned int feature);
-extern bool PPC_getFeatureBits(unsigned int mode, unsigned int feature);
-extern bool Mips_getFeatureBits(unsigned int mode, unsigned int feature);
-extern bool AArch64_getFeatureBits(unsigned int mode, unsigned int feature);
-extern bool TriCore_getFeatureBits(unsigned int mode, unsigned int feature);
-
 static bool testFeatureBits(const MCInst *MI, uint32_t Value)
 {
 	assert(MI && MI->csh);
-	switch (MI->csh->arch) {
-	default:
-		assert(0 && "Not implemented for current arch.");
-		return false;
-#ifdef CAPSTONE_HAS_ARM
-	case CS_ARCH_ARM:
-		return ARM_getFeatureBits(MI->csh->mode, Value);
-#endif
-#ifdef CAPSTONE_HAS_POWERPC
-	case CS_ARCH_PPC:
-		return PPC_getFeatureBits(MI->csh->mode, Value);
-#endif
-#ifdef CAPSTONE_HAS_MIPS
-	case CS_ARCH_MIPS:
-		return Mips_getFeatureBits(MI->csh->mode, Value);
-#endif
-#ifdef CAPSTONE_HAS_AARCH64
-	case CS_ARCH_AARCH64:
-		return AArch64_getFeatureBits(MI->csh->mode, Value);
-#endif
-#ifdef CAPSTONE_HAS_TRICORE
-	case CS_ARCH_TRICORE:
-		return TriCore_getFeatureBits(MI->csh->mode, Value);
-#endif
-	}
+	return CS_hasFeature(MI->csh, Value);
 }
 
 static bool matchAliasCondition(MCInst *MI, const MCRegisterInfo *MRI,
@@ -118,25 +88,71 @@ static inline bool validOpToPatter(const PatternsForOpcode *P)
 	return !(P->Opcode == 0 && P->PatternStart == 0 && P->NumPatterns == 0);
 }
 
+/// Builds the opcode index of the OpToPatterns table of the arch.
+/// It is built once per handle, on the first alias lookup.
+/// Returns false if it can't be allocated.
+static bool buildOpToPatternsIdx(cs_struct *handle,
+				 const PatternsForOpcode *OpToPatterns)
+{
+	size_t n = 0, i;
+
+	cs_mem_free(handle->alias_idx);
+	handle->alias_idx = NULL;
+	handle->alias_idx_size = 0;
+	handle->alias_idx_of = NULL;
+
+	while (validOpToPatter(&OpToPatterns[n]))
+		n++;
+	if (n == 0 || n >= UINT16_MAX)
+		return false;
+
+	// sorted by opcode, so the last one is the largest
+	handle->alias_idx_size = OpToPatterns[n - 1].Opcode + 1;
+	handle->alias_idx = cs_mem_calloc(handle->alias_idx_size,
+					  sizeof(*handle->alias_idx));
+	if (!handle->alias_idx) {
+		handle->alias_idx_size = 0;
+		return false;
+	}
+	for (i = 0; i < n; i++)
+		handle->alias_idx[OpToPatterns[i].Opcode] = i + 1;
+	handle->alias_idx_of = OpToPatterns;
+	return true;
+}
+
+/// Looks up the position @i of @Opcode in OpToPatterns.
+/// Returns false if there are no alias patterns for @Opcode.
+static bool findOpToPatterns(MCInst *MI, const PatternsForOpcode *OpToPatterns,
+			     unsigned Opcode, size_t *i)
+{
+	cs_struct *handle = MI->csh;
+
+	if (handle->alias_idx_of == OpToPatterns ||
+	    buildOpToPatternsIdx(handle, OpToPatterns)) {
+		if (Opcode >= handle->alias_idx_size ||
+		    handle->alias_idx[Opcode] == 0)
+			return false;
+		*i = handle->alias_idx[Opcode] - 1;
+		return true;
+	}
+
+	// no index, scan the table
+	size_t j = 0;
+	uint32_t PatternOpcode = OpToPatterns[j].Opcode;
+	while (PatternOpcode < Opcode && validOpToPatter(&OpToPatterns[j]))
+		PatternOpcode = OpToPatterns[++j].Opcode;
+	if (PatternOpcode != Opcode || !validOpToPatter(&OpToPatterns[j]))
+		return false;
+	*i = j;
+	return true;
+}
+
 const char *matchAliasPatterns(MCInst *MI, const AliasMatchingData *M)
 {
-	// TODO Rewrite to C
-
-	// auto It = lower_bound(M.OpToPatterns, MI->getOpcode(),
-	//                       [](const PatternsForOpcode &L, unsigned Opcode) {
-	//                         return L.Opcode < Opcode;
-	//                       });
-	// if (It == M.OpToPatterns.end() || It->Opcode != MI->getOpcode())
-	//   return nullptr;
-
-	// Binary search by opcode. Return false if there are no aliases for this
-	// opcode.
-	unsigned MIOpcode = MI->Opcode;
-	size_t i = 0;
-	uint32_t PatternOpcode = M->OpToPatterns[i].Opcode;
-	while (PatternOpcode < MIOpcode && validOpToPatter(&M->OpToPatterns[i]))
-		PatternOpcode = M->OpToPatterns[++i].Opcode;
-	if (PatternOpcode != MI->Opcode || !validOpToPatter(&M->OpToPatterns[i]))
+	// Look up the patterns of the opcode. Return false if there are no
+	// aliases for this opcode.
+	size_t i;
+	if (!findOpToPatterns(MI, M->OpToPatterns, MI->Opcode, &i))
 		return NULL;
 
 	// // Try all patterns for this opcode.
@@ -14,7 +14,7 @@ typedef struct {
 	uint64_t second;   // Bits
 } MnemonicBitsInfo;
 
-/// Map from opcode to pattern list by binary search.
+/// Map from opcode to pattern list.
 typedef struct {
 	uint32_t Opcode;
 	uint16_t PatternStart;
@@ -95,6 +95,14 @@ typedef struct MCRegisterInfo {
 	// encodings.
 } MCRegisterInfo;
 
+/// Static initializer for a MCRegisterInfo, taking the same arguments as
+/// MCRegisterInfo_InitMCRegisterInfo(). The register info of an architecture
+/// never changes, so it is a constant shared by all handles.
+#define MCREGISTERINFO_INIT(D, NR, RA, PC, C, NC, RURoots, NRU, DL, Strings, \
+		SubIndices, NumIndices, RET) \
+	{ (D), (NR), (RA), (PC), (C), (NC), (NRU), (RURoots), (DL), (Strings), \
+	  (SubIndices), (NumIndices), (RET) }
+
 void MCRegisterInfo_InitMCRegisterInfo(MCRegisterInfo *RI,
 		const MCRegisterDesc *D, unsigned NR, unsigned RA,
 		unsigned PC,
@@ -6,36 +6,6 @@
 #include "capstone/capstone.h"
 #include "utils.h"
 
-// create a cache for fast id lookup
-static unsigned short *make_id2insn(const insn_map *insns, unsigned int size)
-{
-	// NOTE: assume that the max id is always put at the end of insns array
-	unsigned short max_id = insns[size - 1].id;
-	unsigned int i;
-
-	unsigned short *cache =
-		(unsigned short *)cs_mem_calloc(max_id + 1, sizeof(*cache));
-
-	for (i = 1; i < size; i++)
-		cache[insns[i].id] = i;
-
-	return cache;
-}
-
-// look for @id in @insns, given its size in @max. first time call will update
-// @cache. return 0 if not found
-unsigned short insn_find(const insn_map *insns, unsigned int max,
-			 unsigned int id, unsigned short **cache)
-{
-	if (id > insns[max - 1].id)
-		return 0;
-
-	if (*cache == NULL)
-		*cache = make_id2insn(insns, max);
-
-	return (*cache)[id];
-}
-
 // Gives the id for the given @name if it is saved in @map.
 // Returns the id or -1 if not found.
 int name2id(const name_map *map, int max, const char *name)
@@ -72,7 +42,7 @@ const char *id2name(const name_map *map, int max, const unsigned int id)
 /// It will not add the same register twice.
 void map_add_implicit_write(MCInst *MI, uint32_t Reg)
 {
-	if (!MI->flat_insn->detail)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_IMPLICIT_REGS))
 		return;
 
 	uint16_t *regs_write = MI->flat_insn->detail->regs_write;
@@ -91,7 +61,7 @@ void map_add_implicit_write(MCInst *MI, uint32_t Reg)
 /// It will not add the same register twice.
 void map_add_implicit_read(MCInst *MI, uint32_t Reg)
 {
-	if (!MI->flat_insn->detail)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_IMPLICIT_REGS))
 		return;
 
 	uint16_t *regs_read = MI->flat_insn->detail->regs_read;
@@ -109,7 +79,7 @@ void map_add_implicit_read(MCInst *MI, uint32_t Reg)
 /// Removes a register from the implicit write register list.
 void map_remove_implicit_write(MCInst *MI, uint32_t Reg)
 {
-	if (!MI->flat_insn->detail)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_IMPLICIT_REGS))
 		return;
 
 	uint16_t *regs_write = MI->flat_insn->detail->regs_write;
@@ -135,7 +105,7 @@ void map_remove_implicit_write(MCInst *MI, uint32_t Reg)
 void map_implicit_reads(MCInst *MI, const insn_map *imap)
 {
 #ifndef CAPSTONE_DIET
-	if (!MI->flat_insn->detail)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_IMPLICIT_REGS))
 		return;
 
 	cs_detail *detail = MI->flat_insn->detail;
@@ -163,7 +133,7 @@ void map_implicit_reads(MCInst *MI, const insn_map *imap)
 void map_implicit_writes(MCInst *MI, const insn_map *imap)
 {
 #ifndef CAPSTONE_DIET
-	if (!MI->flat_insn->detail)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_IMPLICIT_REGS))
 		return;
 
 	cs_detail *detail = MI->flat_insn->detail;
@@ -191,7 +161,7 @@ void map_implicit_writes(MCInst *MI, const insn_map *imap)
 void add_group(MCInst *MI, unsigned /* arch_group */ group)
 {
 #ifndef CAPSTONE_DIET
-	if (!MI->flat_insn->detail)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_GROUPS))
 		return;
 
 	cs_detail *detail = MI->flat_insn->detail;
@@ -213,7 +183,7 @@ void add_group(MCInst *MI, unsigned /* arch_group */ group)
 void map_groups(MCInst *MI, const insn_map *imap)
 {
 #ifndef CAPSTONE_DIET
-	if (!MI->flat_insn->detail)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_GROUPS))
 		return;
 
 	cs_detail *detail = MI->flat_insn->detail;
@@ -248,34 +218,17 @@ const void *map_get_suppl_info(MCInst *MI, const insn_map *imap)
 
 // Search for the CS instruction id for the given @MC_Opcode in @imap.
 // return -1 if none is found.
+// The auto-sync mapping tables are generated in MC opcode order
+// (checked by IncGenerator.check_mapping_order()), so the opcode is the index.
 unsigned int find_cs_id(unsigned MC_Opcode, const insn_map *imap,
 			unsigned imap_size)
 {
-	// binary searching since the IDs are sorted in order
-	unsigned int left, right, m;
-	unsigned int max = imap_size;
-
-	right = max - 1;
-
-	if (MC_Opcode < imap[0].id || MC_Opcode > imap[right].id)
+	if (MC_Opcode >= imap_size)
 		// not found
 		return -1;
 
-	left = 0;
-
-	while (left <= right) {
-		m = (left + right) / 2;
-		if (MC_Opcode == imap[m].id) {
-			return m;
-		}
-
-		if (MC_Opcode < imap[m].id)
-			right = m - 1;
-		else
-			left = m + 1;
-	}
-
-	return -1;
+	CS_ASSERT_RET_VAL(imap[MC_Opcode].id == MC_Opcode, -1);
+	return MC_Opcode;
 }
 
 /// Sets the Capstone instruction id which maps to the @MI opcode.
@@ -355,14 +308,15 @@ DEFINE_get_detail_op(xtensa, Xtensa);
 /// 			So it can be toggled between disas() calls.
 bool map_use_alias_details(const MCInst *MI) {
 	assert(MI);
-	return (MI->csh->detail_opt & CS_OPT_ON) && !(MI->csh->detail_opt & CS_OPT_DETAIL_REAL);
+	return (MI->detail_opt & CS_OPT_ON) && !(MI->detail_opt & CS_OPT_DETAIL_REAL);
 }
 
 /// Sets the setDetailOps flag to @p Val.
-/// If detail == NULLit refuses to set the flag to true.
+/// If detail == NULL or the operands are not selected
+/// (CS_OPT_DETAIL_OPERANDS) it refuses to set the flag to true.
 void map_set_fill_detail_ops(MCInst *MI, bool Val) {
 	CS_ASSERT_RET(MI);
-	if (!detail_is_set(MI)) {
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		MI->fillDetailOps = false;
 		return;
 	}
@@ -37,10 +37,13 @@ typedef struct insn_map {
 #endif
 } insn_map;
 
-// look for @id in @m, given its size in @max. first time call will update
-// @cache. return 0 if not found
-unsigned short insn_find(const insn_map *m, unsigned int max, unsigned int id,
-			 unsigned short **cache);
+// look for @id in the id-to-index table @idx (MappingInsnIdx.inc), given its
+// size in @max. return 0 if not found
+static inline unsigned short insn_find(const unsigned short *idx,
+				       unsigned int max, unsigned int id)
+{
+	return id < max ? idx[id] : 0;
+}
 
 unsigned int find_cs_id(unsigned MC_Opcode, const insn_map *imap,
 			unsigned imap_size);
@@ -232,7 +235,15 @@ DEFINE_check_safe_inc(Mips, MIPS);
 static inline bool detail_is_set(const MCInst *MI)
 {
 	assert(MI && MI->flat_insn);
-	return MI->flat_insn->detail != NULL && MI->csh->detail_opt & CS_OPT_ON;
+	return MI->flat_insn->detail != NULL && MI->detail_opt & CS_OPT_ON;
+}
+
+/// Returns true if any of the @parts (CS_OPT_DETAIL_GROUPS, ...) of the
+/// detail should be filled.
+static inline bool detail_part_is_set(const MCInst *MI, unsigned parts)
+{
+	assert(MI && MI->flat_insn);
+	return MI->flat_insn->detail != NULL && (MI->detail_parts & parts);
 }
 
 static inline cs_detail *get_detail(const MCInst *MI)
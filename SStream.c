@@ -26,6 +26,45 @@ void SStream_Init(SStream *ss)
 	ss->is_closed = false;
 	ss->markup_stream = false;
 	ss->prefixed_by_markup = false;
+	ss->mnem_only = false;
+	ss->mnem_started = false;
+	ss->mnem_done = false;
+	ss->mnem_end = 0;
+}
+
+/**
+ * Record where the mnemonic ends, if the characters written from \p start on
+ * complete it. A stream which only keeps the mnemonic is cut there and closed.
+ */
+static void SStream_track_mnem(SStream *ss, int start) {
+	if (ss->mnem_end)
+		return;
+	for (int i = start; i < ss->index && i < SSTREAM_BUF_LEN - 1; i++) {
+		char c = ss->buffer[i];
+		if (c != ' ' && c != '\t') {
+			ss->mnem_started = true;
+			continue;
+		}
+		if (!ss->mnem_started)
+			continue;
+		ss->mnem_end = i;
+		if (ss->mnem_only) {
+			ss->buffer[i] = '\0';
+			ss->index = i;
+			ss->is_closed = true;
+			ss->mnem_done = true;
+		}
+		return;
+	}
+}
+
+/**
+ * Find the end of the mnemonic again, after the buffer was changed in place.
+ */
+static void SStream_retrack_mnem(SStream *ss) {
+	ss->mnem_started = false;
+	ss->mnem_end = 0;
+	SStream_track_mnem(ss, 0);
 }
 
 /// Returns the a pointer to the internal string buffer of the stream.
@@ -48,6 +87,7 @@ const char *SStream_replc(const SStream *ss, char elem, char repl) {
 	}
 	*found = repl;
 	found++;
+	SStream_retrack_mnem((SStream *)ss);
 	return found;
 }
 
@@ -68,6 +108,7 @@ void SStream_replc_str(SStream *ss, char chr, const char *rstr) {
 	memmove(found + repl_len, found + 1, post_len);
 	memcpy(found, rstr, repl_len);
 	ss->index = strlen(ss->buffer);
+	SStream_retrack_mnem(ss);
 }
 
 /// Removes the space characters '\t' and ' ' from the beginning of the stream buffer.
@@ -81,43 +122,42 @@ void SStream_trimls(SStream *ss) {
 	if (buf_off > 0) {
 		memmove(ss->buffer, ss->buffer + buf_off, SSTREAM_BUF_LEN - buf_off);
 		ss->index -= buf_off;
+		// only blanks in front of the mnemonic are removed
+		if (ss->mnem_end)
+			ss->mnem_end -= buf_off;
 	}
 }
 
 /// Extract the mnemonic to @mnem_buf and the operand string into @op_str_buf from the stream buffer.
 /// The mnemonic is everything up until the first ' ' or '\t' character.
 /// The operand string is everything after the first ' ' or '\t' sequence.
+/// Both are terminated with a '\0' byte. The end of the mnemonic was recorded
+/// while the stream was written, only a stream starting with blanks is searched.
 void SStream_extract_mnem_opstr(const SStream *ss, char *mnem_buf, size_t mnem_buf_size, char *op_str_buf, size_t op_str_buf_size) {
 	assert(ss && mnem_buf && mnem_buf_size > 0 && op_str_buf && op_str_buf_size > 0);
-	size_t off = 0;
-	// Copy all non space chars to as mnemonic.
-	while (ss->buffer[off] && ss->buffer[off] != ' ' && ss->buffer[off] != '\t') {
-		if (off < mnem_buf_size - 1) {
-			// Only copy if there is space left.
-			mnem_buf[off] = ss->buffer[off];
-		}
-		off++;
-	}
-	if (!ss->buffer[off]) {
-		return;
-	}
+	size_t end = MIN((size_t)ss->index, SSTREAM_BUF_LEN - 1);
+	size_t mnem_len, off, len;
 
-	// Iterate until next non space char.
-	do {
-		off++;
-	} while (ss->buffer[off] && (ss->buffer[off] == ' ' || ss->buffer[off] == '\t'));
+	if (ss->buffer[0] == ' ' || ss->buffer[0] == '\t')
+		mnem_len = strcspn(ss->buffer, " \t");
+	else if (ss->mnem_end)
+		mnem_len = ss->mnem_end;
+	else
+		// no blank after the mnemonic
+		mnem_len = end;
 
-	if (!ss->buffer[off]) {
-		return;
-	}
+	len = MIN(mnem_len, mnem_buf_size - 1);
+	memcpy(mnem_buf, ss->buffer, len);
+	mnem_buf[len] = '\0';
 
-	// Copy all follow up characters as op_str
-	const char *ss_op_str = ss->buffer + off;
-	off = 0;
-	while (ss_op_str[off] && off < op_str_buf_size - 1) {
-		op_str_buf[off] = ss_op_str[off];
+	// Skip the blanks in between.
+	off = mnem_len;
+	while (off < end && (ss->buffer[off] == ' ' || ss->buffer[off] == '\t'))
 		off++;
-	}
+
+	len = off < end ? MIN(end - off, op_str_buf_size - 1) : 0;
+	memcpy(op_str_buf, ss->buffer + off, len);
+	op_str_buf[len] = '\0';
 }
 
 /// Empty the stream @ss to given @file (stdin/stderr).
@@ -133,10 +173,11 @@ void SStream_Flush(SStream *ss, FILE *file)
 
 /**
  * Open the output stream. Every write attempt is accepted again.
+ * A stream which closed itself after the mnemonic stays closed.
  */
 void SStream_Open(SStream *ss) {
 	assert(ss);
-	ss->is_closed = false;
+	ss->is_closed = ss->mnem_done;
 }
 
 /**
@@ -147,6 +188,17 @@ void SStream_Close(SStream *ss) {
 	ss->is_closed = true;
 }
 
+/**
+ * Only keep the mnemonic of the written text.
+ * The stream closes itself at the first ' ' or '\t' after the mnemonic
+ * and drops everything written after it. It is used if no asm text
+ * is requested, but the mnemonic is still needed (e.g. by map_set_alias_id()).
+ */
+void SStream_MnemOnly(SStream *ss) {
+	assert(ss);
+	ss->mnem_only = true;
+}
+
 /**
  * Copy the string \p s to the buffer of \p ss and terminate it with a '\\0' byte.
  */
@@ -161,6 +213,7 @@ void SStream_concat0(SStream *ss, const char *s)
 
 	SSTREAM_OVERFLOW_CHECK(ss, len);
 
+	int start = ss->index;
 	memcpy(ss->buffer + ss->index, s, len);
 	ss->index += len;
 	ss->buffer[ss->index] = '\0';
@@ -170,6 +223,7 @@ void SStream_concat0(SStream *ss, const char *s)
 		ss->index += 1;
 		ss->buffer[ss->index] = '\0';
 	}
+	SStream_track_mnem(ss, start);
 #endif
 }
 
@@ -186,6 +240,7 @@ void SStream_concat1(SStream *ss, const char c)
 
 	SSTREAM_OVERFLOW_CHECK(ss, 1);
 
+	int start = ss->index;
 	ss->buffer[ss->index] = c;
 	ss->index++;
 	ss->buffer[ss->index] = '\0';
@@ -194,6 +249,7 @@ void SStream_concat1(SStream *ss, const char c)
 		ss->buffer[ss->index] = '>';
 		ss->index++;
 	}
+	SStream_track_mnem(ss, start);
 #endif
 }
 
@@ -208,6 +264,8 @@ void SStream_concat(SStream *ss, const char *fmt, ...)
 	va_list ap;
 	int ret;
 
+	int start = ss->index;
+
 	va_start(ap, fmt);
 	ret = cs_vsnprintf(ss->buffer + ss->index, sizeof(ss->buffer) - (ss->index + 1), fmt, ap);
 	va_end(ap);
@@ -217,9 +275,65 @@ void SStream_concat(SStream *ss, const char *fmt, ...)
 		ss->buffer[ss->index] = '>';
 		ss->index += 1;
 	}
+	SStream_track_mnem(ss, start);
 #endif
 }
 
+static const char hex_digits[] = "0123456789abcdef";
+
+static const char dec_digit_pairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/**
+ * Copy \p prefix and the digits of \p val to the buffer of \p ss.
+ * The digits are hexadecimal with a "0x" in front if \p hex is set,
+ * decimal otherwise. This is the same as SStream_concat() with a
+ * "%s0x%" PRIx64 or "%s%" PRIu64 format, without parsing the format.
+ */
+static void SStream_concat_num(SStream *ss, const char *prefix, uint64_t val,
+			       bool hex)
+{
+	// "0x" and 16 hex digits, or 20 decimal digits, the prefix and '\0'
+	char buf[32];
+	char *p = buf + sizeof(buf);
+	size_t len = strlen(prefix);
+
+	*--p = '\0';
+	if (hex) {
+		do {
+			*--p = hex_digits[val & 0xf];
+			val >>= 4;
+		} while (val);
+		*--p = 'x';
+		*--p = '0';
+	} else {
+		while (val >= 100) {
+			const char *pair = dec_digit_pairs + (val % 100) * 2;
+			val /= 100;
+			*--p = pair[1];
+			*--p = pair[0];
+		}
+		if (val >= 10) {
+			*--p = dec_digit_pairs[val * 2 + 1];
+			*--p = dec_digit_pairs[val * 2];
+		} else
+			*--p = (char)('0' + val);
+	}
+	p -= len;
+	memcpy(p, prefix, len);
+
+	SStream_concat0(ss, p);
+}
+
 // print number with prefix #
 void printInt64Bang(SStream *ss, int64_t val)
 {
@@ -242,30 +356,19 @@ void printInt64(SStream *ss, int64_t val)
 {
 	assert(ss);
 	SSTREAM_RETURN_IF_CLOSED(ss);
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(ss, "0x%"PRIx64, val);
-		else
-			SStream_concat(ss, "%"PRIu64, val);
-	} else {
-		if (val < -HEX_THRESHOLD) {
-			if (val == INT64_MIN)
-				SStream_concat(ss, "-0x%"PRIx64, (uint64_t) INT64_MAX + 1);
-			else
-				SStream_concat(ss, "-0x%"PRIx64, (uint64_t)-val);
-		} else
-			SStream_concat(ss, "-%"PRIu64, -val);
-	}
+	if (val >= 0)
+		SStream_concat_num(ss, "", (uint64_t)val, val > HEX_THRESHOLD);
+	else
+		// -(uint64_t)val is also right for INT64_MIN
+		SStream_concat_num(ss, "-", -(uint64_t)val,
+				   val < -HEX_THRESHOLD);
 }
 
 void printUInt64(SStream *ss, uint64_t val)
 {
 	assert(ss);
 	SSTREAM_RETURN_IF_CLOSED(ss);
-	if (val > HEX_THRESHOLD)
-		SStream_concat(ss, "0x%"PRIx64, val);
-	else
-		SStream_concat(ss, "%"PRIu64, val);
+	SStream_concat_num(ss, "", val, val > HEX_THRESHOLD);
 }
 
 // print number in decimal mode
@@ -274,13 +377,9 @@ void printInt32BangDec(SStream *ss, int32_t val)
 	assert(ss);
 	SSTREAM_RETURN_IF_CLOSED(ss);
 	if (val >= 0)
-		SStream_concat(ss, "#%" PRIu32, val);
-	else {
-		if (val == INT32_MIN)
-			SStream_concat(ss, "#-%" PRIu32, val);
-		else
-			SStream_concat(ss, "#-%" PRIu32, (uint32_t)-val);
-	}
+		SStream_concat_num(ss, "#", (uint32_t)val, false);
+	else
+		SStream_concat_num(ss, "#-", -(uint32_t)val, false);
 }
 
 void printInt32Bang(SStream *ss, int32_t val)
@@ -293,63 +392,17 @@ void printInt32Bang(SStream *ss, int32_t val)
 
 void printInt8(SStream *ss, int8_t val)
 {
-	assert(ss);
-	SSTREAM_RETURN_IF_CLOSED(ss);
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(ss, "0x%" PRIx8, val);
-		else
-			SStream_concat(ss, "%" PRId8, val);
-	} else {
-		if (val < -HEX_THRESHOLD) {
-			if (val == INT8_MIN)
-				SStream_concat(ss, "-0x%" PRIx8, (uint8_t) INT8_MAX + 1);
-			else
-				SStream_concat(ss, "-0x%" PRIx8, (int8_t)-val);
-		} else
-			SStream_concat(ss, "-%" PRIu8, -val);
-	}
+	printInt64(ss, val);
 }
 
 void printInt16(SStream *ss, int16_t val)
 {
-	assert(ss);
-	SSTREAM_RETURN_IF_CLOSED(ss);
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(ss, "0x%" PRIx16, val);
-		else
-			SStream_concat(ss, "%" PRId16, val);
-	} else {
-		if (val < -HEX_THRESHOLD) {
-			if (val == INT16_MIN)
-				SStream_concat(ss, "-0x%" PRIx16, (uint16_t) INT16_MAX + 1);
-			else
-				SStream_concat(ss, "-0x%" PRIx16, (int16_t)-val);
-		} else
-			SStream_concat(ss, "-%" PRIu16, -val);
-	}
+	printInt64(ss, val);
 }
 
 void printInt32(SStream *ss, int32_t val)
 {
-	assert(ss);
-	SSTREAM_RETURN_IF_CLOSED(ss);
-	if (val >= 0) {
-		if (val > HEX_THRESHOLD)
-			SStream_concat(ss, "0x%" PRIx32, val);
-		else
-			SStream_concat(ss, "%" PRId32, val);
-	} else {
-		if (val < -HEX_THRESHOLD) {
-			if (val == INT32_MIN)
-				SStream_concat(ss, "-0x%" PRIx32, (uint32_t) INT32_MAX + 1);
-			else
-				SStream_concat(ss, "-0x%" PRIx32, (int32_t)-val);
-		} else {
-			SStream_concat(ss, "-%" PRIu32, (uint32_t)-val);
-		}
-	}
+	printInt64(ss, val);
 }
 
 void printUInt32Bang(SStream *ss, uint32_t val)
@@ -362,12 +415,7 @@ void printUInt32Bang(SStream *ss, uint32_t val)
 
 void printUInt32(SStream *ss, uint32_t val)
 {
-	assert(ss);
-	SSTREAM_RETURN_IF_CLOSED(ss);
-	if (val > HEX_THRESHOLD)
-		SStream_concat(ss, "0x%x", val);
-	else
-		SStream_concat(ss, "%u", val);
+	printUInt64(ss, val);
 }
 
 void printFloat(SStream *ss, float val)
@@ -388,7 +436,7 @@ void printExpr(SStream *ss, uint64_t val)
 {
 	assert(ss);
 	SSTREAM_RETURN_IF_CLOSED(ss);
-	SStream_concat(ss, "%"PRIu64, val);
+	SStream_concat_num(ss, "", val, false);
 }
 
 SStream *markup_OS(SStream *OS, SStreamMarkup style) {
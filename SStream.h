@@ -22,6 +22,10 @@ typedef struct SStream {
 	bool is_closed;
 	bool markup_stream; ///< If true, markups to the stream are allowed.
 	bool prefixed_by_markup; ///< Set after the stream wrote a markup for an operand.
+	bool mnem_only; ///< If true, the stream closes itself after the mnemonic was written.
+	bool mnem_started; ///< Set after the first non-blank character was written.
+	bool mnem_done; ///< Set after the stream closed itself. It stays closed then.
+	int mnem_end; ///< Index of the first ' ' or '\t' after the mnemonic. 0 until it was written.
 } SStream;
 
 #define SSTREAM_OVERFLOW_CHECK(OS, len) \
@@ -56,6 +60,8 @@ void SStream_Open(SStream *ss);
 
 void SStream_Close(SStream *ss);
 
+void SStream_MnemOnly(SStream *ss);
+
 void SStream_concat(SStream *ss, const char *fmt, ...);
 
 void SStream_concat0(SStream *ss, const char *s);
@@ -177,7 +177,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 				SStream_concat0(O, ", ");
 				printRegName(O, getWRegFromXReg(
 							MCOperand_getReg(Op1)));
-				if (detail_is_set(MI) && useAliasDetails) {
+				if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+				    useAliasDetails) {
 					AArch64_set_detail_op_reg(
 						MI, 0, MCOperand_getReg(Op0));
 					AArch64_set_detail_op_reg(
@@ -261,7 +262,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 				SStream_concat(O, "%s%s#%d", ", ",
 					       markup("<imm:"), shift);
 				SStream_concat0(O, markup(">"));
-				if (detail_is_set(MI) && useAliasDetails) {
+				if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+				    useAliasDetails) {
 					AArch64_set_detail_op_reg(
 						MI, 0, MCOperand_getReg(Op0));
 					AArch64_set_detail_op_reg(
@@ -311,7 +313,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 				       markup("<imm:"));
 			printInt64Bang(O, MCOperand_getImm(Op3) + 1);
 			SStream_concat0(O, markup(">"));
-			if (detail_is_set(MI) && useAliasDetails) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+			    useAliasDetails) {
 				AArch64_set_detail_op_reg(
 					MI, 0, MCOperand_getReg(Op0));
 				AArch64_set_detail_op_reg(
@@ -345,7 +348,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 		printInt64Bang(O, MCOperand_getImm(Op3) -
 					  MCOperand_getImm(Op2) + 1);
 		SStream_concat0(O, markup(">"));
-		if (detail_is_set(MI) && useAliasDetails) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+		    useAliasDetails) {
 			AArch64_set_detail_op_reg(MI, 0, MCOperand_getReg(Op0));
 			AArch64_set_detail_op_reg(MI, 1, MCOperand_getReg(Op1));
 			AArch64_set_detail_op_imm(MI, 2, AARCH64_OP_IMM,
@@ -374,10 +378,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 		if ((MCOperand_getReg(Op2) == AArch64_WZR ||
 		     MCOperand_getReg(Op2) == AArch64_XZR) &&
 		    (ImmR == 0 || ImmS < ImmR) &&
-		    (AArch64_getFeatureBits(MI->csh->mode,
-					    AArch64_FeatureAll) ||
-		     AArch64_getFeatureBits(MI->csh->mode,
-					    AArch64_HasV8_2aOps))) {
+		    (CS_hasFeature(MI->csh, AArch64_FeatureAll) ||
+		     CS_hasFeature(MI->csh, AArch64_HasV8_2aOps))) {
 			// BFC takes precedence over its entire range, sligtly differently
 			// to BFI.
 			int BitWidth = Opcode == AArch64_BFMXri ? 64 : 32;
@@ -391,7 +393,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 			SStream_concat(O, "%s%s%s#%d", markup(">"), ", ",
 				       markup("<imm:"), Width);
 			SStream_concat0(O, markup(">"));
-			if (detail_is_set(MI) && useAliasDetails) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+			    useAliasDetails) {
 				AArch64_set_detail_op_reg(
 					MI, 0, MCOperand_getReg(Op0));
 				AArch64_set_detail_op_imm(MI, 3, AARCH64_OP_IMM,
@@ -419,7 +422,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 			SStream_concat(O, "%s%s%s#%d", markup(">"), ", ",
 				       markup("<imm:"), Width);
 			SStream_concat0(O, markup(">"));
-			if (detail_is_set(MI) && useAliasDetails) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+			    useAliasDetails) {
 				AArch64_set_detail_op_reg(
 					MI, 0, MCOperand_getReg(Op0));
 				AArch64_set_detail_op_reg(
@@ -446,7 +450,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 		SStream_concat(O, "%s%s%s#%d", markup(">"), ", ",
 			       markup("<imm:"), Width);
 		SStream_concat0(O, markup(">"));
-		if (detail_is_set(MI) && useAliasDetails) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+		    useAliasDetails) {
 			AArch64_set_detail_op_reg(MI, 0, MCOperand_getReg(Op0));
 			AArch64_set_detail_op_reg(MI, 2, MCOperand_getReg(Op2));
 			AArch64_set_detail_op_imm(MI, 3, AARCH64_OP_IMM, LSB);
@@ -463,7 +468,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 	     Opcode == AArch64_MOVNXi || Opcode == AArch64_MOVNWi) &&
 	    MCOperand_isExpr(MCInst_getOperand(MI, (1)))) {
 		printUInt64Bang(O, MCInst_getOpVal(MI, 1));
-		if (detail_is_set(MI) && useAliasDetails) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+		    useAliasDetails) {
 			AArch64_set_detail_op_imm(MI, 1, AARCH64_OP_IMM, MCInst_getOpVal(MI, 1));
 		}
 	}
@@ -471,7 +477,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 	if ((Opcode == AArch64_MOVKXi || Opcode == AArch64_MOVKWi) &&
 	    MCOperand_isExpr(MCInst_getOperand(MI, (2)))) {
 		printUInt64Bang(O, MCInst_getOpVal(MI, 2));
-		if (detail_is_set(MI) && useAliasDetails) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+		    useAliasDetails) {
 			AArch64_set_detail_op_imm(MI, 2, AARCH64_OP_IMM, MCInst_getOpVal(MI, 2));
 		}
 	}
@@ -500,7 +507,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 			SStream_concat(O, "%s%s", ", ", markup("<imm:"));
 			printInt64Bang(O, SignExtend64(Value, RegWidth));
 			SStream_concat0(O, markup(">"));
-			if (detail_is_set(MI) && useAliasDetails) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+			    useAliasDetails) {
 				AArch64_set_detail_op_reg(
 					MI, 0, MCInst_getOpVal(MI, 0));
 				AArch64_set_detail_op_imm(
@@ -532,7 +540,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 			SStream_concat(O, "%s%s", ", ", markup("<imm:"));
 			printInt64Bang(O, SignExtend64(Value, RegWidth));
 			SStream_concat0(O, markup(">"));
-			if (detail_is_set(MI) && useAliasDetails) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+			    useAliasDetails) {
 				AArch64_set_detail_op_reg(
 					MI, 0, MCInst_getOpVal(MI, 0));
 				AArch64_set_detail_op_imm(
@@ -560,7 +569,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 			SStream_concat(O, "%s%s", ", ", markup("<imm:"));
 			printInt64Bang(O, SignExtend64(Value, RegWidth));
 			SStream_concat0(O, markup(">"));
-			if (detail_is_set(MI) && useAliasDetails) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+			    useAliasDetails) {
 				AArch64_set_detail_op_reg(
 					MI, 0, MCInst_getOpVal(MI, 0));
 				AArch64_set_detail_op_imm(
@@ -578,7 +588,8 @@ void printInst(MCInst *MI, uint64_t Address, const char *Annot, SStream *O)
 		SStream_concat1(O, ' ');
 		SStream_concat(O, "%s", " SPACE ");
 		printInt64(O, MCOperand_getImm(MCInst_getOperand(MI, (1))));
-		if (detail_is_set(MI) && useAliasDetails) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+		    useAliasDetails) {
 			AArch64_set_detail_op_imm(MI, 1, AARCH64_OP_IMM,
 						  MCInst_getOpVal(MI, 1));
 		}
@@ -695,9 +706,8 @@ Search_PRCTX:
 			unsigned int Requires =
 				Op2Val == 6 ? AArch64_FeatureSPECRES2 :
 					      AArch64_FeaturePredRes;
-			if (!(AArch64_getFeatureBits(MI->csh->mode,
-						     AArch64_FeatureAll) ||
-			      AArch64_getFeatureBits(MI->csh->mode, Requires)))
+			if (!(CS_hasFeature(MI->csh, AArch64_FeatureAll) ||
+			      CS_hasFeature(MI->csh, Requires)))
 				return false;
 
 			NeedsReg = true;
@@ -726,7 +736,7 @@ Search_IC: {
 	if (!IC ||
 	    !AArch64_testFeatureList(MI->csh->mode, IC->FeaturesRequired))
 		return false;
-	if (detail_is_set(MI)) {
+	if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		aarch64_sysop sysop = { 0 };
 		sysop.reg = IC->SysReg;
 		sysop.sub_type = AARCH64_OP_IC;
@@ -753,7 +763,7 @@ Search_IC: {
 			if (!DC || !AArch64_testFeatureList(
 					   MI->csh->mode, DC->FeaturesRequired))
 				return false;
-			if (detail_is_set(MI)) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 				aarch64_sysop sysop = { 0 };
 				sysop.alias = DC->SysAlias;
 				sysop.sub_type = AARCH64_OP_DC;
@@ -776,7 +786,7 @@ Search_IC: {
 					   MI->csh->mode, AT->FeaturesRequired))
 				return false;
 
-			if (detail_is_set(MI)) {
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 				aarch64_sysop sysop = { 0 };
 				sysop.alias = AT->SysAlias;
 				sysop.sub_type = AARCH64_OP_AT;
@@ -798,7 +808,7 @@ Search_IC: {
 						      TLBI->FeaturesRequired))
 			return false;
 
-		if (detail_is_set(MI)) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 			aarch64_sysop sysop = { 0 };
 			sysop.reg = TLBI->SysReg;
 			sysop.sub_type = AARCH64_OP_TLBI;
@@ -853,10 +863,8 @@ bool printSyspAlias(MCInst *MI, SStream *O)
 		// TLBIP aliases
 
 		if (CnVal == 9) {
-			if (!AArch64_getFeatureBits(MI->csh->mode,
-						    AArch64_FeatureAll) ||
-			    !AArch64_getFeatureBits(MI->csh->mode,
-						    AArch64_FeatureXS))
+			if (!CS_hasFeature(MI->csh, AArch64_FeatureAll) ||
+			    !CS_hasFeature(MI->csh, AArch64_FeatureXS))
 				return false;
 			Encoding &= ~(1 << 7);
 		}
@@ -867,7 +875,7 @@ bool printSyspAlias(MCInst *MI, SStream *O)
 						      TLBI->FeaturesRequired))
 			return false;
 
-		if (detail_is_set(MI)) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 			aarch64_sysop sysop = { 0 };
 			sysop.reg = TLBI->SysReg;
 			sysop.sub_type = AARCH64_OP_TLBI;
@@ -95,20 +95,21 @@ static AArch64Layout_VectorLayout sme_reg_to_vas(aarch64_reg reg)
 	}
 }
 
-void AArch64_init_mri(MCRegisterInfo *MRI)
+const MCRegisterInfo *AArch64_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(
-		MRI, AArch64RegDesc, AARCH64_REG_ENDING, 0, 0,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(AArch64RegDesc, AARCH64_REG_ENDING, 0, 0,
 		AArch64MCRegisterClasses, ARR_SIZE(AArch64MCRegisterClasses), 0,
 		0, AArch64RegDiffLists, 0, AArch64SubRegIdxLists,
 		ARR_SIZE(AArch64SubRegIdxLists), 0);
+
+	return &mri;
 }
 
 
 /// Sets up a new SME matrix operand at the currently active detail operand.
 static void setup_sme_operand(MCInst *MI)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	AArch64_get_detail_op(MI, 0)->type = AARCH64_OP_SME;
@@ -122,7 +123,7 @@ static void setup_sme_operand(MCInst *MI)
 
 static void setup_pred_operand(MCInst *MI)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	AArch64_get_detail_op(MI, 0)->type = AARCH64_OP_PRED;
@@ -172,7 +173,7 @@ static const char *get_custom_reg_alias(unsigned reg)
 /// specifier.
 void AArch64_add_vas(MCInst *MI, const SStream *OS)
 {
-	if (!detail_is_set(MI)) {
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		return;
 	}
 
@@ -330,15 +331,17 @@ static bool AArch64_check_post_index_am(const MCInst *MI, const SStream *OS)
 static void AArch64_check_updates_flags(MCInst *MI)
 {
 #ifndef CAPSTONE_DIET
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	cs_detail *detail = get_detail(MI);
-	// Implicitly written registers
-	for (int i = 0; i < detail->regs_write_count; ++i) {
-		if (detail->regs_write[i] == 0)
+	// Implicitly written registers. The mapping table is checked, they
+	// might not be filled (CS_OPT_DETAIL_IMPLICIT_REGS).
+	const uint16_t *regs_mod = aarch64_insns[MCInst_getOpcode(MI)].regs_mod;
+	for (int i = 0; i < MAX_IMPL_W_REGS; ++i) {
+		if (regs_mod[i] == 0)
 			break;
 		for (int j = 0; j < ARR_SIZE(aarch64_flag_regs); ++j) {
-			if (detail->regs_write[i] == aarch64_flag_regs[j]) {
+			if (regs_mod[i] == aarch64_flag_regs[j]) {
 				detail->aarch64.update_flags = true;
 				return;
 			}
@@ -561,7 +564,7 @@ static void add_non_alias_details(MCInst *MI)
 
 static void AArch64_add_not_defined_ops(MCInst *MI, const SStream *OS)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	if (!MI->flat_insn->is_alias || !MI->flat_insn->usesAliasDetails) {
@@ -826,7 +829,7 @@ static void AArch64_add_cs_groups(MCInst *MI)
 }
 
 static void AArch64_correct_mem_access(MCInst *MI) {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	cs_ac_type access = aarch64_insns[MI->Opcode].suppl_info.aarch64.mem_acc;
 	if (access == CS_AC_INVALID) {
@@ -844,10 +847,10 @@ void AArch64_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info)
 {
 	MCRegisterInfo *MRI = (MCRegisterInfo *)info;
 	MI->MRI = MRI;
-	MI->fillDetailOps = detail_is_set(MI);
+	MI->fillDetailOps = detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS);
 	MI->flat_insn->usesAliasDetails = map_use_alias_details(MI);
 	AArch64_LLVM_printInstruction(MI, O, info);
-	if (detail_is_set(MI)) {
+	if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		if (AArch64_get_detail(MI)->is_doing_sme) {
 			// Last operand still needs to be closed.
 			AArch64_get_detail(MI)->is_doing_sme = false;
@@ -869,7 +872,7 @@ void AArch64_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info)
 }
 
 // given internal insn id, return public instruction info
-void AArch64_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void AArch64_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// Done after disassembly
 	return;
@@ -1250,7 +1253,7 @@ static aarch64_shifter llvm_to_cs_shift(AArch64_AM_ShiftExtendType ShiftExtType)
 /// E.g. the base register and the immediate disponent.
 void AArch64_set_mem_access(MCInst *MI, bool status)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	set_doing_mem(MI, status);
 	if (status) {
@@ -1287,7 +1290,7 @@ void AArch64_set_mem_access(MCInst *MI, bool status)
 static void add_cs_detail_general(MCInst *MI, aarch64_op_group op_group,
 				  unsigned OpNum)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	// Fill cs_detail
@@ -1727,7 +1730,7 @@ static void add_cs_detail_general(MCInst *MI, aarch64_op_group op_group,
 static void add_cs_detail_template_1(MCInst *MI, aarch64_op_group op_group,
 				     unsigned OpNum, uint64_t temp_arg_0)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	switch (op_group) {
 	default:
@@ -2056,7 +2059,7 @@ static void add_cs_detail_template_2(MCInst *MI, aarch64_op_group op_group,
 				     unsigned OpNum, uint64_t temp_arg_0,
 				     uint64_t temp_arg_1)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	switch (op_group) {
 	default:
@@ -2240,7 +2243,7 @@ static void add_cs_detail_template_4(MCInst *MI, aarch64_op_group op_group,
 				     uint64_t temp_arg_1, uint64_t temp_arg_2,
 				     uint64_t temp_arg_3)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	switch (op_group) {
 	default:
@@ -2305,7 +2308,8 @@ static void add_cs_detail_template_4(MCInst *MI, aarch64_op_group op_group,
 void AArch64_add_cs_detail(MCInst *MI, int /* aarch64_op_group */ op_group,
 			   va_list args)
 {
-	if (!detail_is_set(MI) || !map_fill_detail_ops(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) ||
+	    !map_fill_detail_ops(MI))
 		return;
 
 	unsigned op_num = va_arg(args, unsigned);
@@ -2516,7 +2520,7 @@ void AArch64_add_cs_detail(MCInst *MI, int /* aarch64_op_group */ op_group,
 /// one.
 void AArch64_set_detail_op_reg(MCInst *MI, unsigned OpNum, aarch64_reg Reg)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2576,7 +2580,7 @@ static bool prev_is_membase_wb(MCInst *MI) {
 void AArch64_set_detail_op_imm(MCInst *MI, unsigned OpNum,
 			       aarch64_op_type ImmType, int64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2611,7 +2615,7 @@ void AArch64_set_detail_op_imm(MCInst *MI, unsigned OpNum,
 void AArch64_set_detail_op_imm_range(MCInst *MI, unsigned OpNum,
 				     uint32_t FirstImm, uint32_t Offset)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2644,7 +2648,7 @@ void AArch64_set_detail_op_imm_range(MCInst *MI, unsigned OpNum,
 /// one. This is done by set_mem_access().
 void AArch64_set_detail_op_mem(MCInst *MI, unsigned OpNum, uint64_t Val)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2727,7 +2731,7 @@ void AArch64_set_detail_shift_ext(MCInst *MI, unsigned OpNum, bool SignExtend,
 /// Increments the op_counter by one.
 void AArch64_set_detail_op_float(MCInst *MI, unsigned OpNum, float Val)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2742,7 +2746,7 @@ void AArch64_set_detail_op_float(MCInst *MI, unsigned OpNum, float Val)
 void AArch64_set_detail_op_sys(MCInst *MI, unsigned OpNum, aarch64_sysop sys_op,
 			       aarch64_op_type type)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2755,7 +2759,7 @@ void AArch64_set_detail_op_sys(MCInst *MI, unsigned OpNum, aarch64_sysop sys_op,
 }
 
 void AArch64_set_detail_op_pred(MCInst *MI, unsigned OpNum) {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2783,7 +2787,7 @@ void AArch64_set_detail_op_sme(MCInst *MI, unsigned OpNum,
 			       aarch64_sme_op_part part,
 			       AArch64Layout_VectorLayout vas, ...)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2859,7 +2863,7 @@ void AArch64_set_detail_op_sme(MCInst *MI, unsigned OpNum,
 
 static void insert_op(MCInst *MI, unsigned index, cs_aarch64_op op)
 {
-	if (!detail_is_set(MI)) {
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		return;
 	}
 
@@ -2884,7 +2888,7 @@ static void insert_op(MCInst *MI, unsigned index, cs_aarch64_op op)
 void AArch64_insert_detail_op_float_at(MCInst *MI, unsigned index, double val,
 				       cs_ac_type access)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	AArch64_check_safe_inc(MI);
@@ -2904,7 +2908,7 @@ void AArch64_insert_detail_op_float_at(MCInst *MI, unsigned index, double val,
 void AArch64_insert_detail_op_reg_at(MCInst *MI, unsigned index,
 				     aarch64_reg Reg, cs_ac_type access)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	AArch64_check_safe_inc(MI);
@@ -2923,7 +2927,7 @@ void AArch64_insert_detail_op_reg_at(MCInst *MI, unsigned index,
 /// Already present operands are moved.
 void AArch64_insert_detail_op_imm_at(MCInst *MI, unsigned index, int64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2939,7 +2943,7 @@ void AArch64_insert_detail_op_imm_at(MCInst *MI, unsigned index, int64_t Imm)
 void AArch64_insert_detail_op_sys(MCInst *MI, unsigned index, aarch64_sysop sys_op,
 			       aarch64_op_type type)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -2956,7 +2960,7 @@ void AArch64_insert_detail_op_sys(MCInst *MI, unsigned index, aarch64_sysop sys_
 
 void AArch64_insert_detail_op_sme(MCInst *MI, unsigned index, aarch64_op_sme sme_op)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	AArch64_check_safe_inc(MI);
 
@@ -26,7 +26,7 @@ typedef enum {
 const char *AArch64_reg_name(csh handle, unsigned int reg);
 
 // given internal insn id, return public instruction info
-void AArch64_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void AArch64_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *AArch64_insn_name(csh handle, unsigned int id);
 
@@ -50,7 +50,7 @@ static inline void add_cs_detail(MCInst *MI,
 	va_end(args);
 }
 
-void AArch64_init_mri(MCRegisterInfo *MRI);
+const MCRegisterInfo *AArch64_get_mri(void);
 
 void AArch64_init_cs_detail(MCInst *MI);
 
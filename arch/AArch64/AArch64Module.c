@@ -8,17 +8,19 @@
 #include "AArch64InstPrinter.h"
 #include "AArch64Mapping.h"
 #include "AArch64Module.h"
+#include "AArch64DisassemblerExtension.h"
+#include "AArch64BaseInfo.h"
 
 cs_err AArch64_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
+	const MCRegisterInfo *mri = AArch64_get_mri();
 
-	AArch64_init_mri(mri);
 	ud->printer = AArch64_printer;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = AArch64_getInstruction;
+	ud->feature_bits_of = AArch64_getFeatureBits;
+	ud->num_features = AArch64_NumSubtargetFeatures;
 	ud->reg_name = AArch64_reg_name;
 	ud->insn_id = AArch64_get_insn_id;
 	ud->insn_name = AArch64_insn_name;
@@ -627,6 +627,16 @@ static DecodeStatus DecodeT2AddSubSPImm(MCInst *Inst, unsigned Insn,
 
 #include "ARMGenDisassemblerTables.inc"
 
+// Decodes with a decoder table, unless the key of the table rules out Insn.
+#define decodeTable_2(Table, MI, Insn, Address) \
+	(decoderTableMayDecode(Table##Keys, Insn) ? \
+		 decodeInstruction_2(Table, MI, Insn, Address) : \
+		 MCDisassembler_Fail)
+#define decodeTable_4(Table, MI, Insn, Address) \
+	(decoderTableMayDecode(Table##Keys, Insn) ? \
+		 decodeInstruction_4(Table, MI, Insn, Address) : \
+		 MCDisassembler_Fail)
+
 // Post-decoding checks
 static DecodeStatus checkDecodedInstruction(MCInst *MI, uint32_t Insn,
 					    DecodeStatus Result)
@@ -712,7 +722,7 @@ DecodeStatus getARMInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 
 	// Calling the auto-generated decoder function.
 	DecodeStatus Result =
-		decodeInstruction_4(DecoderTableARM32, MI, Insn, Address);
+		decodeTable_4(DecoderTableARM32, MI, Insn, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 4;
 		return checkDecodedInstruction(MI, Insn, Result);
@@ -720,22 +730,26 @@ DecodeStatus getARMInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 
 	typedef struct DecodeTable {
 		const uint8_t *P;
+		const uint8_t *Keys;
 		bool DecodePred;
 	} DecodeTable;
 
 	const DecodeTable Tables[] = {
-		{ DecoderTableVFP32, false },
-		{ DecoderTableVFPV832, false },
-		{ DecoderTableNEONData32, true },
-		{ DecoderTableNEONLoadStore32, true },
-		{ DecoderTableNEONDup32, true },
-		{ DecoderTablev8NEON32, false },
-		{ DecoderTablev8Crypto32, false },
+		{ DecoderTableVFP32, DecoderTableVFP32Keys, false },
+		{ DecoderTableVFPV832, DecoderTableVFPV832Keys, false },
+		{ DecoderTableNEONData32, DecoderTableNEONData32Keys, true },
+		{ DecoderTableNEONLoadStore32, DecoderTableNEONLoadStore32Keys,
+		  true },
+		{ DecoderTableNEONDup32, DecoderTableNEONDup32Keys, true },
+		{ DecoderTablev8NEON32, DecoderTablev8NEON32Keys, false },
+		{ DecoderTablev8Crypto32, DecoderTablev8Crypto32Keys, false },
 	};
 
 	for (int i = 0; i < (sizeof(Tables) / sizeof(Tables[0])); ++i) {
 		MCInst_clear(MI);
 		DecodeTable Table = Tables[i];
+		if (!decoderTableMayDecode(Table.Keys, Insn))
+			continue;
 		Result = decodeInstruction_4(Table.P, MI, Insn, Address);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
@@ -748,7 +762,7 @@ DecodeStatus getARMInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		}
 	}
 
-	Result = decodeInstruction_4(DecoderTableCoProc32, MI, Insn, Address);
+	Result = decodeTable_4(DecoderTableCoProc32, MI, Insn, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 4;
 		return checkDecodedInstruction(MI, Insn, Result);
@@ -871,7 +885,7 @@ DecodeStatus AddThumbPredicate(MCInst *MI)
 		break;
 	case ARM_t2HINT:
 		if (MCOperand_getImm(MCInst_getOperand(MI, (0))) == 0x10 &&
-		    (ARM_getFeatureBits(MI->csh->mode, ARM_FeatureRAS)) != 0)
+		    (CS_hasFeature(MI->csh, ARM_FeatureRAS)) != 0)
 			S = MCDisassembler_SoftFail;
 		break;
 	case ARM_tB:
@@ -1017,15 +1031,14 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 
 	uint16_t Insn16 = endianSensitiveOpcode16(MI, Bytes);
 	DecodeStatus Result =
-		decodeInstruction_2(DecoderTableThumb16, MI, Insn16, Address);
+		decodeTable_2(DecoderTableThumb16, MI, Insn16, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 2;
 		Check(&Result, AddThumbPredicate(MI));
 		return Result;
 	}
 
-	Result = decodeInstruction_2(DecoderTableThumbSBit16, MI, Insn16,
-				     Address);
+	Result = decodeTable_2(DecoderTableThumbSBit16, MI, Insn16, Address);
 	if (Result) {
 		*Size = 2;
 		bool InITBlock = ITBlock_instrInITBlock(&(MI->csh->ITBlock));
@@ -1034,7 +1047,7 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		return Result;
 	}
 
-	Result = decodeInstruction_2(DecoderTableThumb216, MI, Insn16, Address);
+	Result = decodeTable_2(DecoderTableThumb216, MI, Insn16, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 2;
 
@@ -1073,7 +1086,7 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 	uint32_t Insn32 = (uint32_t)Insn16 << 16 |
 			  endianSensitiveOpcode16(MI, Bytes + 2);
 
-	Result = decodeInstruction_4(DecoderTableMVE32, MI, Insn32, Address);
+	Result = decodeTable_4(DecoderTableMVE32, MI, Insn32, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 4;
 
@@ -1094,7 +1107,7 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		return Result;
 	}
 
-	Result = decodeInstruction_4(DecoderTableThumb32, MI, Insn32, Address);
+	Result = decodeTable_4(DecoderTableThumb32, MI, Insn32, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 4;
 		bool InITBlock = ITBlock_instrInITBlock(&(MI->csh->ITBlock));
@@ -1103,7 +1116,7 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		return Result;
 	}
 
-	Result = decodeInstruction_4(DecoderTableThumb232, MI, Insn32, Address);
+	Result = decodeTable_4(DecoderTableThumb232, MI, Insn32, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 4;
 		Check(&Result, AddThumbPredicate(MI));
@@ -1111,8 +1124,7 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 	}
 
 	if (fieldFromInstruction_4(Insn32, 28, 4) == 0xE) {
-		Result = decodeInstruction_4(DecoderTableVFP32, MI, Insn32,
-					     Address);
+		Result = decodeTable_4(DecoderTableVFP32, MI, Insn32, Address);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
 			UpdateThumbVFPPredicate(Result, MI);
@@ -1120,15 +1132,15 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		}
 	}
 
-	Result = decodeInstruction_4(DecoderTableVFPV832, MI, Insn32, Address);
+	Result = decodeTable_4(DecoderTableVFPV832, MI, Insn32, Address);
 	if (Result != MCDisassembler_Fail) {
 		*Size = 4;
 		return Result;
 	}
 
 	if (fieldFromInstruction_4(Insn32, 28, 4) == 0xE) {
-		Result = decodeInstruction_4(DecoderTableNEONDup32, MI, Insn32,
-					     Address);
+		Result = decodeTable_4(DecoderTableNEONDup32, MI, Insn32,
+				       Address);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
 			Check(&Result, AddThumbPredicate(MI));
@@ -1140,8 +1152,8 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		uint32_t NEONLdStInsn = Insn32;
 		NEONLdStInsn &= 0xF0FFFFFF;
 		NEONLdStInsn |= 0x04000000;
-		Result = decodeInstruction_4(DecoderTableNEONLoadStore32, MI,
-					     NEONLdStInsn, Address);
+		Result = decodeTable_4(DecoderTableNEONLoadStore32, MI,
+				       NEONLdStInsn, Address);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
 			Check(&Result, AddThumbPredicate(MI));
@@ -1155,8 +1167,8 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		NEONDataInsn |= (NEONDataInsn & 0x10000000) >>
 				4;	    // Move bit 28 to bit 24
 		NEONDataInsn |= 0x12000000; // Set bits 28 and 25
-		Result = decodeInstruction_4(DecoderTableNEONData32, MI,
-					     NEONDataInsn, Address);
+		Result = decodeTable_4(DecoderTableNEONData32, MI, NEONDataInsn,
+				       Address);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
 			Check(&Result, AddThumbPredicate(MI));
@@ -1168,8 +1180,8 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 		NEONCryptoInsn |= (NEONCryptoInsn & 0x10000000) >>
 				  4;	      // Move bit 28 to bit 24
 		NEONCryptoInsn |= 0x12000000; // Set bits 28 and 25
-		Result = decodeInstruction_4(DecoderTablev8Crypto32, MI,
-					     NEONCryptoInsn, Address);
+		Result = decodeTable_4(DecoderTablev8Crypto32, MI,
+				       NEONCryptoInsn, Address);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
 			return Result;
@@ -1177,8 +1189,8 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 
 		uint32_t NEONv8Insn = Insn32;
 		NEONv8Insn &= 0xF3FFFFFF; // Clear bits 27-26
-		Result = decodeInstruction_4(DecoderTablev8NEON32, MI,
-					     NEONv8Insn, Address);
+		Result = decodeTable_4(DecoderTablev8NEON32, MI, NEONv8Insn,
+				       Address);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
 			return Result;
@@ -1186,10 +1198,14 @@ DecodeStatus getThumbInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 	}
 
 	uint32_t Coproc = fieldFromInstruction_4(Insn32, 8, 4);
-	const uint8_t *DecoderTable = ARM_isCDECoproc(Coproc, MI) ?
-					      DecoderTableThumb2CDE32 :
+	bool IsCDE = ARM_isCDECoproc(Coproc, MI);
+	const uint8_t *DecoderTable = IsCDE ? DecoderTableThumb2CDE32 :
 					      DecoderTableThumb2CoProc32;
-	Result = decodeInstruction_4(DecoderTable, MI, Insn32, Address);
+	const uint8_t *DecoderTableKeys = IsCDE ? DecoderTableThumb2CDE32Keys :
+						  DecoderTableThumb2CoProc32Keys;
+	Result = decoderTableMayDecode(DecoderTableKeys, Insn32) ?
+			 decodeInstruction_4(DecoderTable, MI, Insn32, Address) :
+			 MCDisassembler_Fail;
 	if (Result != MCDisassembler_Fail) {
 		*Size = 4;
 		Check(&Result, AddThumbPredicate(MI));
@@ -1409,7 +1425,7 @@ static DecodeStatus DecoderGPRRegisterClass(MCInst *Inst, unsigned RegNo,
 	DecodeStatus S = MCDisassembler_Success;
 
 	if ((RegNo == 13 &&
-	     !ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8Ops)) ||
+	     !CS_hasFeature(Inst->csh, ARM_HasV8Ops)) ||
 	    RegNo == 15)
 		S = MCDisassembler_SoftFail;
 
@@ -1454,7 +1470,7 @@ static DecodeStatus DecodeDPRRegisterClass(MCInst *Inst, unsigned RegNo,
 					   uint64_t Address,
 					   const void *Decoder)
 {
-	bool hasD32 = ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureD32);
+	bool hasD32 = CS_hasFeature(Inst->csh, ARM_FeatureD32);
 
 	if (RegNo > 31 || (!hasD32 && RegNo > 15))
 		return MCDisassembler_Fail;
@@ -1876,8 +1892,7 @@ static DecodeStatus DecodeCopMemInstruction(MCInst *Inst, unsigned Insn,
 	case ARM_STC2_POST:
 	case ARM_STC2L_POST:
 		if (coproc == 0xA || coproc == 0xB ||
-		    (ARM_getFeatureBits(Inst->csh->mode,
-					ARM_HasV8_1MMainlineOps) &&
+		    (CS_hasFeature(Inst->csh, ARM_HasV8_1MMainlineOps) &&
 		     (coproc == 0x8 || coproc == 0x9 || coproc == 0xA ||
 		      coproc == 0xB || coproc == 0xE || coproc == 0xF)))
 			return MCDisassembler_Fail;
@@ -1886,7 +1901,7 @@ static DecodeStatus DecodeCopMemInstruction(MCInst *Inst, unsigned Insn,
 		break;
 	}
 
-	if (ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8Ops) && (coproc != 14))
+	if (CS_hasFeature(Inst->csh, ARM_HasV8Ops) && (coproc != 14))
 		return MCDisassembler_Fail;
 
 	if (IsPreIndexed)
@@ -2517,7 +2532,7 @@ static DecodeStatus DecodeHINTInstruction(MCInst *Inst, unsigned Insn,
 	// ESB is unpredictable if pred != AL. Without the RAS extension, it is a
 	// NOP, so all predicates should be allowed.
 	if (imm8 == 0x10 && pred != 0xe &&
-	    ((ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureRAS)) != 0))
+	    ((CS_hasFeature(Inst->csh, ARM_FeatureRAS)) != 0))
 		S = MCDisassembler_SoftFail;
 
 	return S;
@@ -2764,8 +2779,8 @@ static DecodeStatus DecodeSETPANInstruction(MCInst *Inst, unsigned Insn,
 
 	unsigned Imm = fieldFromInstruction_4(Insn, 9, 1);
 
-	if (!ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8_1aOps) ||
-	    !ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8Ops))
+	if (!CS_hasFeature(Inst->csh, ARM_HasV8_1aOps) ||
+	    !CS_hasFeature(Inst->csh, ARM_HasV8Ops))
 		return MCDisassembler_Fail;
 
 	// Decoder can be called from DecodeTST, which does not check the full
@@ -4157,8 +4172,8 @@ static DecodeStatus DecodeT2LoadShift(MCInst *Inst, unsigned Insn,
 	unsigned Rt = fieldFromInstruction_4(Insn, 12, 4);
 	unsigned Rn = fieldFromInstruction_4(Insn, 16, 4);
 
-	bool hasMP = ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureMP);
-	bool hasV7Ops = ARM_getFeatureBits(Inst->csh->mode, ARM_HasV7Ops);
+	bool hasMP = CS_hasFeature(Inst->csh, ARM_FeatureMP);
+	bool hasV7Ops = CS_hasFeature(Inst->csh, ARM_HasV7Ops);
 
 	if (Rn == 15) {
 		switch (MCInst_getOpcode(Inst)) {
@@ -4244,8 +4259,8 @@ static DecodeStatus DecodeT2LoadImm8(MCInst *Inst, unsigned Insn,
 	imm |= (Rn << 9);
 	unsigned add = fieldFromInstruction_4(Insn, 9, 1);
 
-	bool hasMP = ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureMP);
-	bool hasV7Ops = ARM_getFeatureBits(Inst->csh->mode, ARM_HasV7Ops);
+	bool hasMP = CS_hasFeature(Inst->csh, ARM_FeatureMP);
+	bool hasV7Ops = CS_hasFeature(Inst->csh, ARM_HasV7Ops);
 
 	if (Rn == 15) {
 		switch (MCInst_getOpcode(Inst)) {
@@ -4324,8 +4339,8 @@ static DecodeStatus DecodeT2LoadImm12(MCInst *Inst, unsigned Insn,
 	unsigned imm = fieldFromInstruction_4(Insn, 0, 12);
 	imm |= (Rn << 13);
 
-	bool hasMP = ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureMP);
-	bool hasV7Ops = ARM_getFeatureBits(Inst->csh->mode, ARM_HasV7Ops);
+	bool hasMP = CS_hasFeature(Inst->csh, ARM_FeatureMP);
+	bool hasV7Ops = CS_hasFeature(Inst->csh, ARM_HasV7Ops);
 
 	if (Rn == 15) {
 		switch (MCInst_getOpcode(Inst)) {
@@ -4442,7 +4457,7 @@ static DecodeStatus DecodeT2LoadLabel(MCInst *Inst, unsigned Insn,
 	unsigned U = fieldFromInstruction_4(Insn, 23, 1);
 	int imm = fieldFromInstruction_4(Insn, 0, 12);
 
-	bool hasV7Ops = ARM_getFeatureBits(Inst->csh->mode, ARM_HasV7Ops);
+	bool hasV7Ops = CS_hasFeature(Inst->csh, ARM_HasV7Ops);
 
 	if (Rt == 15) {
 		switch (MCInst_getOpcode(Inst)) {
@@ -4946,7 +4961,7 @@ static DecodeStatus DecodeThumbTableBranch(MCInst *Inst, unsigned Insn,
 	unsigned Rn = fieldFromInstruction_4(Insn, 16, 4);
 	unsigned Rm = fieldFromInstruction_4(Insn, 0, 4);
 
-	if (Rn == 13 && !ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8Ops))
+	if (Rn == 13 && !CS_hasFeature(Inst->csh, ARM_HasV8Ops))
 		S = MCDisassembler_SoftFail;
 	if (!Check(&S, DecodeGPRRegisterClass(Inst, Rn, Address, Decoder)))
 		return MCDisassembler_Fail;
@@ -5094,7 +5109,7 @@ static DecodeStatus DecodeMSRMask(MCInst *Inst, unsigned Val, uint64_t Address,
 {
 	DecodeStatus S = MCDisassembler_Success;
 
-	if (ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureMClass)) {
+	if (CS_hasFeature(Inst->csh, ARM_FeatureMClass)) {
 		unsigned ValLow = Val & 0xff;
 
 		// Validate the SYSm value first.
@@ -5114,8 +5129,7 @@ static DecodeStatus DecodeMSRMask(MCInst *Inst, unsigned Val, uint64_t Address,
 		case 17: // basepri
 		case 18: // basepri_max
 		case 19: // faultmask
-			if (!(ARM_getFeatureBits(Inst->csh->mode,
-						 ARM_HasV7Ops)))
+			if (!(CS_hasFeature(Inst->csh, ARM_HasV7Ops)))
 				// Values basepri, basepri_max and faultmask are only valid for
 				// v7m.
 				return MCDisassembler_Fail;
@@ -5124,8 +5138,7 @@ static DecodeStatus DecodeMSRMask(MCInst *Inst, unsigned Val, uint64_t Address,
 		case 0x8b: // psplim_ns
 		case 0x91: // basepri_ns
 		case 0x93: // faultmask_ns
-			if (!(ARM_getFeatureBits(Inst->csh->mode,
-						 ARM_HasV8MMainlineOps)))
+			if (!(CS_hasFeature(Inst->csh, ARM_HasV8MMainlineOps)))
 				return MCDisassembler_Fail;
 			// fall through
 		case 10:   // msplim
@@ -5135,8 +5148,7 @@ static DecodeStatus DecodeMSRMask(MCInst *Inst, unsigned Val, uint64_t Address,
 		case 0x90: // primask_ns
 		case 0x94: // control_ns
 		case 0x98: // sp_ns
-			if (!(ARM_getFeatureBits(Inst->csh->mode,
-						 ARM_Feature8MSecExt)))
+			if (!(CS_hasFeature(Inst->csh, ARM_Feature8MSecExt)))
 				return MCDisassembler_Fail;
 			break;
 		case 0x20: // pac_key_p_0
@@ -5155,8 +5167,7 @@ static DecodeStatus DecodeMSRMask(MCInst *Inst, unsigned Val, uint64_t Address,
 		case 0xa5: // pac_key_u_1_ns
 		case 0xa6: // pac_key_u_2_ns
 		case 0xa7: // pac_key_u_3_ns
-			if (!(ARM_getFeatureBits(Inst->csh->mode,
-						 ARM_FeaturePACBTI)))
+			if (!(CS_hasFeature(Inst->csh, ARM_FeaturePACBTI)))
 				return MCDisassembler_Fail;
 			break;
 		default:
@@ -5167,8 +5178,7 @@ static DecodeStatus DecodeMSRMask(MCInst *Inst, unsigned Val, uint64_t Address,
 
 		if (MCInst_getOpcode(Inst) == ARM_t2MSR_M) {
 			unsigned Mask = fieldFromInstruction_4(Val, 10, 2);
-			if (!(ARM_getFeatureBits(Inst->csh->mode,
-						 ARM_HasV7Ops))) {
+			if (!(CS_hasFeature(Inst->csh, ARM_HasV7Ops))) {
 				// The ARMv6-M MSR bits {11-10} can be only 0b10, other values
 				// are unpredictable.
 				if (Mask != 2)
@@ -5182,8 +5192,8 @@ static DecodeStatus DecodeMSRMask(MCInst *Inst, unsigned Val, uint64_t Address,
 				// bits, the mask{0} bit can be set only if the processor
 				// includes the DSP extension.
 				if (Mask == 0 || (Mask != 2 && ValLow > 3) ||
-				    (!(ARM_getFeatureBits(Inst->csh->mode,
-							  ARM_FeatureDSP)) &&
+				    (!(CS_hasFeature(Inst->csh,
+						     ARM_FeatureDSP)) &&
 				     (Mask & 1)))
 					S = MCDisassembler_SoftFail;
 			}
@@ -6201,7 +6211,7 @@ static DecodeStatus DecodeVCVTD(MCInst *Inst, unsigned Insn, uint64_t Address,
 				const void *Decoder)
 {
 	bool hasFullFP16 =
-		ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureFullFP16);
+		CS_hasFeature(Inst->csh, ARM_FeatureFullFP16);
 
 	unsigned Vd = (fieldFromInstruction_4(Insn, 12, 4) << 0);
 	Vd |= (fieldFromInstruction_4(Insn, 22, 1) << 4);
@@ -6263,7 +6273,7 @@ static DecodeStatus DecodeVCVTQ(MCInst *Inst, unsigned Insn, uint64_t Address,
 				const void *Decoder)
 {
 	bool hasFullFP16 =
-		ARM_getFeatureBits(Inst->csh->mode, ARM_FeatureFullFP16);
+		CS_hasFeature(Inst->csh, ARM_FeatureFullFP16);
 
 	unsigned Vd = (fieldFromInstruction_4(Insn, 12, 4) << 0);
 	Vd |= (fieldFromInstruction_4(Insn, 22, 1) << 4);
@@ -6458,8 +6468,8 @@ static DecodeStatus DecodeForVMRSandVMSR(MCInst *Inst, unsigned Val,
 	if (MCInst_getOpcode(Inst) != ARM_FMSTAT) {
 		unsigned Rt = fieldFromInstruction_4(Val, 12, 4);
 
-		if (ARM_getFeatureBits(Inst->csh->mode, ARM_ModeThumb) &&
-		    !ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8Ops)) {
+		if (CS_hasFeature(Inst->csh, ARM_ModeThumb) &&
+		    !CS_hasFeature(Inst->csh, ARM_HasV8Ops)) {
 			if (Rt == 13 || Rt == 15)
 				S = MCDisassembler_SoftFail;
 			Check(&S, DecodeGPRRegisterClass(Inst, Rt, Address,
@@ -6479,7 +6489,7 @@ static DecodeStatus DecodeForVMRSandVMSR(MCInst *Inst, unsigned Val,
 		break;
 	}
 
-	if (ARM_getFeatureBits(Inst->csh->mode, ARM_ModeThumb)) {
+	if (CS_hasFeature(Inst->csh, ARM_ModeThumb)) {
 		MCOperand_CreateImm0(Inst, (ARMCC_AL));
 		MCOperand_CreateReg0(Inst, (0));
 	} else {
@@ -6931,9 +6941,9 @@ static unsigned FixedRegForVSTRVLDR_SYSREG(unsigned Opcode)
 		case ARM_VLDR_FPSCR_post: \
 		case ARM_VLDR_FPSCR_NZCVQC_post: \
 \
-			if (!ARM_getFeatureBits(Inst->csh->mode, \
+			if (!CS_hasFeature(Inst->csh, \
 						ARM_HasMVEIntegerOps) && \
-			    !ARM_getFeatureBits(Inst->csh->mode, \
+			    !CS_hasFeature(Inst->csh, \
 						ARM_FeatureVFP2)) \
 				return MCDisassembler_Fail; \
 		} \
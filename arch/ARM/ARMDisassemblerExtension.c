@@ -141,13 +141,13 @@ bool isValidCoprocessorNumber(MCInst *Inst, unsigned Num)
 	// know the new VFP/NEON mnemonics.
 
 	// Armv8-A disallows everything *other* than 111x (CP14 and CP15).
-	if (ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8Ops) &&
+	if (CS_hasFeature(Inst->csh, ARM_HasV8Ops) &&
 	    (Num & 0xE) != 0xE)
 		return false;
 
 	// Armv8.1-M disallows 100x (CP8,CP9) and 111x (CP14,CP15)
 	// which clash with MVE.
-	if (ARM_getFeatureBits(Inst->csh->mode, ARM_HasV8_1MMainlineOps) &&
+	if (CS_hasFeature(Inst->csh, ARM_HasV8_1MMainlineOps) &&
 	    ((Num & 0xE) == 0x8 || (Num & 0xE) == 0xE))
 		return false;
 
@@ -189,8 +189,7 @@ bool ARM_isCDECoproc(size_t Coproc, const MCInst *MI)
 	if (Coproc >= 8)
 		return false;
 
-	return ARM_getFeatureBits(MI->csh->mode,
-				  ARM_FeatureCoprocCDE0 + Coproc);
+	return CS_hasFeature(MI->csh, ARM_FeatureCoprocCDE0 + Coproc);
 }
 
 // Hacky: enable all features for disassembler
@@ -459,7 +459,7 @@ void printOperandAddr(MCInst *MI, uint64_t Address, unsigned OpNum, SStream *O)
 	int64_t Imm = MCOperand_getImm(Op);
 	// For ARM instructions the PC offset is 8 bytes, for Thumb instructions it
 	// is 4 bytes.
-	uint64_t Offset = ARM_getFeatureBits(MI->csh->mode, ARM_ModeThumb) ? 4 :
+	uint64_t Offset = CS_hasFeature(MI->csh, ARM_ModeThumb) ? 4 :
 									     8;
 
 	// A Thumb instruction BLX(i) can be 16-bit aligned while targets Arm code
@@ -928,8 +928,7 @@ void printMemBOption(MCInst *MI, unsigned OpNum, SStream *O)
 	add_cs_detail(MI, ARM_OP_GROUP_MemBOption, OpNum);
 	unsigned val = MCOperand_getImm(MCInst_getOperand(MI, (OpNum)));
 	SStream_concat0(O, ARM_MB_MemBOptToString(
-				   val, ARM_getFeatureBits(MI->csh->mode,
-							   ARM_HasV8Ops)));
+				   val, CS_hasFeature(MI->csh, ARM_HasV8Ops)));
 }
 
 void printInstSyncBOption(MCInst *MI, unsigned OpNum, SStream *O)
@@ -1047,14 +1046,14 @@ void printMSRMaskOperand(MCInst *MI, unsigned OpNum, SStream *O)
 	add_cs_detail(MI, ARM_OP_GROUP_MSRMaskOperand, OpNum);
 	MCOperand *Op = MCInst_getOperand(MI, (OpNum));
 
-	if (ARM_getFeatureBits(MI->csh->mode, ARM_FeatureMClass)) {
+	if (CS_hasFeature(MI->csh, ARM_FeatureMClass)) {
 		unsigned SYSm = MCOperand_getImm(Op) & 0xFFF; // 12-bit SYSm
 		unsigned Opcode = MCInst_getOpcode(MI);
 
 		// For writes, handle extended mask bits if the DSP extension is
 		// present.
 		if (Opcode == ARM_t2MSR_M &&
-		    ARM_getFeatureBits(MI->csh->mode, ARM_FeatureDSP)) {
+		    CS_hasFeature(MI->csh, ARM_FeatureDSP)) {
 			const ARMSysReg_MClassSysReg *TheReg =
 				ARMSysReg_lookupMClassSysRegBy12bitSYSmValue(
 					SYSm);
@@ -1068,7 +1067,7 @@ void printMSRMaskOperand(MCInst *MI, unsigned OpNum, SStream *O)
 		// Handle the basic 8-bit mask.
 		SYSm &= 0xff;
 		if (Opcode == ARM_t2MSR_M &&
-		    ARM_getFeatureBits(MI->csh->mode, ARM_HasV7Ops)) {
+		    CS_hasFeature(MI->csh, ARM_HasV7Ops)) {
 			// ARMv7-M deprecates using MSR APSR without a _<bits> qualifier as
 			// an alias for MSR APSR_nzcvq.
 			const ARMSysReg_MClassSysReg *TheReg =
@@ -93,7 +93,13 @@ const insn_map arm_insns[] = {
 #include "ARMGenCSMappingInsn.inc"
 };
 
-void ARM_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+#ifndef CAPSTONE_DIET
+static const map_insn_ops insn_operands[] = {
+#include "ARMGenCSMappingInsnOp.inc"
+};
+#endif
+
+void ARM_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// Not used by ARM. Information is set after disassembly.
 }
@@ -161,15 +167,17 @@ static void patch_cs_reg_alias(char *asm_str)
 
 /// Check if PC is updated from stack. Those POP instructions
 /// are considered of group RETURN.
+/// The MC operands are checked, because the detail operands might not be
+/// filled (CS_OPT_DETAIL_OPERANDS).
 static void check_pop_return(MCInst *MI) {
 	if (!MI->flat_insn->detail)
 		return;
 	if (MI->flat_insn->id != ARM_INS_POP && MI->flat_insn->alias_id != ARM_INS_ALIAS_POP) {
 		return;
 	}
-	for (size_t i = 0; i < ARM_get_detail(MI)->op_count; ++i) {
-		cs_arm_op *op = &ARM_get_detail(MI)->operands[i];
-		if (op->type == ARM_OP_REG && op->reg == ARM_REG_PC) {
+	for (unsigned i = 0; i < MCInst_getNumOperands(MI); ++i) {
+		MCOperand *op = MCInst_getOperand(MI, i);
+		if (MCOperand_isReg(op) && MCOperand_getReg(op) == ARM_REG_PC) {
 			add_group(MI, ARM_GRP_RET);
 			return;
 		}
@@ -179,15 +187,33 @@ static void check_pop_return(MCInst *MI) {
 /// Check if PC is directly written.Those instructions
 /// are considered of group BRANCH.
 static void check_writes_to_pc(MCInst *MI) {
+#ifndef CAPSTONE_DIET
 	if (!MI->flat_insn->detail)
 		return;
-	for (size_t i = 0; i < ARM_get_detail(MI)->op_count; ++i) {
-		cs_arm_op *op = &ARM_get_detail(MI)->operands[i];
-		if (op->type == ARM_OP_REG && op->reg == ARM_REG_PC && (op->access & CS_AC_WRITE)) {
+	const mapping_op *map_op = NULL;
+	for (unsigned i = 0; i < MCInst_getNumOperands(MI); ++i) {
+		// The registers of a list share the mapping entry of the
+		// first one.
+		bool own_entry = i < MAX_NO_INSN_MAP_OPS &&
+				 insn_operands[MCInst_getOpcode(MI)].ops[i].type;
+		if (own_entry)
+			map_op = &insn_operands[MCInst_getOpcode(MI)].ops[i];
+		MCOperand *op = MCInst_getOperand(MI, i);
+		// Memory operands and the written back base register are not
+		// register operands.
+		if (!map_op || (map_op->type & CS_OP_MEM) ||
+		    MCInst_opIsTied(MI, i))
+			continue;
+		if (!MCOperand_isReg(op) || MCOperand_getReg(op) != ARM_REG_PC)
+			continue;
+		uint8_t access = own_entry ? map_get_op_access(MI, i) :
+					     map_op->access;
+		if (access & CS_AC_WRITE) {
 			add_group(MI, ARM_GRP_JUMP);
 			return;
 		}
 	}
+#endif // CAPSTONE_DIET
 }
 
 /// Adds group to the instruction which are not defined in LLVM.
@@ -226,7 +252,8 @@ static void add_alias_details(MCInst *MI) {
 		return;
 	case ARM_INS_ALIAS_POP:
 		// Doesn't get set because memop is not printed.
-		if (ARM_get_detail(MI)->op_count == 1) {
+		if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) &&
+		    ARM_get_detail(MI)->op_count == 1) {
 			CS_ASSERT_RET(MI->flat_insn->usesAliasDetails && "Not valid assumption for non alias details.");
 			// Only single register pop is post-indexed
 			// Assumes only alias details are passed here.
@@ -246,7 +273,7 @@ static void add_alias_details(MCInst *MI) {
 			if (MCInst_getOpVal(MI, i) == BaseReg)
 				Writeback = false;
 		}
-		if (Writeback && detail_is_set(MI)) {
+		if (Writeback && detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 			ARM_get_detail(MI)->operands[0].access |= CS_AC_WRITE;
 			MI->flat_insn->detail->writeback = true;
 		}
@@ -258,6 +285,8 @@ static void add_alias_details(MCInst *MI) {
 	case ARM_INS_ALIAS_ROR: {
 		unsigned shift_value = 0;
 		arm_shifter shift_type = ARM_SFT_INVALID;
+		if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
+			break;
 		switch (MCInst_getOpcode(MI)) {
 		default:
 			CS_ASSERT_RET(0 && "ASR, LSL, LSR, ROR alias not handled");
@@ -301,6 +330,9 @@ static void ARM_add_not_defined_ops(MCInst *MI)
 		return;
 	}
 
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
+		return;
+
 	unsigned Opcode = MCInst_getOpcode(MI);
 	switch (Opcode) {
 	default:
@@ -559,7 +591,7 @@ static void ARM_add_not_defined_ops(MCInst *MI)
 			if (MCInst_getOpVal(MI, i) == BaseReg)
 				Writeback = false;
 		}
-		if (Writeback && detail_is_set(MI)) {
+		if (Writeback && detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 			ARM_get_detail(MI)->operands[0].access |= CS_AC_WRITE;
 			MI->flat_insn->detail->writeback = true;
 		}
@@ -573,7 +605,7 @@ static void ARM_add_not_defined_ops(MCInst *MI)
 /// See: https://github.com/capstone-engine/capstone/issues/2152
 void ARM_add_vector_data(MCInst *MI, arm_vectordata_type data_type)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	ARM_get_detail(MI)->vector_data = data_type;
 }
@@ -583,7 +615,7 @@ void ARM_add_vector_data(MCInst *MI, arm_vectordata_type data_type)
 /// See: https://github.com/capstone-engine/capstone/issues/2152
 void ARM_add_vector_size(MCInst *MI, unsigned size)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	ARM_get_detail(MI)->vector_size = size;
 }
@@ -598,7 +630,8 @@ void ARM_add_vector_size(MCInst *MI, unsigned size)
 /// the disponent/index reg.
 static void ARM_post_index_detection(MCInst *MI)
 {
-	if (!detail_is_set(MI) || ARM_get_detail(MI)->post_index)
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) ||
+	    ARM_get_detail(MI)->post_index)
 		return;
 
 	int i = 0;
@@ -633,7 +666,7 @@ void ARM_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info)
 {
 	MCRegisterInfo *MRI = (MCRegisterInfo *)info;
 	MI->MRI = MRI;
-	MI->fillDetailOps = detail_is_set(MI);
+	MI->fillDetailOps = detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS);
 	MI->flat_insn->usesAliasDetails = map_use_alias_details(MI);
 	ARM_LLVM_printInstruction(MI, O, info);
 	map_set_alias_id(MI, O, insn_alias_mnem_map, ARR_SIZE(insn_alias_mnem_map) - 1);
@@ -751,15 +784,17 @@ bool ARM_blx_to_arm_mode(cs_struct *h, unsigned int id)
 void ARM_check_updates_flags(MCInst *MI)
 {
 #ifndef CAPSTONE_DIET
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
-	cs_detail *detail = get_detail(MI);
-	for (int i = 0; i < detail->regs_write_count; ++i) {
-		if (detail->regs_write[i] == 0)
+	// Check the mapping table, the implicit registers might not be filled
+	// (CS_OPT_DETAIL_IMPLICIT_REGS).
+	const uint16_t *regs_mod = arm_insns[MCInst_getOpcode(MI)].regs_mod;
+	for (int i = 0; i < MAX_IMPL_W_REGS; ++i) {
+		if (regs_mod[i] == 0)
 			return;
 		for (int j = 0; j < ARR_SIZE(arm_flag_regs); ++j) {
-			if (detail->regs_write[i] == arm_flag_regs[j]) {
-				detail->arm.update_flags = true;
+			if (regs_mod[i] == arm_flag_regs[j]) {
+				ARM_get_detail(MI)->update_flags = true;
 				return;
 			}
 		}
@@ -788,23 +823,36 @@ bool ARM_getInstruction(csh handle, const uint8_t *code, size_t code_len,
 	return Result;
 }
 
+/// Returns the size of the instruction at @code. Only the Thumb encoding
+/// is variable, the ARM one is handled by cs_insn_size() itself.
+uint16_t ARM_getInsnSize(cs_struct *handle, const uint8_t *code,
+			 size_t code_len)
+{
+	if (code_len < 2)
+		return 0;
+	uint16_t hw = MODE_IS_BIG_ENDIAN(handle->mode) ?
+			      (code[0] << 8) | code[1] :
+			      (code[1] << 8) | code[0];
+	// 32-bit Thumb-2 instructions start with 0b11101, 0b11110 or 0b11111.
+	uint16_t size = (hw >> 11) >= 0x1d ? 4 : 2;
+	return code_len < size ? 0 : size;
+}
+
 #define GET_REGINFO_MC_DESC
 #include "ARMGenRegisterInfo.inc"
 
-void ARM_init_mri(MCRegisterInfo *MRI)
+const MCRegisterInfo *ARM_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(MRI, ARMRegDesc, ARM_REG_ENDING, 0, 0,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(ARMRegDesc, ARM_REG_ENDING, 0, 0,
 					  ARMMCRegisterClasses,
 					  ARR_SIZE(ARMMCRegisterClasses), 0, 0,
 					  ARMRegDiffLists, 0, ARMSubRegIdxLists,
 					  ARR_SIZE(ARMSubRegIdxLists), 0);
+
+	return &mri;
 }
 
 #ifndef CAPSTONE_DIET
-static const map_insn_ops insn_operands[] = {
-#include "ARMGenCSMappingInsnOp.inc"
-};
-
 void ARM_reg_access(const cs_insn *insn, cs_regs regs_read,
 		    uint8_t *regs_read_count, cs_regs regs_write,
 		    uint8_t *regs_write_count)
@@ -956,7 +1004,7 @@ static uint64_t t_vmov_mod_imm(uint64_t v)
 /// E.g. the base register and the immediate disponent.
 static void ARM_set_mem_access(MCInst *MI, bool status)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	set_doing_mem(MI, status);
 	if (status) {
@@ -985,7 +1033,7 @@ static void add_cs_detail_RegImmShift(MCInst *MI, ARM_AM_ShiftOpc ShOpc,
 	if (ShOpc == ARM_AM_no_shift || (ShOpc == ARM_AM_lsl && !ShImm))
 		return;
 
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	if (doing_mem(MI))
@@ -1009,7 +1057,7 @@ static void add_cs_detail_RegImmShift(MCInst *MI, ARM_AM_ShiftOpc ShOpc,
 static void add_cs_detail_general(MCInst *MI, arm_op_group op_group,
 				  unsigned OpNum)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	cs_op_type op_type = map_get_op_type(MI, OpNum);
 
@@ -1254,14 +1302,14 @@ static void add_cs_detail_general(MCInst *MI, arm_op_group op_group,
 		unsigned Mask = (unsigned)MCOperand_getImm(Op) & 0xf;
 		bool IsOutReg = OpNum == 0;
 
-		if (ARM_getFeatureBits(MI->csh->mode, ARM_FeatureMClass)) {
+		if (CS_hasFeature(MI->csh, ARM_FeatureMClass)) {
 			const ARMSysReg_MClassSysReg *TheReg;
 			unsigned SYSm = (unsigned)MCOperand_getImm(Op) &
 					0xFFF; // 12-bit SYMm
 			unsigned Opcode = MCInst_getOpcode(MI);
 
 			if (Opcode == ARM_t2MSR_M &&
-			    ARM_getFeatureBits(MI->csh->mode, ARM_FeatureDSP)) {
+			    CS_hasFeature(MI->csh, ARM_FeatureDSP)) {
 				TheReg =
 					ARMSysReg_lookupMClassSysRegBy12bitSYSmValue(
 						SYSm);
@@ -1277,7 +1325,7 @@ static void add_cs_detail_general(MCInst *MI, arm_op_group op_group,
 
 			SYSm &= 0xff;
 			if (Opcode == ARM_t2MSR_M &&
-			    ARM_getFeatureBits(MI->csh->mode, ARM_HasV7Ops)) {
+			    CS_hasFeature(MI->csh, ARM_HasV7Ops)) {
 				TheReg =
 					ARMSysReg_lookupMClassSysRegAPSRNonDeprecated(
 						SYSm);
@@ -1299,7 +1347,7 @@ static void add_cs_detail_general(MCInst *MI, arm_op_group op_group,
 				return;
 			}
 
-			if (detail_is_set(MI))
+			if (detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 				MCOperand_CreateImm0(MI, SYSm);
 
 			ARM_set_detail_op_sysop(MI, SYSm, ARM_OP_SYSREG,
@@ -1746,7 +1794,7 @@ static void add_cs_detail_general(MCInst *MI, arm_op_group op_group,
 static void add_cs_detail_template_1(MCInst *MI, arm_op_group op_group,
 				     unsigned OpNum, uint64_t temp_arg_0)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	switch (op_group) {
 	default:
@@ -1893,7 +1941,7 @@ static void add_cs_detail_template_2(MCInst *MI, arm_op_group op_group,
 				     unsigned OpNum, uint64_t temp_arg_0,
 				     uint64_t temp_arg_1)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	switch (op_group) {
 	default:
@@ -1916,7 +1964,8 @@ static void add_cs_detail_template_2(MCInst *MI, arm_op_group op_group,
 void ARM_add_cs_detail(MCInst *MI, int /* arm_op_group */ op_group,
 		       va_list args)
 {
-	if (!detail_is_set(MI) || !map_fill_detail_ops(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) ||
+	    !map_fill_detail_ops(MI))
 		return;
 	switch (op_group) {
 	case ARM_OP_GROUP_RegImmShift: {
@@ -1965,7 +2014,7 @@ void ARM_add_cs_detail(MCInst *MI, int /* arm_op_group */ op_group,
 
 static void insert_op(MCInst *MI, unsigned index, cs_arm_op op)
 {
-	if (!detail_is_set(MI)) {
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		return;
 	}
 	ARM_check_safe_inc(MI);
@@ -1990,7 +2039,7 @@ static void insert_op(MCInst *MI, unsigned index, cs_arm_op op)
 void ARM_insert_detail_op_reg_at(MCInst *MI, unsigned index, arm_reg Reg,
 				 cs_ac_type access)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	cs_arm_op op;
@@ -2007,7 +2056,7 @@ void ARM_insert_detail_op_reg_at(MCInst *MI, unsigned index, arm_reg Reg,
 void ARM_insert_detail_op_imm_at(MCInst *MI, unsigned index, int64_t Val,
 				 cs_ac_type access)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	ARM_check_safe_inc(MI);
 
@@ -2024,7 +2073,7 @@ void ARM_insert_detail_op_imm_at(MCInst *MI, unsigned index, int64_t Val,
 /// one.
 void ARM_set_detail_op_reg(MCInst *MI, unsigned OpNum, arm_reg Reg)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	ARM_check_safe_inc(MI);
 	CS_ASSERT_RET(!(map_get_op_type(MI, OpNum) & CS_OP_MEM));
@@ -2041,7 +2090,7 @@ void ARM_set_detail_op_reg(MCInst *MI, unsigned OpNum, arm_reg Reg)
 void ARM_set_detail_op_imm(MCInst *MI, unsigned OpNum, arm_op_type ImmType,
 			   int64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	ARM_check_safe_inc(MI);
 	CS_ASSERT_RET(!(map_get_op_type(MI, OpNum) & CS_OP_MEM));
@@ -2084,7 +2133,7 @@ void ARM_set_detail_op_mem_offset(MCInst *MI, unsigned OpNum, uint64_t Val,
 void ARM_set_detail_op_mem(MCInst *MI, unsigned OpNum, bool is_index_reg,
 			   int scale, uint64_t Val)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	CS_ASSERT_RET(map_get_op_type(MI, OpNum) & CS_OP_MEM);
 	cs_op_type secondary_type = map_get_op_type(MI, OpNum) & ~CS_OP_MEM;
@@ -2136,7 +2185,7 @@ void ARM_set_detail_op_mem(MCInst *MI, unsigned OpNum, bool is_index_reg,
 /// MI->operands[OpNum] Decrements op_count by 1.
 void ARM_set_detail_op_neon_lane(MCInst *MI, unsigned OpNum)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	CS_ASSERT_RET(map_get_op_type(MI, OpNum) == CS_OP_IMM);
 	unsigned Val = MCOperand_getImm(MCInst_getOperand(MI, OpNum));
@@ -2150,7 +2199,7 @@ void ARM_set_detail_op_neon_lane(MCInst *MI, unsigned OpNum)
 void ARM_set_detail_op_sysop(MCInst *MI, int Val, arm_op_type type,
 			     bool IsOutReg, uint8_t Mask, uint16_t Sysm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	ARM_check_safe_inc(MI);
 
@@ -2181,7 +2230,7 @@ void ARM_set_detail_op_sysop(MCInst *MI, int Val, arm_op_type type,
 /// Increments the op_counter by one.
 void ARM_set_detail_op_float(MCInst *MI, unsigned OpNum, uint64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	ARM_check_safe_inc(MI);
 
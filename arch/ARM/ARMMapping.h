@@ -23,7 +23,7 @@ const char *ARM_reg_name(csh handle, unsigned int reg);
 void ARM_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info);
 
 // given internal insn id, return public instruction ID
-void ARM_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void ARM_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *ARM_insn_name(csh handle, unsigned int id);
 
@@ -44,9 +44,11 @@ ARMBankedReg_lookupBankedRegByEncoding(uint8_t encoding);
 bool ARM_getInstruction(csh handle, const uint8_t *code, size_t code_len,
 			MCInst *instr, uint16_t *size, uint64_t address,
 			void *info);
+uint16_t ARM_getInsnSize(cs_struct *handle, const uint8_t *code,
+			 size_t code_len);
 void ARM_set_instr_map_data(MCInst *MI);
 
-void ARM_init_mri(MCRegisterInfo *MRI);
+const MCRegisterInfo *ARM_get_mri(void);
 
 // cs_detail related functions
 void ARM_init_cs_detail(MCInst *MI);
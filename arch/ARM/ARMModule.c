@@ -9,26 +9,28 @@
 #include "../../cs_priv.h"
 #include "ARMInstPrinter.h"
 #include "ARMMapping.h"
+#include "ARMDisassemblerExtension.h"
+#include "ARMBaseInfo.h"
 
 cs_err ARM_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
-
-	ARM_init_mri(mri);
+	const MCRegisterInfo *mri = ARM_get_mri();
 
 	ud->printer = ARM_printer;
-	ud->printer_info = mri;
+	ud->printer_info = (void *)mri;
 	ud->reg_name = ARM_reg_name;
 	ud->insn_id = ARM_get_insn_id;
 	ud->insn_name = ARM_insn_name;
 	ud->group_name = ARM_group_name;
 	ud->post_printer = NULL;
+	ud->insn_size = ARM_getInsnSize;
 #ifndef CAPSTONE_DIET
 	ud->reg_access = ARM_reg_access;
 #endif
 
 	ud->disasm = ARM_getInstruction;
+	ud->feature_bits_of = ARM_getFeatureBits;
+	ud->num_features = ARM_NumSubtargetFeatures;
 
 	return CS_ERR_OK;
 }
@@ -102,12 +102,13 @@ DecodeStatus Alpha_LLVM_getInstruction(csh handle, const uint8_t *Bytes,
 	return MCDisassembler_Fail;
 }
 
-void Alpha_init(MCRegisterInfo *MRI)
+const MCRegisterInfo *Alpha_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(
-		MRI, AlphaRegDesc, ARR_SIZE(AlphaRegDesc), 0, 0, AlphaMCRegisterClasses,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(AlphaRegDesc, ARR_SIZE(AlphaRegDesc), 0, 0, AlphaMCRegisterClasses,
 		ARR_SIZE(AlphaMCRegisterClasses), 0, 0, AlphaRegDiffLists, 0,
 		AlphaSubRegIdxLists, 1, 0);
+
+	return &mri;
 }
 
 #endif
\ No newline at end of file
@@ -13,6 +13,6 @@
 #include "../../MCRegisterInfo.h"
 #include <capstone/capstone.h>
 
-void Alpha_init(MCRegisterInfo *MRI);
+const MCRegisterInfo *Alpha_get_mri(void);
 
 #endif // CS_ALPHADISASSEMBLER_H
\ No newline at end of file
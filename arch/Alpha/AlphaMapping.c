@@ -79,12 +79,13 @@ void Alpha_set_detail_op_reg(MCInst *MI, unsigned OpNum, alpha_op_type Reg)
 }
 
 // given internal insn id, return public instruction info
-void Alpha_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void Alpha_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	unsigned short i;
 
-	i = insn_find(insns, ARR_SIZE(insns), id, &h->insn_cache);
-	if (i == 0) { return; }
+	// insns is generated in the order of the internal insn ids
+	if (id == 0 || id >= ARR_SIZE(insns)) { return; }
+	i = id;
 	insn->id = insns[i].mapid;
 
 	if (insn->detail) {
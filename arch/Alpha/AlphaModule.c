@@ -11,14 +11,11 @@
 
 cs_err ALPHA_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
+	const MCRegisterInfo *mri = Alpha_get_mri();
 
-	mri = cs_mem_malloc(sizeof(*mri));
-
-	Alpha_init(mri);
 	ud->printer = Alpha_printInst;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = Alpha_getInstruction;
 	ud->post_printer = NULL;
 
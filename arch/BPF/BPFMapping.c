@@ -380,8 +380,9 @@ static void update_regs_access(cs_struct *ud, cs_detail *detail,
  * 1. Convert opcode(id) to BPF_INS_*
  * 2. Set regs_read/regs_write/groups
  */
-void BPF_get_insn_id(cs_struct *ud, cs_insn *insn, unsigned int opcode)
+void BPF_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int opcode)
 {
+	cs_struct *ud = MI->csh;
 	// No need to care the mode (cBPF or eBPF) since all checks has be done in
 	// BPF_getInstruction, we can simply map opcode to BPF_INS_*.
 	bpf_insn id = BPF_INS_INVALID;
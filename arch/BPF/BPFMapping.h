@@ -13,7 +13,7 @@
 const char *BPF_group_name(csh handle, unsigned int id);
 const char *BPF_insn_name(csh handle, unsigned int id);
 const char *BPF_reg_name(csh handle, unsigned int reg);
-void BPF_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void BPF_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 void BPF_reg_access(const cs_insn *insn,
 		cs_regs regs_read, uint8_t *regs_read_count,
 		cs_regs regs_write, uint8_t *regs_write_count);
@@ -299,7 +299,7 @@ bool EVM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 	if (MI->flat_insn->detail) {
 		memset(MI->flat_insn->detail, 0, offsetof(cs_detail, evm)+sizeof(cs_evm));
-		EVM_get_insn_id((cs_struct *)ud, MI->flat_insn, opcode);
+		EVM_get_insn_id(MI, MI->flat_insn, opcode);
 
 		if (MI->flat_insn->detail->evm.pop) {
 			MI->flat_insn->detail->groups[MI->flat_insn->detail->groups_count] = EVM_GRP_STACK_READ;
@@ -32,12 +32,12 @@ static int evm_insn_find(const cs_evm *insns, unsigned int max, unsigned int id)
 #endif
 
 // fill in details
-void EVM_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void EVM_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	insn->id = id;
 #ifndef CAPSTONE_DIET
 	if (evm_insn_find(insns, ARR_SIZE(insns), id) > 0) {
-		if (h->detail_opt) {
+		if (MI->detail_opt) {
 			memcpy(&insn->detail->evm, &insns[id], sizeof(insns[id]));
 		}
 	}
@@ -365,7 +365,7 @@ const char *HPPA_reg_name(csh handle, unsigned int reg)
 #endif
 }
 
-void HPPA_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int opcode)
+void HPPA_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int opcode)
 {
 	insn->id = opcode;
 }
@@ -25,15 +25,17 @@
 #define GET_INSTRINFO_ENUM
 #include "LoongArchGenInstrInfo.inc"
 
-void LoongArch_init_mri(MCRegisterInfo *MRI)
+const MCRegisterInfo *LoongArch_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(MRI, LoongArchRegDesc,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(LoongArchRegDesc,
 					  sizeof(LoongArchRegDesc), 0, 0,
 					  LoongArchMCRegisterClasses,
 					  ARR_SIZE(LoongArchMCRegisterClasses),
 					  0, 0, LoongArchRegDiffLists, 0,
 					  LoongArchSubRegIdxLists,
 					  ARR_SIZE(LoongArchSubRegIdxLists), 0);
+
+	return &mri;
 }
 
 const char *LoongArch_reg_name(csh handle, unsigned int reg)
@@ -47,7 +49,7 @@ const char *LoongArch_reg_name(csh handle, unsigned int reg)
 	return LoongArch_LLVM_getRegisterName(reg, LoongArch_RegAliasName);
 }
 
-void LoongArch_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void LoongArch_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// Not used by LoongArch. Information is set after disassembly.
 }
@@ -175,7 +177,7 @@ void LoongArch_rewrite_memory_operand(MCInst *MI)
 	//                 operands[1].mem.disp: 0x410
 	//        operands[1].access: READ
 
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	const loongarch_suppl_info *suppl_info =
@@ -311,7 +313,7 @@ void LoongArch_set_instr_map_data(MCInst *MI)
 	map_groups(MI, loongarch_insns);
 	const loongarch_suppl_info *suppl_info =
 		map_get_suppl_info(MI, loongarch_insns);
-	if (suppl_info) {
+	if (suppl_info && detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		LoongArch_get_detail(MI)->format = suppl_info->form;
 	}
 }
@@ -336,7 +338,6 @@ static void LoongArch_add_cs_groups(MCInst *MI)
 	if (!MI->flat_insn->detail)
 		return;
 	unsigned Opcode = MI->flat_insn->id;
-	cs_loongarch *loongarch = &(MI->flat_insn->detail->loongarch);
 	switch (Opcode) {
 	default:
 		return;
@@ -344,16 +345,19 @@ static void LoongArch_add_cs_groups(MCInst *MI)
 		add_group(MI, LOONGARCH_GRP_CALL);
 		break;
 	case LOONGARCH_INS_JIRL:
-		if (loongarch->op_count == 3 &&
-		    loongarch->operands[0].reg == LOONGARCH_REG_RA) {
+		// The MC operands are checked, the detail operands might not
+		// be filled (CS_OPT_DETAIL_OPERANDS).
+		if (MCInst_getOpVal(MI, 0) == LOONGARCH_REG_RA) {
 			// call: jirl ra, rj, offs16
 			add_group(MI, LOONGARCH_GRP_CALL);
-		} else if (loongarch->op_count == 0) {
-			// ret
-			add_group(MI, LOONGARCH_GRP_RET);
-		} else if (loongarch->op_count == 1) {
-			// jr rj
-			add_group(MI, LOONGARCH_GRP_JUMP);
+		} else if (MCInst_getOpVal(MI, 0) == LOONGARCH_REG_ZERO &&
+			   MCInst_getOpVal(MI, 2) == 0) {
+			if (MCInst_getOpVal(MI, 1) == LOONGARCH_REG_RA)
+				// ret
+				add_group(MI, LOONGARCH_GRP_RET);
+			else
+				// jr rj
+				add_group(MI, LOONGARCH_GRP_JUMP);
 		}
 		break;
 	case LOONGARCH_INS_B:
@@ -439,7 +443,7 @@ static const map_insn_ops insn_operands[] = {
 void LoongArch_set_detail_op_imm(MCInst *MI, unsigned OpNum,
 				 loongarch_op_type ImmType, int64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	CS_ASSERT_RET((map_get_op_type(MI, OpNum) & ~CS_OP_MEM) == CS_OP_IMM);
 	CS_ASSERT_RET(ImmType == LOONGARCH_OP_IMM);
@@ -452,7 +456,7 @@ void LoongArch_set_detail_op_imm(MCInst *MI, unsigned OpNum,
 
 void LoongArch_set_detail_op_reg(MCInst *MI, unsigned OpNum, loongarch_reg Reg)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	CS_ASSERT_RET((map_get_op_type(MI, OpNum) & ~CS_OP_MEM) == CS_OP_REG);
 
@@ -465,7 +469,7 @@ void LoongArch_set_detail_op_reg(MCInst *MI, unsigned OpNum, loongarch_reg Reg)
 void LoongArch_add_cs_detail(MCInst *MI, int /* loongarch_op_group */ op_group,
 			     va_list args)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	unsigned OpNum = va_arg(args, unsigned);
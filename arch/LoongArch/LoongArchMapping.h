@@ -12,7 +12,7 @@ typedef enum {
 #include "LoongArchGenCSOpGroup.inc"
 } loongarch_op_group;
 
-void LoongArch_init_mri(MCRegisterInfo *MRI);
+const MCRegisterInfo *LoongArch_get_mri(void);
 
 // return name of register in friendly string
 const char *LoongArch_reg_name(csh handle, unsigned int reg);
@@ -21,7 +21,7 @@ void LoongArch_printer(MCInst *MI, SStream *O,
 		       void * /* MCRegisterInfo* */ info);
 
 // given internal insn id, return public instruction ID
-void LoongArch_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void LoongArch_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *LoongArch_insn_name(csh handle, unsigned int id);
 
@@ -10,16 +10,17 @@
 #include "../../MCRegisterInfo.h"
 #include "../../cs_priv.h"
 #include "LoongArchMapping.h"
+#include "LoongArchDisassemblerExtension.h"
+
+#define GET_SUBTARGETINFO_ENUM
+#include "LoongArchGenSubtargetInfo.inc"
 
 cs_err LoongArch_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
-
-	LoongArch_init_mri(mri);
+	const MCRegisterInfo *mri = LoongArch_get_mri();
 
 	ud->printer = LoongArch_printer;
-	ud->printer_info = mri;
+	ud->printer_info = (void *)mri;
 	ud->reg_name = LoongArch_reg_name;
 	ud->insn_id = LoongArch_get_insn_id;
 	ud->insn_name = LoongArch_insn_name;
@@ -30,6 +31,8 @@ cs_err LoongArch_global_init(cs_struct *ud)
 #endif
 
 	ud->disasm = LoongArch_getInstruction;
+	ud->feature_bits_of = LoongArch_getFeatureBits;
+	ud->num_features = LoongArch_NumSubtargetFeatures;
 
 	return CS_ERR_OK;
 }
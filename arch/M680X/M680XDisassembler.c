@@ -241,8 +241,9 @@ static int binary_search(const inst_pageX *const inst_pageX_table,
 	return -2;
 }
 
-void M680X_get_insn_id(cs_struct *handle, cs_insn *insn, unsigned int id)
+void M680X_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
+	cs_struct *handle = MI->csh;
 	const m680x_info *const info = (const m680x_info *)handle->printer_info;
 	const cpu_tables *cpu = info->cpu;
 	uint8_t insn_prefix = (id >> 8) & 0xff;
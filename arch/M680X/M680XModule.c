@@ -52,6 +52,7 @@ cs_err M680X_global_init(cs_struct *ud)
 
 	ud->printer = M680X_printInst;
 	ud->printer_info = info;
+	ud->printer_info_size = sizeof(m680x_info);
 	ud->getinsn_info = NULL;
 	ud->disasm = M680X_getInstruction;
 	ud->reg_name = M680X_reg_name;
@@ -342,7 +342,7 @@ const char* M68K_reg_name(csh handle, unsigned int reg)
 #endif
 }
 
-void M68K_get_insn_id(cs_struct* h, cs_insn* insn, unsigned int id)
+void M68K_get_insn_id(MCInst *MI, cs_insn* insn, unsigned int id)
 {
 	insn->id = id; // These id's matches for 68k
 }
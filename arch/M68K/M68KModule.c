@@ -20,6 +20,7 @@ cs_err M68K_global_init(cs_struct *ud)
 
 	ud->printer = M68K_printInst;
 	ud->printer_info = info;
+	ud->printer_info_size = sizeof(m68k_info);
 	ud->getinsn_info = NULL;
 	ud->disasm = M68K_getInstruction;
 	ud->skipdata_size = 2;
@@ -523,7 +523,7 @@ const char* MOS65XX_reg_name(csh handle, unsigned int reg)
 #endif
 }
 
-void MOS65XX_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void MOS65XX_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	/* id is cpu_offset + opcode */
 	if (id < ARR_SIZE(OpInfoTable)) {
@@ -22,6 +22,7 @@ cs_err MOS65XX_global_init(cs_struct *ud)
 
 	ud->printer = MOS65XX_printInst;
 	ud->printer_info = info;
+	ud->printer_info_size = sizeof(*info);
 	ud->insn_id = MOS65XX_get_insn_id;
 	ud->insn_name = MOS65XX_insn_name;
 	ud->group_name = MOS65XX_group_name;
@@ -777,6 +777,20 @@ static DecodeStatus DecodeFIXMEInstruction(MCInst *Inst, uint32_t Insn,
 
 #include "MipsGenDisassemblerTables.inc"
 
+// Decodes with a decoder table, unless the key of the table rules out Insn.
+#define decodeTable_2(Table, MI, Insn, Address, Decoder) \
+	(decoderTableMayDecode(Table##Keys, Insn) ? \
+		 decodeInstruction_2(Table, MI, Insn, Address, Decoder) : \
+		 MCDisassembler_Fail)
+#define decodeTable_4(Table, MI, Insn, Address, Decoder) \
+	(decoderTableMayDecode(Table##Keys, Insn) ? \
+		 decodeInstruction_4(Table, MI, Insn, Address, Decoder) : \
+		 MCDisassembler_Fail)
+#define decodeTable_8(Table, MI, Insn, Address, Decoder) \
+	(decoderTableMayDecode(Table##Keys, Insn) ? \
+		 decodeInstruction_8(Table, MI, Insn, Address, Decoder) : \
+		 MCDisassembler_Fail)
+
 static unsigned getReg(const MCInst *Inst, unsigned RC, unsigned RegNo)
 {
 	const MCRegisterClass* c = MCRegisterInfo_getRegClass(Inst->MRI, RC);
@@ -1453,20 +1467,19 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 	DecodeStatus Result;
 	*Size = 0;
 
-	cs_mode mode = Instr->csh->mode;
-	bool IsBigEndian = mode & CS_MODE_BIG_ENDIAN;
-	bool IsMicroMips = Mips_getFeatureBits(mode, Mips_FeatureMicroMips);
-	bool IsNanoMips = Mips_getFeatureBits(mode, Mips_FeatureNanoMips);
-	bool IsMips32r6 = Mips_getFeatureBits(mode, Mips_FeatureMips32r6);
-	bool IsMips2 = Mips_getFeatureBits(mode, Mips_FeatureMips2);
-	bool IsCnMips = Mips_getFeatureBits(mode, Mips_FeatureCnMips);
-	bool IsCnMipsP = Mips_getFeatureBits(mode, Mips_FeatureCnMipsP);
-	bool IsFP64 = Mips_getFeatureBits(mode, Mips_FeatureFP64Bit);
-	bool IsGP64 = Mips_getFeatureBits(mode, Mips_FeatureGP64Bit);
-	bool IsPTR64 = Mips_getFeatureBits(mode, Mips_FeaturePTR64Bit);
+	bool IsBigEndian = Instr->csh->mode & CS_MODE_BIG_ENDIAN;
+	bool IsMicroMips = CS_hasFeature(Instr->csh, Mips_FeatureMicroMips);
+	bool IsNanoMips = CS_hasFeature(Instr->csh, Mips_FeatureNanoMips);
+	bool IsMips32r6 = CS_hasFeature(Instr->csh, Mips_FeatureMips32r6);
+	bool IsMips2 = CS_hasFeature(Instr->csh, Mips_FeatureMips2);
+	bool IsCnMips = CS_hasFeature(Instr->csh, Mips_FeatureCnMips);
+	bool IsCnMipsP = CS_hasFeature(Instr->csh, Mips_FeatureCnMipsP);
+	bool IsFP64 = CS_hasFeature(Instr->csh, Mips_FeatureFP64Bit);
+	bool IsGP64 = CS_hasFeature(Instr->csh, Mips_FeatureGP64Bit);
+	bool IsPTR64 = CS_hasFeature(Instr->csh, Mips_FeaturePTR64Bit);
 	// Only present in MIPS-I and MIPS-II
-	bool HasCOP3 = !Mips_getFeatureBits(mode, Mips_FeatureMips32) &&
-					 !Mips_getFeatureBits(mode, Mips_FeatureMips3);
+	bool HasCOP3 = !CS_hasFeature(Instr->csh, Mips_FeatureMips32) &&
+					 !CS_hasFeature(Instr->csh, Mips_FeatureMips3);
 
 	if (IsNanoMips) {
 		uint64_t Insn2;
@@ -1474,8 +1487,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 						&Insn2, IsBigEndian, IsNanoMips);
 		if (Result != MCDisassembler_Fail) {
 			// Calling the auto-generated decoder function.
-			Result = decodeInstruction_8(DecoderTableNanoMips48,
-						   Instr, Insn2, Address, NULL);
+			Result = decodeTable_8(DecoderTableNanoMips48, Instr,
+					       Insn2, Address, NULL);
 			if (Result != MCDisassembler_Fail) {
 				*Size = 6;
 				return Result;
@@ -1486,9 +1499,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 						&Insn, IsBigEndian, IsNanoMips);
 		if (Result != MCDisassembler_Fail) {
 			// Calling the auto-generated decoder function.
-			Result = decodeInstruction_4(DecoderTableNanoMips32,
-						     Instr, Insn, Address,
-						     NULL);
+			Result = decodeTable_4(DecoderTableNanoMips32, Instr,
+					       Insn, Address, NULL);
 			if (Result != MCDisassembler_Fail) {
 				*Size = 4;
 				return Result;
@@ -1500,9 +1512,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 		if (Result != MCDisassembler_Fail) {
 			// Calling the auto-generated decoder function for NanoMips
 			// 16-bit instructions.
-			Result = decodeInstruction_2(DecoderTableNanoMips16,
-						     Instr, Insn, Address,
-						     NULL);
+			Result = decodeTable_2(DecoderTableNanoMips16, Instr,
+					       Insn, Address, NULL);
 			if (Result != MCDisassembler_Fail) {
 				*Size = 2;
 				return Result;
@@ -1525,9 +1536,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 		if (IsMips32r6) {
 			// Calling the auto-generated decoder function for microMIPS32R6
 			// 16-bit instructions.
-			Result = decodeInstruction_2(DecoderTableMicroMipsR616,
-						     Instr, Insn, Address,
-						     NULL);
+			Result = decodeTable_2(DecoderTableMicroMipsR616, Instr,
+					       Insn, Address, NULL);
 			if (Result != MCDisassembler_Fail) {
 				*Size = 2;
 				return Result;
@@ -1536,8 +1546,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 
 		// Calling the auto-generated decoder function for microMIPS 16-bit
 		// instructions.
-		Result = decodeInstruction_2(DecoderTableMicroMips16, Instr,
-					     Insn, Address, NULL);
+		Result = decodeTable_2(DecoderTableMicroMips16, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 2;
 			return Result;
@@ -1550,9 +1560,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 
 		if (IsMips32r6) {
 			// Calling the auto-generated decoder function.
-			Result = decodeInstruction_4(DecoderTableMicroMipsR632,
-						     Instr, Insn, Address,
-						     NULL);
+			Result = decodeTable_4(DecoderTableMicroMipsR632, Instr,
+					       Insn, Address, NULL);
 			if (Result != MCDisassembler_Fail) {
 				*Size = 4;
 				return Result;
@@ -1560,8 +1569,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 		}
 
 		// Calling the auto-generated decoder function.
-		Result = decodeInstruction_4(DecoderTableMicroMips32, Instr,
-					     Insn, Address, NULL);
+		Result = decodeTable_4(DecoderTableMicroMips32, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail) {
 			*Size = 4;
 			return Result;
@@ -1569,8 +1578,8 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 
 		if (IsFP64) {
 			Result =
-				decodeInstruction_4(DecoderTableMicroMipsFP6432,
-						    Instr, Insn, Address, NULL);
+				decodeTable_4(DecoderTableMicroMipsFP6432,
+					      Instr, Insn, Address, NULL);
 			if (Result != MCDisassembler_Fail) {
 				*Size = 4;
 				return Result;
@@ -1598,71 +1607,70 @@ static DecodeStatus getInstruction(MCInst *Instr, uint64_t *Size, const uint8_t
 	*Size = 4;
 
 	if (HasCOP3) {
-		Result = decodeInstruction_4(DecoderTableCOP3_32, Instr, Insn,
-					     Address, NULL);
+		Result = decodeTable_4(DecoderTableCOP3_32, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsMips32r6 && IsGP64) {
-		Result = decodeInstruction_4(DecoderTableMips32r6_64r6_GP6432,
-					     Instr, Insn, Address, NULL);
+		Result = decodeTable_4(DecoderTableMips32r6_64r6_GP6432, Instr,
+				       Insn, Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsMips32r6 && IsPTR64) {
-		Result = decodeInstruction_4(DecoderTableMips32r6_64r6_PTR6432,
-					     Instr, Insn, Address, NULL);
+		Result = decodeTable_4(DecoderTableMips32r6_64r6_PTR6432, Instr,
+				       Insn, Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsMips32r6) {
-		Result = decodeInstruction_4(DecoderTableMips32r6_64r632, Instr,
-					     Insn, Address, NULL);
+		Result = decodeTable_4(DecoderTableMips32r6_64r632, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsMips2 && IsPTR64) {
-		Result = decodeInstruction_4(DecoderTableMips32_64_PTR6432,
-					     Instr, Insn, Address, NULL);
+		Result = decodeTable_4(DecoderTableMips32_64_PTR6432, Instr,
+				       Insn, Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsCnMips) {
-		Result = decodeInstruction_4(DecoderTableCnMips32, Instr, Insn,
-					     Address, NULL);
+		Result = decodeTable_4(DecoderTableCnMips32, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsCnMipsP) {
-		Result = decodeInstruction_4(DecoderTableCnMipsP32, Instr, Insn,
-					     Address, NULL);
+		Result = decodeTable_4(DecoderTableCnMipsP32, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsGP64) {
-		Result = decodeInstruction_4(DecoderTableMips6432, Instr, Insn,
-					     Address, NULL);
+		Result = decodeTable_4(DecoderTableMips6432, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	if (IsFP64) {
-		Result = decodeInstruction_4(DecoderTableMipsFP6432, Instr,
-					     Insn, Address, NULL);
+		Result = decodeTable_4(DecoderTableMipsFP6432, Instr, Insn,
+				       Address, NULL);
 		if (Result != MCDisassembler_Fail)
 			return Result;
 	}
 
 	// Calling the auto-generated decoder function.
-	Result = decodeInstruction_4(DecoderTableMips32, Instr, Insn, Address,
-				     NULL);
+	Result = decodeTable_4(DecoderTableMips32, Instr, Insn, Address, NULL);
 	if (Result != MCDisassembler_Fail)
 		return Result;
 
@@ -1846,7 +1854,7 @@ static DecodeStatus DecodePtrRegisterClass(MCInst *Inst, unsigned RegNo,
 					   uint64_t Address,
 					   const void *Decoder)
 {
-	if (Mips_getFeatureBits(Inst->csh->mode, Mips_FeatureGP64Bit))
+	if (CS_hasFeature(Inst->csh, Mips_FeatureGP64Bit))
 		return DecodeGPR64RegisterClass(Inst, RegNo, Address, Decoder);
 
 	return DecodeGPR32RegisterClass(Inst, RegNo, Address, Decoder);
@@ -25,14 +25,16 @@
 #define GET_INSTRINFO_ENUM
 #include "MipsGenInstrInfo.inc"
 
-void Mips_init_mri(MCRegisterInfo *MRI)
+const MCRegisterInfo *Mips_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(MRI, MipsRegDesc, sizeof(MipsRegDesc),
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(MipsRegDesc, sizeof(MipsRegDesc),
 					  0, 0, MipsMCRegisterClasses,
 					  ARR_SIZE(MipsMCRegisterClasses), 0, 0,
 					  MipsRegDiffLists, 0,
 					  MipsSubRegIdxLists,
 					  ARR_SIZE(MipsSubRegIdxLists), 0);
+
+	return &mri;
 }
 
 const char *Mips_reg_name(csh handle, unsigned int reg)
@@ -42,7 +44,7 @@ const char *Mips_reg_name(csh handle, unsigned int reg)
 					 syntax_opt & CS_OPT_SYNTAX_NOREGNAME);
 }
 
-void Mips_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void Mips_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// Not used by Mips. Information is set after disassembly.
 }
@@ -234,7 +236,7 @@ static void Mips_set_detail_op_mem_disp(MCInst *MI, unsigned OpNum, int64_t Imm)
 
 static void Mips_set_detail_op_imm(MCInst *MI, unsigned OpNum, int64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	if (doing_mem(MI)) {
@@ -250,7 +252,7 @@ static void Mips_set_detail_op_imm(MCInst *MI, unsigned OpNum, int64_t Imm)
 
 static void Mips_set_detail_op_uimm(MCInst *MI, unsigned OpNum, uint64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	if (doing_mem(MI)) {
@@ -268,7 +270,7 @@ static void Mips_set_detail_op_uimm(MCInst *MI, unsigned OpNum, uint64_t Imm)
 static void Mips_set_detail_op_reg(MCInst *MI, unsigned OpNum, mips_reg Reg,
 				   bool is_reglist)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	if (doing_mem(MI)) {
@@ -375,7 +377,8 @@ static void Mips_set_detail_op_unsigned_address(MCInst *MI, unsigned OpNum)
 
 void Mips_add_cs_detail(MCInst *MI, mips_op_group op_group, va_list args)
 {
-	if (!detail_is_set(MI) || !map_fill_detail_ops(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) ||
+	    !map_fill_detail_ops(MI))
 		return;
 
 	unsigned OpNum = va_arg(args, unsigned);
@@ -450,7 +453,7 @@ void Mips_add_cs_detail(MCInst *MI, mips_op_group op_group, va_list args)
 
 void Mips_set_mem_access(MCInst *MI, bool status)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	set_doing_mem(MI, status);
 	if (status) {
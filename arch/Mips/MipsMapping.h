@@ -12,7 +12,7 @@ typedef enum {
 #include "MipsGenCSOpGroup.inc"
 } mips_op_group;
 
-void Mips_init_mri(MCRegisterInfo *MRI);
+const MCRegisterInfo *Mips_get_mri(void);
 
 // return name of register in friendly string
 const char *Mips_reg_name(csh handle, unsigned int reg);
@@ -21,7 +21,7 @@ void Mips_printer(MCInst *MI, SStream *O,
 		       void * /* MCRegisterInfo* */ info);
 
 // given internal insn id, return public instruction ID
-void Mips_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void Mips_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *Mips_insn_name(csh handle, unsigned int id);
 
@@ -44,7 +44,7 @@ void Mips_add_cs_detail(MCInst *MI, mips_op_group op_group, va_list args);
 
 static inline void add_cs_detail(MCInst *MI, mips_op_group op_group, ...)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	va_list args;
 	va_start(args, op_group);
@@ -54,7 +54,7 @@ static inline void add_cs_detail(MCInst *MI, mips_op_group op_group, ...)
 
 static inline void set_mem_access(MCInst *MI, bool status)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	Mips_set_mem_access(MI, status);
 }
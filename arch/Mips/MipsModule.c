@@ -9,22 +9,25 @@
 #include "../../MCRegisterInfo.h"
 #include "../../cs_priv.h"
 #include "MipsMapping.h"
+#include "MipsDisassembler.h"
+
+#define GET_SUBTARGETINFO_ENUM
+#include "MipsGenSubtargetInfo.inc"
 
 cs_err Mips_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
-
-	Mips_init_mri(mri);
+	const MCRegisterInfo *mri = Mips_get_mri();
 
 	ud->printer = Mips_printer;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->reg_name = Mips_reg_name;
 	ud->insn_id = Mips_get_insn_id;
 	ud->insn_name = Mips_insn_name;
 	ud->group_name = Mips_group_name;
 	ud->disasm = Mips_getInstruction;
+	ud->feature_bits_of = Mips_getFeatureBits;
+	ud->num_features = Mips_NumSubtargetFeatures;
 	ud->post_printer = NULL;
 #ifndef CAPSTONE_DIET
 	ud->reg_access = Mips_reg_access;
@@ -480,7 +480,7 @@ DecodeStatus getInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 	// TODO: In this function we call decodeInstruction several times with
 	//       different decoder tables. It may be possible to only call once by
 	//       looking at the top 6 bits of the instruction.
-	if (PPC_getFeatureBits(MI->csh->mode, PPC_FeaturePrefixInstrs) &&
+	if (CS_hasFeature(MI->csh, PPC_FeaturePrefixInstrs) &&
 	    BytesLen >= 8) {
 		uint32_t Prefix = readBytes32(MI, Bytes);
 		uint32_t BaseInst = readBytes32(MI, Bytes + 4);
@@ -503,17 +503,17 @@ DecodeStatus getInstruction(csh ud, const uint8_t *Bytes, size_t BytesLen,
 	// Read the instruction in the proper endianness.
 	uint64_t Inst = readBytes32(MI, Bytes);
 
-	if (PPC_getFeatureBits(MI->csh->mode, PPC_FeatureQPX)) {
+	if (CS_hasFeature(MI->csh, PPC_FeatureQPX)) {
 		DecodeStatus result = decodeInstruction_4(DecoderTableQPX32, MI,
 							  Inst, Address);
 		if (result != MCDisassembler_Fail)
 			return result;
-	} else if (PPC_getFeatureBits(MI->csh->mode, PPC_FeatureSPE)) {
+	} else if (CS_hasFeature(MI->csh, PPC_FeatureSPE)) {
 		DecodeStatus result = decodeInstruction_4(DecoderTableSPE32, MI,
 							  Inst, Address);
 		if (result != MCDisassembler_Fail)
 			return result;
-	} else if (PPC_getFeatureBits(MI->csh->mode, PPC_FeaturePS)) {
+	} else if (CS_hasFeature(MI->csh, PPC_FeaturePS)) {
 		DecodeStatus result = decodeInstruction_4(DecoderTablePS32, MI,
 							  Inst, Address);
 		if (result != MCDisassembler_Fail)
@@ -73,7 +73,7 @@ static void printInst(MCInst *MI, uint64_t Address, const char *Annot,
 	// symbol reference, the instruction syntax is changed to look like a load
 	// operation, i.e:
 	//     Transform:  addis $rD, $rA, $src --> addis $rD, $src($rA).
-	if (PPC_getFeatureBits(MI->csh->mode, PPC_FeatureModernAIXAs) &&
+	if (CS_hasFeature(MI->csh, PPC_FeatureModernAIXAs) &&
 	    (MCInst_getOpcode(MI) == PPC_ADDIS8 ||
 	     MCInst_getOpcode(MI) == PPC_ADDIS) &&
 	    MCOperand_isExpr(MCInst_getOperand(MI, (2)))) {
@@ -168,7 +168,7 @@ static void printInst(MCInst *MI, uint64_t Address, const char *Annot,
 	// the "modern assembler" is available.
 	if ((MCInst_getOpcode(MI) == PPC_DCBT ||
 	     MCInst_getOpcode(MI) == PPC_DCBTST) &&
-	    (!PPC_getFeatureBits(MI->csh->mode, PPC_FeatureModernAIXAs))) {
+	    (!CS_hasFeature(MI->csh, PPC_FeatureModernAIXAs))) {
 		unsigned char TH = MCOperand_getImm(MCInst_getOperand(MI, (0)));
 		SStream_concat0(O, "\tdcbt");
 		if (MCInst_getOpcode(MI) == PPC_DCBTST)
@@ -178,7 +178,7 @@ static void printInst(MCInst *MI, uint64_t Address, const char *Annot,
 		SStream_concat0(O, " ");
 
 		bool IsBookE =
-			PPC_getFeatureBits(MI->csh->mode, PPC_FeatureBookE);
+			CS_hasFeature(MI->csh, PPC_FeatureBookE);
 		if (IsBookE && TH != 0 && TH != 16) {
 			SStream_concat(O, "%s", (unsigned int)TH);
 			SStream_concat0(O, ", ");
@@ -522,7 +522,7 @@ void printBranchOperand(MCInst *MI, uint64_t Address, unsigned OpNo, SStream *O)
 		// Branches can take an immediate operand. This is used by the branch
 		// selection pass to print, for example `.+8` (for ELF) or `$+8` (for
 		// AIX) to express an eight byte displacement from the program counter.
-		if (!PPC_getFeatureBits(MI->csh->mode, PPC_FeatureModernAIXAs))
+		if (!CS_hasFeature(MI->csh, PPC_FeatureModernAIXAs))
 			SStream_concat0(O, ".");
 		else
 			SStream_concat0(O, "$");
@@ -670,7 +670,7 @@ bool showRegistersWithPercentPrefix(const MCInst *MI, const char *RegName)
 {
 	if ((MI->csh->syntax & CS_OPT_SYNTAX_NOREGNAME) ||
 	    !(MI->csh->syntax & CS_OPT_SYNTAX_PERCENT) ||
-	    PPC_getFeatureBits(MI->csh->mode, PPC_FeatureModernAIXAs))
+	    CS_hasFeature(MI->csh, PPC_FeatureModernAIXAs))
 		return false;
 
 	switch (RegName[0]) {
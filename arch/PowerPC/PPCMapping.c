@@ -19,14 +19,16 @@
 #define GET_REGINFO_MC_DESC
 #include "PPCGenRegisterInfo.inc"
 
-void PPC_init_mri(MCRegisterInfo *MRI)
+const MCRegisterInfo *PPC_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(MRI, PPCRegDesc, PPC_REG_ENDING, 0, 0,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(PPCRegDesc, PPC_REG_ENDING, 0, 0,
 					  PPCMCRegisterClasses,
 					  ARR_SIZE(PPCMCRegisterClasses), 0, 0,
 					  PPCRegDiffLists, 0, PPCSubRegIdxLists,
 					  ARR_SIZE(PPCSubRegIdxLists),
 					  PPCRegEncodingTable);
+
+	return &mri;
 }
 
 const char *PPC_reg_name(csh handle, unsigned int reg)
@@ -37,7 +39,7 @@ const char *PPC_reg_name(csh handle, unsigned int reg)
 }
 
 // given internal insn id, return public instruction info
-void PPC_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void PPC_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// We do this after Instruction disassembly.
 }
@@ -107,13 +109,15 @@ const insn_map ppc_insns[] = {
 void PPC_check_updates_cr0(MCInst *MI)
 {
 #ifndef CAPSTONE_DIET
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
-	cs_detail *detail = get_detail(MI);
-	for (int i = 0; i < detail->regs_write_count; ++i) {
-		if (detail->regs_write[i] == 0)
+	// The mapping table is checked, the implicit registers might not be
+	// filled (CS_OPT_DETAIL_IMPLICIT_REGS).
+	const uint16_t *regs_mod = ppc_insns[MCInst_getOpcode(MI)].regs_mod;
+	for (int i = 0; i < MAX_IMPL_W_REGS; ++i) {
+		if (regs_mod[i] == 0)
 			return;
-		if (detail->regs_write[i] == PPC_REG_CR0) {
+		if (regs_mod[i] == PPC_REG_CR0) {
 			PPC_get_detail(MI)->update_cr0 = true;
 			return;
 		}
@@ -125,7 +129,7 @@ void PPC_check_updates_cr0(MCInst *MI)
 static void PPC_add_branch_predicates(MCInst *MI, const uint8_t *Bytes,
 				      size_t BytesLen)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 #ifndef CAPSTONE_DIET
 	CS_ASSERT_RET(MI && Bytes);
@@ -198,7 +202,7 @@ void PPC_set_instr_map_data(MCInst *MI, const uint8_t *Bytes, size_t BytesLen)
 	PPC_add_branch_predicates(MI, Bytes, BytesLen);
 	PPC_check_updates_cr0(MI);
 	const ppc_suppl_info *suppl_info = map_get_suppl_info(MI, ppc_insns);
-	if (suppl_info) {
+	if (suppl_info && detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		PPC_get_detail(MI)->format = suppl_info->form;
 	}
 }
@@ -222,7 +226,7 @@ void PPC_init_cs_detail(MCInst *MI)
 void PPC_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info)
 {
 	MI->MRI = (MCRegisterInfo *)info;
-	MI->fillDetailOps = detail_is_set(MI);
+	MI->fillDetailOps = detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS);
 	MI->flat_insn->usesAliasDetails = map_use_alias_details(MI);
 	PPC_LLVM_printInst(MI, MI->address, "", O);
 #ifndef CAPSTONE_DIET
@@ -242,6 +246,20 @@ bool PPC_getInstruction(csh handle, const uint8_t *bytes, size_t bytes_len,
 	return result != MCDisassembler_Fail;
 }
 
+uint16_t PPC_getInsnSize(cs_struct *handle, const uint8_t *code,
+			 size_t code_len)
+{
+	if (code_len < 4)
+		return 0;
+	// Prefixed instructions are 8 bytes long. Their prefix word has the
+	// primary opcode 1 (the top 6 bits), independent of the endianness.
+	uint8_t primary = MODE_IS_BIG_ENDIAN(handle->mode) ? code[0] : code[3];
+	if (CS_hasFeature(handle, PPC_FeaturePrefixInstrs) &&
+	    (primary >> 2) == 1)
+		return code_len < 8 ? 0 : 8;
+	return 4;
+}
+
 bool PPC_getFeatureBits(unsigned int mode, unsigned int feature)
 {
 	if ((feature == PPC_FeatureQPX) && (mode & CS_MODE_QPX) == 0) {
@@ -293,7 +311,7 @@ static void handle_memory_operand(MCInst *MI, unsigned OpNum)
 static void add_cs_detail_general(MCInst *MI, ppc_op_group op_group,
 				  unsigned OpNum)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	switch (op_group) {
@@ -467,7 +485,8 @@ static void add_cs_detail_general(MCInst *MI, ppc_op_group op_group,
 /// patch `AddCSDetail` of the CppTranslator.
 void PPC_add_cs_detail(MCInst *MI, ppc_op_group op_group, va_list args)
 {
-	if (!detail_is_set(MI) || !map_fill_detail_ops(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) ||
+	    !map_fill_detail_ops(MI))
 		return;
 
 	switch (op_group) {
@@ -531,7 +550,7 @@ void PPC_add_cs_detail(MCInst *MI, ppc_op_group op_group, va_list args)
 void PPC_set_detail_op_mem(MCInst *MI, unsigned OpNum, uint64_t Val,
 			   bool is_off_reg)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	CS_ASSERT_RET(map_get_op_type(MI, OpNum) & CS_OP_MEM);
@@ -566,7 +585,7 @@ void PPC_set_detail_op_mem(MCInst *MI, unsigned OpNum, uint64_t Val,
 /// one.
 void PPC_set_detail_op_reg(MCInst *MI, unsigned OpNum, ppc_reg Reg)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	PPC_check_safe_inc(MI);
 	CS_ASSERT_RET(!(map_get_op_type(MI, OpNum) & CS_OP_MEM));
@@ -582,7 +601,7 @@ void PPC_set_detail_op_reg(MCInst *MI, unsigned OpNum, ppc_reg Reg)
 /// by one.
 void PPC_set_detail_op_imm(MCInst *MI, unsigned OpNum, int64_t Imm)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	PPC_check_safe_inc(MI);
 	CS_ASSERT_RET(!(map_get_op_type(MI, OpNum) & CS_OP_MEM));
@@ -596,7 +615,7 @@ void PPC_set_detail_op_imm(MCInst *MI, unsigned OpNum, int64_t Imm)
 
 void PPC_set_mem_access(MCInst *MI, bool status)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	PPC_check_safe_inc(MI);
 	if ((!status && !doing_mem(MI)) || (status && doing_mem(MI)))
@@ -631,7 +650,8 @@ void PPC_setup_op(cs_ppc_op *op)
 void PPC_insert_detail_op_imm_at(MCInst *MI, unsigned index, int64_t Val,
 				 cs_ac_type access)
 {
-	if (!detail_is_set(MI) || !map_fill_detail_ops(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) ||
+	    !map_fill_detail_ops(MI))
 		return;
 
 	PPC_check_safe_inc(MI);
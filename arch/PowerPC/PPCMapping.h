@@ -12,7 +12,7 @@ typedef enum {
 #include "PPCGenCSOpGroup.inc"
 } ppc_op_group;
 
-void PPC_init_mri(MCRegisterInfo *MRI);
+const MCRegisterInfo *PPC_get_mri(void);
 
 void PPC_init_cs_detail(MCInst *MI);
 
@@ -23,9 +23,11 @@ void PPC_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info);
 bool PPC_getInstruction(csh handle, const uint8_t *code, size_t code_len,
 			MCInst *instr, uint16_t *size, uint64_t address,
 			void *info);
+uint16_t PPC_getInsnSize(cs_struct *handle, const uint8_t *code,
+			 size_t code_len);
 
 // given internal insn id, return public instruction info
-void PPC_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void PPC_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *PPC_insn_name(csh handle, unsigned int id);
 const char *PPC_group_name(csh handle, unsigned int id);
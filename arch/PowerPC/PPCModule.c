@@ -8,18 +8,20 @@
 #include "PPCInstPrinter.h"
 #include "PPCMapping.h"
 #include "PPCModule.h"
+#include "PPCMCTargetDesc.h"
 
 cs_err PPC_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = (MCRegisterInfo *)cs_mem_malloc(sizeof(*mri));
+	const MCRegisterInfo *mri = PPC_get_mri();
 
-	PPC_init_mri(mri);
 	ud->printer = PPC_printer;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = PPC_getInstruction;
+	ud->feature_bits_of = PPC_getFeatureBits;
+	ud->num_features = PPC_NumSubtargetFeatures;
 	ud->post_printer = NULL;
+	ud->insn_size = PPC_getInsnSize;
 
 	ud->reg_name = PPC_reg_name;
 	ud->insn_id = PPC_get_insn_id;
@@ -309,7 +309,7 @@ static DecodeStatus decodeFRMArg(MCInst *Inst, uint64_t Imm,
 static void init_MI_insn_detail(MCInst *MI) 
 {
   	if (MI->flat_insn->detail) {
-    		memset(MI->flat_insn->detail, 0, sizeof(cs_detail));
+    		memset(MI->flat_insn->detail, 0, offsetof(cs_detail, riscv)+sizeof(cs_riscv));
   	}
 
   	return;
@@ -376,7 +376,7 @@ static DecodeStatus RISCVDisassembler_getInstruction(int mode, MCInst *MI,
       		Inst = code[0] | (code[1] << 8) | (code[2] << 16) | ((uint32_t)code[3] << 24);
 		init_MI_insn_detail(MI);
 		// Now we need mark what instruction need fix effective address output.
-		if (MI->csh->detail_opt)
+		if (MI->detail_opt)
 			markLSInsn(MI, Inst);
       		Result = decodeInstruction(DecoderTable32, MI, Inst, Address, MRI, mode);
   	} else {
@@ -429,7 +429,18 @@ bool RISCV_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 }
 
-void RISCV_init(MCRegisterInfo * MRI) 
+uint16_t RISCV_getInsnSize(cs_struct *handle, const uint8_t *code,
+			   size_t code_len)
+{
+	if (code_len < 2)
+		return 0;
+	// It's a 32 bit instruction if bit 0 and 1 are 1.
+	// Otherwise it is a compressed one.
+	uint16_t size = (code[0] & 0x3) == 0x3 ? 4 : 2;
+	return code_len < size ? 0 : size;
+}
+
+const MCRegisterInfo *RISCV_get_mri(void)
 {
   	/*
   	InitMCRegisterInfo(RISCVRegDesc, 97, RA, PC,
@@ -446,7 +457,7 @@ void RISCV_init(MCRegisterInfo * MRI)
                      RISCVRegEncodingTable);
   	*/
 
-  	MCRegisterInfo_InitMCRegisterInfo(MRI, RISCVRegDesc, 97, 0, 0,
+  	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(RISCVRegDesc, 97, 0, 0,
 				    	  RISCVMCRegisterClasses, 11,
 				          0, 
 				          0,
@@ -455,6 +466,8 @@ void RISCV_init(MCRegisterInfo * MRI)
 				          RISCVSubRegIdxLists, 
 				          2, 
 				          0);
+
+	return &mri;
 }
 
 #endif
@@ -9,10 +9,13 @@
 #include "../../MCRegisterInfo.h"
 #include "../../MCInst.h"
 
-void RISCV_init(MCRegisterInfo *MRI);
+const MCRegisterInfo *RISCV_get_mri(void);
 
 bool RISCV_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		          MCInst *instr, uint16_t *size, uint64_t address,
 		          void *info);
 
+uint16_t RISCV_getInsnSize(cs_struct *handle, const uint8_t *code,
+			   size_t code_len);
+
 #endif
@@ -250,7 +250,7 @@ void RISCV_printInst(MCInst *MI, SStream *O, void *info)
     		printInstruction(MI, O, MRI);
   		//printAnnotation(O, Annot);
 	// fix load/store type insttuction
-    	if (MI->csh->detail_opt && 
+    	if (MI->detail_opt && 
 	    MI->flat_insn->detail->riscv.need_effective_addr)
 		fixDetailOfEffectiveAddr(MI);
 	
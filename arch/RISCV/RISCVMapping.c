@@ -141,6 +141,11 @@ static const insn_map insns[] = {
 #include "RISCVMappingInsn.inc"
 };
 
+// id-to-index map of insns
+static const unsigned short insns_idx[] = {
+#include "RISCVMappingInsnIdx.inc"
+};
+
 #ifndef CAPSTONE_DIET
 
 static const map_insn_ops insn_operands[] = {
@@ -173,15 +178,15 @@ void RISCV_add_cs_detail(MCInst *MI, unsigned OpNum) {
 }
 
 // given internal insn id, return public instruction info
-void RISCV_get_insn_id(cs_struct * h, cs_insn * insn, unsigned int id) 
+void RISCV_get_insn_id(MCInst *MI, cs_insn * insn, unsigned int id) 
 {
   	unsigned int i;
 
-  	i = insn_find(insns, ARR_SIZE(insns), id, &h->insn_cache);
+  	i = insn_find(insns_idx, ARR_SIZE(insns_idx), id);
   	if (i != 0) {
     		insn->id = insns[i].mapid;
 
-    		if (h->detail_opt) {
+    		if (MI->detail_opt) {
 #ifndef CAPSTONE_DIET
       			memcpy(insn->detail->regs_read,
       			insns[i].regs_use, sizeof(insns[i].regs_use));
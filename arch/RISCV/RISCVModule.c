@@ -13,15 +13,14 @@
 
 cs_err RISCV_global_init(cs_struct * ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
+	const MCRegisterInfo *mri = RISCV_get_mri();
 
-	RISCV_init(mri);
 	ud->printer = RISCV_printInst;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = RISCV_getInstruction;
 	ud->post_printer = NULL;
+	ud->insn_size = RISCV_getInsnSize;
 
 	ud->reg_name = RISCV_reg_name;
 	ud->insn_id = RISCV_get_insn_id;
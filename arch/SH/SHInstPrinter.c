@@ -46,7 +46,7 @@ const char* SH_reg_name(csh handle, unsigned int reg)
 }
 
 
-void SH_get_insn_id(cs_struct* h, cs_insn* insn, unsigned int id)
+void SH_get_insn_id(MCInst *MI, cs_insn* insn, unsigned int id)
 {
 	insn->id = id; // These id's matches for sh
 }
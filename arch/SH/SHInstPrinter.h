@@ -16,7 +16,7 @@ struct SStream;
 
 void SH_printInst(MCInst *MI, struct SStream *O, void *Info);
 const char* SH_reg_name(csh handle, unsigned int reg);
-void SH_get_insn_id(cs_struct* h, cs_insn* insn, unsigned int id);
+void SH_get_insn_id(MCInst *MI, cs_insn* insn, unsigned int id);
 const char* SH_insn_name(csh handle, unsigned int id);
 const char *SH_group_name(csh handle, unsigned int id);
 
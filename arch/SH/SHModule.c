@@ -19,6 +19,7 @@ cs_err SH_global_init(cs_struct *ud)
 
 	ud->printer = SH_printInst;
 	ud->printer_info = info;
+	ud->printer_info_size = sizeof(sh_info);
 	ud->reg_name = SH_reg_name;
 	ud->insn_id = SH_get_insn_id;
 	ud->insn_name = SH_insn_name;
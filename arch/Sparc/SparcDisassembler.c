@@ -472,7 +472,7 @@ static DecodeStatus DecodeSWAP(MCInst *MI, unsigned insn, uint64_t Address,
 	return MCDisassembler_Success;
 }
 
-void Sparc_init(MCRegisterInfo *MRI)
+const MCRegisterInfo *Sparc_get_mri(void)
 {
 	/*
 	InitMCRegisterInfo(SparcRegDesc, 119, RA, PC,
@@ -487,7 +487,7 @@ void Sparc_init(MCRegisterInfo *MRI)
 			SparcRegEncodingTable);
 	*/
 
-	MCRegisterInfo_InitMCRegisterInfo(MRI, SparcRegDesc, 119,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(SparcRegDesc, 119,
 			0, 0,
 			SparcMCRegisterClasses, 8,
 			0, 0,
@@ -495,6 +495,8 @@ void Sparc_init(MCRegisterInfo *MRI)
 			0,
 			SparcSubRegIdxLists, 7,
 			0);
+
+	return &mri;
 }
 
 #endif
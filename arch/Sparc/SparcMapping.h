@@ -10,7 +10,7 @@
 const char *Sparc_reg_name(csh handle, unsigned int reg);
 
 // given internal insn id, return public instruction info
-void Sparc_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void Sparc_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *Sparc_insn_name(csh handle, unsigned int id);
 
@@ -12,13 +12,11 @@
 
 cs_err Sparc_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
+	const MCRegisterInfo *mri = Sparc_get_mri();
 
-	Sparc_init(mri);
 	ud->printer = Sparc_printInst;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = Sparc_getInstruction;
 	ud->post_printer = Sparc_post_printer;
 
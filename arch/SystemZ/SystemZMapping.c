@@ -48,18 +48,19 @@ void SystemZ_set_instr_map_data(MCInst *MI, const uint8_t *Bytes, size_t BytesLe
 	map_groups(MI, systemz_insns);
 	const systemz_suppl_info *suppl_info =
 		map_get_suppl_info(MI, systemz_insns);
-	if (suppl_info) {
+	if (suppl_info && detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS)) {
 		SystemZ_get_detail(MI)->format = suppl_info->form;
 	}
 }
 
-void SystemZ_init_mri(MCRegisterInfo *MRI)
+const MCRegisterInfo *SystemZ_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(
-		MRI, SystemZRegDesc, AARCH64_REG_ENDING, 0, 0,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(SystemZRegDesc, AARCH64_REG_ENDING, 0, 0,
 		SystemZMCRegisterClasses, ARR_SIZE(SystemZMCRegisterClasses), 0,
 		0, SystemZRegDiffLists, 0, SystemZSubRegIdxLists,
 		ARR_SIZE(SystemZSubRegIdxLists), 0);
+
+	return &mri;
 }
 
 const char *SystemZ_reg_name(csh handle, unsigned int reg)
@@ -70,7 +71,7 @@ const char *SystemZ_reg_name(csh handle, unsigned int reg)
 void SystemZ_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info)
 {
 	MI->MRI = (MCRegisterInfo *)info;
-	MI->fillDetailOps = detail_is_set(MI);
+	MI->fillDetailOps = detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS);
 	SystemZ_LLVM_printInstruction(MI, "", O);
 #ifndef CAPSTONE_DIET
 	map_set_alias_id(MI, O, insn_alias_mnem_map,
@@ -82,7 +83,8 @@ void SystemZ_init_cs_detail(MCInst *MI) {
 	if (!detail_is_set(MI)) {
 		return;
 	}
-	memset(get_detail(MI), 0, sizeof(cs_detail));
+	memset(get_detail(MI), 0,
+	       offsetof(cs_detail, systemz) + sizeof(cs_systemz));
 	if (detail_is_set(MI)) {
 		SystemZ_get_detail(MI)->cc = SYSTEMZ_CC_INVALID;
 	}
@@ -100,8 +102,18 @@ bool SystemZ_getInstruction(csh handle, const uint8_t *bytes, size_t bytes_len,
 	return result != MCDisassembler_Fail;
 }
 
+uint16_t SystemZ_getInsnSize(cs_struct *handle, const uint8_t *bytes,
+			     size_t bytes_len)
+{
+	if (bytes_len < 2)
+		return 0;
+	// The top 2 bits of the first byte specify the size.
+	uint16_t size = bytes[0] < 0x40 ? 2 : (bytes[0] < 0xc0 ? 4 : 6);
+	return bytes_len < size ? 0 : size;
+}
+
 // given internal insn id, return public instruction info
-void SystemZ_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void SystemZ_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// We do this after Instruction disassembly.
 }
@@ -159,7 +171,8 @@ void SystemZ_add_cs_detail(MCInst *MI, int /* aarch64_op_group */ op_group,
 			   va_list args)
 {
 #ifndef CAPSTONE_DIET
-	if (!detail_is_set(MI) || !map_fill_detail_ops(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS) ||
+	    !map_fill_detail_ops(MI))
 		return;
 
 	unsigned op_num = va_arg(args, unsigned);
@@ -302,7 +315,7 @@ void SystemZ_add_cs_detail(MCInst *MI, int /* aarch64_op_group */ op_group,
 
 void SystemZ_set_detail_op_imm(MCInst *MI, unsigned op_num, int64_t Imm, size_t width)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	CS_ASSERT((map_get_op_type(MI, op_num) & ~CS_OP_MEM) == CS_OP_IMM);
 
@@ -315,7 +328,7 @@ void SystemZ_set_detail_op_imm(MCInst *MI, unsigned op_num, int64_t Imm, size_t
 
 void SystemZ_set_detail_op_reg(MCInst *MI, unsigned op_num, systemz_reg Reg)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	CS_ASSERT((map_get_op_type(MI, op_num) & ~CS_OP_MEM) == CS_OP_REG);
 
@@ -327,7 +340,7 @@ void SystemZ_set_detail_op_reg(MCInst *MI, unsigned op_num, systemz_reg Reg)
 
 void SystemZ_set_detail_op_mem(MCInst *MI, unsigned op_num, systemz_reg base, int64_t disp, uint64_t length, systemz_reg index, systemz_addr_mode am)
 {
-	if (!detail_is_set(MI))
+	if (!detail_part_is_set(MI, CS_OPT_DETAIL_OPERANDS))
 		return;
 	SystemZ_get_detail_op(MI, 0)->type = SYSTEMZ_OP_MEM;
 	SystemZ_get_detail_op(MI, 0)->access = map_get_op_access(MI, op_num);
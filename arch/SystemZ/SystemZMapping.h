@@ -16,7 +16,7 @@ typedef enum {
 const char *SystemZ_reg_name(csh handle, unsigned int reg);
 
 // given internal insn id, return public instruction info
-void SystemZ_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void SystemZ_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *SystemZ_insn_name(csh handle, unsigned int id);
 
@@ -26,7 +26,9 @@ void SystemZ_printer(MCInst *MI, SStream *O, void * /* MCRegisterInfo* */ info);
 bool SystemZ_getInstruction(csh handle, const uint8_t *bytes, size_t bytes_len,
 			MCInst *MI, uint16_t *size, uint64_t address,
 			void *info);
-void SystemZ_init_mri(MCRegisterInfo *MRI);
+uint16_t SystemZ_getInsnSize(cs_struct *handle, const uint8_t *bytes,
+			     size_t bytes_len);
+const MCRegisterInfo *SystemZ_get_mri(void);
 void SystemZ_init_cs_detail(MCInst *MI);
 
 void SystemZ_set_detail_op_reg(MCInst *MI, unsigned op_num, systemz_reg Reg);
@@ -7,18 +7,21 @@
 #include "../../MCRegisterInfo.h"
 #include "SystemZMapping.h"
 #include "SystemZModule.h"
+#include "SystemZDisassemblerExtension.h"
+#include "SystemZMCTargetDesc.h"
 
 cs_err SystemZ_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
+	const MCRegisterInfo *mri = SystemZ_get_mri();
 
-	SystemZ_init_mri(mri);
 	ud->printer = SystemZ_printer;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = SystemZ_getInstruction;
+	ud->feature_bits_of = SystemZ_getFeatureBits;
+	ud->num_features = SystemZ_NumSubtargetFeatures;
 	ud->post_printer = NULL;
+	ud->insn_size = SystemZ_getInsnSize;
 
 	ud->reg_name = SystemZ_reg_name;
 	ud->insn_id = SystemZ_get_insn_id;
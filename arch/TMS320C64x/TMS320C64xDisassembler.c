@@ -613,9 +613,9 @@ bool TMS320C64x_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 	return false;
 }
 
-void TMS320C64x_init(MCRegisterInfo *MRI)
+const MCRegisterInfo *TMS320C64x_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(MRI, TMS320C64xRegDesc, 90,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(TMS320C64xRegDesc, 90,
 			0, 0,
 			TMS320C64xMCRegisterClasses, 7,
 			0, 0,
@@ -623,6 +623,8 @@ void TMS320C64x_init(MCRegisterInfo *MRI)
 			0,
 			TMS320C64xSubRegIdxLists, 1,
 			0);
+
+	return &mri;
 }
 
 #endif
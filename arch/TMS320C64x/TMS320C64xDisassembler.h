@@ -10,7 +10,7 @@
 #include "../../MCRegisterInfo.h"
 #include "../../MCInst.h"
 
-void TMS320C64x_init(MCRegisterInfo *MRI);
+const MCRegisterInfo *TMS320C64x_get_mri(void);
 
 bool TMS320C64x_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		MCInst *instr, uint16_t *size, uint64_t address, void *info);
@@ -31,7 +31,7 @@ void TMS320C64x_post_printer(csh ud, cs_insn *insn, SStream *insn_asm, MCInst *m
 	int i;
 	cs_tms320c64x *tms320c64x;
 
-	if (mci->csh->detail_opt) {
+	if (mci->detail_opt) {
 		tms320c64x = &mci->flat_insn->detail->tms320c64x;
 
 		for (i = 0; i < insn->detail->groups_count; i++) {
@@ -143,7 +143,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 			SStream_concat0(O, getRegisterName(reg));
 		}
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_opt) {
 			MI->flat_insn->detail->tms320c64x.operands[MI->flat_insn->detail->tms320c64x.op_count].type = TMS320C64X_OP_REG;
 			MI->flat_insn->detail->tms320c64x.operands[MI->flat_insn->detail->tms320c64x.op_count].reg = reg;
 			MI->flat_insn->detail->tms320c64x.op_count++;
@@ -163,7 +163,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 				SStream_concat(O, "-%"PRIu64, -Imm);
 		}
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_opt) {
 			MI->flat_insn->detail->tms320c64x.operands[MI->flat_insn->detail->tms320c64x.op_count].type = TMS320C64X_OP_IMM;
 			MI->flat_insn->detail->tms320c64x.operands[MI->flat_insn->detail->tms320c64x.op_count].imm = Imm;
 			MI->flat_insn->detail->tms320c64x.op_count++;
@@ -232,7 +232,7 @@ static void printMemOperand(MCInst *MI, unsigned OpNo, SStream *O)
 			break;
 	}
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_opt) {
 		tms320c64x = &MI->flat_insn->detail->tms320c64x;
 
 		tms320c64x->operands[tms320c64x->op_count].type = TMS320C64X_OP_MEM;
@@ -318,7 +318,7 @@ static void printMemOperand2(MCInst *MI, unsigned OpNo, SStream *O)
 	offset = (Val >> 7) & 0x7fff;
 	SStream_concat(O, "*+%s[0x%x]", getRegisterName(basereg), offset);
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_opt) {
 		tms320c64x = &MI->flat_insn->detail->tms320c64x;
 
 		tms320c64x->operands[tms320c64x->op_count].type = TMS320C64X_OP_MEM;
@@ -340,7 +340,7 @@ static void printRegPair(MCInst *MI, unsigned OpNo, SStream *O)
 
 	SStream_concat(O, "%s:%s", getRegisterName(reg + 1), getRegisterName(reg));
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_opt) {
 		tms320c64x = &MI->flat_insn->detail->tms320c64x;
 
 		tms320c64x->operands[tms320c64x->op_count].type = TMS320C64X_OP_REGPAIR;
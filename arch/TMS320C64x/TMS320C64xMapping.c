@@ -1690,15 +1690,20 @@ static const insn_map insns[] = {
 	},
 };
 
-void TMS320C64x_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+// id-to-index map of insns
+static const unsigned short insns_idx[] = {
+#include "TMS320C64xMappingInsnIdx.inc"
+};
+
+void TMS320C64x_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	unsigned short i;
 
-	i = insn_find(insns, ARR_SIZE(insns), id, &h->insn_cache);
+	i = insn_find(insns_idx, ARR_SIZE(insns_idx), id);
 	if (i != 0) {
 		insn->id = insns[i].mapid;
 
-		if (h->detail_opt) {
+		if (MI->detail_opt) {
 #ifndef CAPSTONE_DIET
 			memcpy(insn->detail->regs_read, insns[i].regs_use, sizeof(insns[i].regs_use));
 			insn->detail->regs_read_count = (uint8_t)count_positive(insns[i].regs_use);
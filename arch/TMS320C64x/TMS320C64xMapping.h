@@ -10,7 +10,7 @@
 const char *TMS320C64x_reg_name(csh handle, unsigned int reg);
 
 // given internal insn id, return public instruction info
-void TMS320C64x_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void TMS320C64x_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *TMS320C64x_insn_name(csh handle, unsigned int id);
 
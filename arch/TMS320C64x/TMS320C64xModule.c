@@ -12,14 +12,11 @@
 
 cs_err TMS320C64x_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
+	const MCRegisterInfo *mri = TMS320C64x_get_mri();
 
-	mri = cs_mem_malloc(sizeof(*mri));
-
-	TMS320C64x_init(mri);
 	ud->printer = TMS320C64x_printInst;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = TMS320C64x_getInstruction;
 	ud->post_printer = TMS320C64x_post_printer;
 
@@ -1580,7 +1580,8 @@ static bool getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 	struct cs_struct *cs = (struct cs_struct *)ud;
 	if (MI->flat_insn->detail) {
-		memset(MI->flat_insn->detail, 0, sizeof(cs_detail));
+		memset(MI->flat_insn->detail, 0,
+		       offsetof(cs_detail, tricore) + sizeof(cs_tricore));
 	}
 
 	switch (cs->mode) {
@@ -1631,7 +1632,7 @@ bool TriCore_LLVM_getInstruction(csh handle, const uint8_t *Bytes,
 	return Result;
 }
 
-void TriCore_init_mri(MCRegisterInfo *MRI)
+const MCRegisterInfo *TriCore_get_mri(void)
 {
 	/*
 	InitMCRegisterInfo(TriCoreRegDesc, 45, RA, PC,
@@ -1646,10 +1647,11 @@ void TriCore_init_mri(MCRegisterInfo *MRI)
 			TriCoreRegEncodingTable);
 	*/
 
-	MCRegisterInfo_InitMCRegisterInfo(
-		MRI, TriCoreRegDesc, ARR_SIZE(TriCoreRegDesc), 0, 0,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(TriCoreRegDesc, ARR_SIZE(TriCoreRegDesc), 0, 0,
 		TriCoreMCRegisterClasses, ARR_SIZE(TriCoreMCRegisterClasses), 0,
 		0, TriCoreRegDiffLists, 0, TriCoreSubRegIdxLists, 1, 0);
+
+	return &mri;
 }
 
 #endif
@@ -12,7 +12,7 @@
 #include "../../MCRegisterInfo.h"
 #include "../../MCInst.h"
 
-void TriCore_init_mri(MCRegisterInfo *MRI);
+const MCRegisterInfo *TriCore_get_mri(void);
 bool TriCore_getFeatureBits(unsigned int mode, unsigned int feature);
 
 #endif
@@ -19,22 +19,10 @@
 #include "TriCoreGenInstrInfo.inc"
 
 static const insn_map insns[] = {
-	// dummy item
-	{ 0,
-	  0,
-#ifndef CAPSTONE_DIET
-	  { 0 },
-	  { 0 },
-	  { 0 },
-	  0,
-	  0
-#endif
-	},
-
 #include "TriCoreGenCSMappingInsn.inc"
 };
 
-void TriCore_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void TriCore_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// Not used. Information is set after disassembly.
 }
@@ -132,7 +120,7 @@ static const map_insn_ops insn_operands[] = {
 void TriCore_set_access(MCInst *MI)
 {
 #ifndef CAPSTONE_DIET
-	if (!(MI->csh->detail_opt == CS_OPT_ON && MI->flat_insn->detail))
+	if (!(MI->detail_opt == CS_OPT_ON && MI->flat_insn->detail))
 		return;
 
 	CS_ASSERT_RET(MI->Opcode < ARR_SIZE(insn_operands));
@@ -216,6 +204,16 @@ bool TriCore_getInstruction(csh handle, const uint8_t *Bytes, size_t ByteLen,
 					   Address, Info);
 }
 
+uint16_t TriCore_getInsnSize(cs_struct *handle, const uint8_t *Bytes,
+			     size_t ByteLen)
+{
+	if (ByteLen < 2)
+		return 0;
+	// Bit 0 of the opcode is set for 32-bit instructions.
+	uint16_t size = (Bytes[0] & 1) ? 4 : 2;
+	return ByteLen < size ? 0 : size;
+}
+
 void TriCore_printInst(MCInst *MI, SStream *O, void *Info)
 {
 	TriCore_LLVM_printInst(MI, MI->address, O);
@@ -7,7 +7,7 @@
 #include <capstone/capstone.h>
 
 // given internal insn id, return public instruction info
-void TriCore_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void TriCore_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 const char *TriCore_insn_name(csh handle, unsigned int id);
 
@@ -25,6 +25,9 @@ bool TriCore_getInstruction(csh handle, const uint8_t *Bytes, size_t ByteLen,
 			    MCInst *MI, uint16_t *Size, uint64_t Address,
 			    void *Info);
 
+uint16_t TriCore_getInsnSize(cs_struct *handle, const uint8_t *Bytes,
+			     size_t ByteLen);
+
 void TriCore_printInst(MCInst *MI, SStream *O, void *Info);
 
 const char *TriCore_getRegisterName(csh handle, unsigned int RegNo);
@@ -8,18 +8,21 @@
 #include "TriCoreModule.h"
 #include "TriCoreDisassembler.h"
 
+#define GET_SUBTARGETINFO_ENUM
+#include "TriCoreGenSubtargetInfo.inc"
+
 cs_err TRICORE_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-
-	mri = cs_mem_malloc(sizeof(*mri));
+	const MCRegisterInfo *mri = TriCore_get_mri();
 
-	TriCore_init_mri(mri);
 	ud->printer = TriCore_printInst;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = TriCore_getInstruction;
+	ud->feature_bits_of = TriCore_getFeatureBits;
+	ud->num_features = TRICORE_NumSubtargetFeatures;
 	ud->post_printer = NULL;
+	ud->insn_size = TriCore_getInsnSize;
 
 	ud->reg_name = TriCore_getRegisterName;
 	ud->insn_id = TriCore_get_insn_id;
@@ -647,7 +647,7 @@ bool WASM_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 
 	if (MI->flat_insn->detail) {
 		memset(MI->flat_insn->detail, 0, offsetof(cs_detail, wasm)+sizeof(cs_wasm));
-		WASM_get_insn_id((cs_struct *)ud, MI->flat_insn, opcode);
+		WASM_get_insn_id(MI, MI->flat_insn, opcode);
 	}
 
 	// setup groups
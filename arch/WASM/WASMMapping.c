@@ -12,7 +12,7 @@
 #include "WASMMapping.h"
 
 // fill in details
-void WASM_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void WASM_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	insn->id = id;
 }
@@ -62,7 +62,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O);
 
 static void set_mem_access(MCInst *MI, bool status)
 {
-	if (MI->csh->detail_opt != CS_OPT_ON)
+	if (!(MI->detail_parts & CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	MI->csh->doing_mem = status;
@@ -313,7 +313,7 @@ static void printSrcIdx(MCInst *MI, unsigned Op, SStream *O)
 	MCOperand *SegReg;
 	int reg;
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_MEM;
@@ -335,7 +335,7 @@ static void printSrcIdx(MCInst *MI, unsigned Op, SStream *O)
 		_printOperand(MI, Op + 1, O);
 		SStream_concat0(O, ":");
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_register_map(reg);
 		}
 	}
@@ -351,7 +351,7 @@ static void printSrcIdx(MCInst *MI, unsigned Op, SStream *O)
 
 static void printDstIdx(MCInst *MI, unsigned Op, SStream *O)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_MEM;
@@ -369,7 +369,7 @@ static void printDstIdx(MCInst *MI, unsigned Op, SStream *O)
 	// DI accesses are always ES-based on non-64bit mode
 	if (MI->csh->mode != CS_MODE_64) {
 		SStream_concat0(O, "%es:(");
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_REG_ES;
 		}
 	} else
@@ -437,7 +437,7 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 	MCOperand *SegReg = MCInst_getOperand(MI, Op+1);
 	int reg;
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_MEM;
@@ -458,14 +458,14 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 		_printOperand(MI, Op + 1, O);
 		SStream_concat0(O, ":");
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_register_map(reg);
 		}
 	}
 
 	if (MCOperand_isImm(DispSpec)) {
 		int64_t imm = MCOperand_getImm(DispSpec);
-		if (MI->csh->detail_opt)
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.disp = imm;
 		if (imm < 0) {
 			SStream_concat(O, "0x%"PRIx64, arch_masks[MI->csh->mode] & imm);
@@ -477,7 +477,7 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 		}
 	}
 
-	if (MI->csh->detail_opt)
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 		MI->flat_insn->detail->x86.op_count++;
 }
 
@@ -490,7 +490,7 @@ static void printU8Imm(MCInst *MI, unsigned Op, SStream *O)
 	else
 		SStream_concat(O, "$%u", val);
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_IMM;
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].imm = val;
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].size = 1;
@@ -545,7 +545,7 @@ static void printPCRelImm(MCInst *MI, unsigned OpNo, SStream *O)
 			else
 				SStream_concat(O, "%"PRIu64, imm);
 		}
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_IMM;
 			MI->has_imm = true;
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].imm = imm;
@@ -560,7 +560,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 	if (MCOperand_isReg(Op)) {
 		unsigned int reg = MCOperand_getReg(Op);
 		printRegName(O, reg);
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			if (MI->csh->doing_mem) {
 				MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.base = X86_register_map(reg);
 			} else {
@@ -680,7 +680,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 				break;
 		}
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			if (MI->csh->doing_mem) {
 				MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_MEM;
 				MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.disp = imm;
@@ -713,7 +713,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 	int segreg;
 	int64_t DispVal = 1;
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_MEM;
@@ -736,14 +736,14 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 		_printOperand(MI, Op + X86_AddrSegmentReg, O);
 		SStream_concat0(O, ":");
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_register_map(segreg);
 		}
 	}
 
 	if (MCOperand_isImm(DispSpec)) {
 		DispVal = MCOperand_getImm(DispSpec);
-		if (MI->csh->detail_opt)
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.disp = DispVal;
 		if (DispVal) {
 			if (MCOperand_getReg(IndexReg) || MCOperand_getReg(BaseReg)) {
@@ -772,7 +772,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 			SStream_concat0(O, ", ");
 			_printOperand(MI, Op + X86_AddrIndexReg, O);
 			ScaleVal = MCOperand_getImm(MCInst_getOperand(MI, Op + X86_AddrScaleAmt));
-			if (MI->csh->detail_opt)
+			if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 				MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.scale = (int)ScaleVal;
 			if (ScaleVal != 1) {
 				SStream_concat(O, ", %u", ScaleVal);
@@ -785,7 +785,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 			SStream_concat0(O, "0");
 	}
 
-	if (MI->csh->detail_opt)
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 		MI->flat_insn->detail->x86.op_count++;
 }
 
@@ -878,7 +878,7 @@ void X86_ATT_printInst(MCInst *MI, SStream *OS, void *info)
 			MI->flat_insn->detail->x86.operands[0].size = MI->imm_size;
 	}
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE] = {0};
 
 		// some instructions need to supply immediate 1 in the first op
@@ -994,6 +994,11 @@ void X86_ATT_printInst(MCInst *MI, SStream *OS, void *info)
 		get_op_access(MI->csh, MCInst_getOpcode(MI), access, &MI->flat_insn->detail->x86.eflags);
 		MI->flat_insn->detail->x86.operands[0].access = access[0];
 		MI->flat_insn->detail->x86.operands[1].access = access[1];
+#endif
+	} else if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
+#ifndef CAPSTONE_DIET
+		// eflags come with the operand access otherwise
+		X86_get_op_access(MI->csh, MCInst_getOpcode(MI), &MI->flat_insn->detail->x86.eflags);
 #endif
 	}
 }
@@ -909,7 +909,7 @@ static void update_pub_insn(cs_insn *pub, InternalInstruction *inter)
 		pub->detail->x86.encoding.imm_size = inter->immediateSize;
 }
 
-void X86_init(MCRegisterInfo *MRI)
+const MCRegisterInfo *X86_get_mri(void)
 {
 	// InitMCRegisterInfo(), X86GenRegisterInfo.inc
 	// RI->InitMCRegisterInfo(X86RegDesc, 277,
@@ -928,15 +928,43 @@ void X86_init(MCRegisterInfo *MRI)
 	   X86SubRegIdxRanges, X86RegEncodingTable);
 	*/
 
-	MCRegisterInfo_InitMCRegisterInfo(MRI, X86RegDesc, 277,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(X86RegDesc, 277,
 			0, 0,
 			X86MCRegisterClasses, 86,
 			0, 0, X86RegDiffLists, 0,
 			X86SubRegIdxLists, 9,
 			0);
+
+	return &mri;
 }
 
 // Public interface for the disassembler
+static DisassemblerMode decoder_mode(cs_mode mode)
+{
+	if (mode & CS_MODE_16)
+		return MODE_16BIT;
+	if (mode & CS_MODE_32)
+		return MODE_32BIT;
+	return MODE_64BIT;
+}
+
+// only walk prefixes, opcode, ModRM/SIB, displacement & immediates
+// of the instruction. No MCInst is built.
+uint16_t X86_getInsnSize(cs_struct *handle, const uint8_t *code, size_t code_len)
+{
+	InternalInstruction insn = { 0 };
+	struct reader_info info;
+
+	info.code = code;
+	info.size = code_len;
+	info.offset = 0;
+
+	if (decodeInstruction(&insn, reader, &info, 0, decoder_mode(handle->mode)))
+		return 0;
+
+	return (uint16_t)insn.length;
+}
+
 bool X86_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		MCInst *instr, uint16_t *size, uint64_t address, void *_info)
 {
@@ -968,21 +996,8 @@ bool X86_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 		//memset(instr->flat_insn->detail, 0, offsetof(cs_detail, x86)+offsetof(cs_x86, operands));
 	}
 
-	if (handle->mode & CS_MODE_16)
-		ret = decodeInstruction(&insn,
-				reader, &info,
-				address,
-				MODE_16BIT);
-	else if (handle->mode & CS_MODE_32)
-		ret = decodeInstruction(&insn,
-				reader, &info,
-				address,
-				MODE_32BIT);
-	else
-		ret = decodeInstruction(&insn,
-				reader, &info,
-				address,
-				MODE_64BIT);
+	ret = decodeInstruction(&insn, reader, &info, address,
+			decoder_mode(handle->mode));
 
 	if (ret) {
 		// *size = (uint16_t)(insn.readerCursor - address);
@@ -1002,7 +1017,7 @@ bool X86_getInstruction(csh ud, const uint8_t *code, size_t code_len,
 			instr->x86_prefix[3] = insn.prefix3;
 			instr->xAcquireRelease = insn.xAcquireRelease;
 
-			if (handle->detail_opt) {
+			if (instr->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
 				update_pub_insn(instr->flat_insn, &insn);
 			}
 
@@ -23,6 +23,8 @@
 bool X86_getInstruction(csh handle, const uint8_t *code, size_t code_len,
 		MCInst *instr, uint16_t *size, uint64_t address, void *info);
 
-void X86_init(MCRegisterInfo *MRI);
+uint16_t X86_getInsnSize(cs_struct *handle, const uint8_t *code, size_t code_len);
+
+const MCRegisterInfo *X86_get_mri(void);
 
 #endif
@@ -270,7 +270,8 @@ static const struct InstructionSpecifier *specifierForUID(InstrUID uid)
 
 /*
  * consumeByte - Uses the reader function provided by the user to consume one
- *   byte from the instruction's memory and advance the cursor.
+ *   byte from the instruction's memory and advance the cursor.  The bytes
+ *   below directEnd are read from the buffer directly.
  *
  * @param insn  - The instruction with the reader function to use.  The cursor
  *                for this instruction is advanced.
@@ -280,8 +281,16 @@ static const struct InstructionSpecifier *specifierForUID(InstrUID uid)
  */
 static int consumeByte(struct InternalInstruction* insn, uint8_t* byte)
 {
-	int ret = insn->reader(insn->readerArg, byte, insn->readerCursor);
+	int ret;
 
+	if (insn->readerCursor < insn->directEnd) {
+		*byte = insn->directBytes[insn->readerCursor -
+					  insn->startLocation];
+		++(insn->readerCursor);
+		return 0;
+	}
+
+	ret = insn->reader(insn->readerArg, byte, insn->readerCursor);
 	if (!ret)
 		++(insn->readerCursor);
 
@@ -297,6 +306,12 @@ static int consumeByte(struct InternalInstruction* insn, uint8_t* byte)
  */
 static int lookAtByte(struct InternalInstruction* insn, uint8_t* byte)
 {
+	if (insn->readerCursor < insn->directEnd) {
+		*byte = insn->directBytes[insn->readerCursor -
+					  insn->startLocation];
+		return 0;
+	}
+
 	return insn->reader(insn->readerArg, byte, insn->readerCursor);
 }
 
@@ -309,6 +324,17 @@ static void unconsumeByte(struct InternalInstruction* insn)
   static int name(struct InternalInstruction* insn, type* ptr) {  \
     type combined = 0;                                            \
     unsigned offset;                                              \
+    if (insn->readerCursor + sizeof(type) <= insn->directEnd) {   \
+      const uint8_t *bytes = insn->directBytes +                  \
+                             (insn->readerCursor -                \
+                              insn->startLocation);               \
+      for (offset = 0; offset < sizeof(type); ++offset)           \
+        combined = combined |                                     \
+                   ((uint64_t)bytes[offset] << (offset * 8));     \
+      *ptr = combined;                                            \
+      insn->readerCursor += sizeof(type);                         \
+      return 0;                                                   \
+    }                                                             \
     for (offset = 0; offset < sizeof(type); ++offset) {           \
       uint8_t byte;                                               \
       int ret = insn->reader(insn->readerArg,                     \
@@ -348,6 +374,80 @@ static bool isREX(struct InternalInstruction *insn, uint8_t prefix)
 	return false;
 }
 
+/*
+ * The class of each byte at the start of an instruction.  The legacy prefixes
+ * come first and the segment overrides are in the order of SegmentOverride.
+ */
+enum {
+	PFX_NONE = 0,
+	PFX_LOCK_REP,	// LOCK, REPNE/REPNZ, REP or REPE/REPZ
+	PFX_SEG_CS,	// CS segment override -OR- Branch not taken
+	PFX_SEG_SS,	// SS segment override -OR- Branch taken
+	PFX_SEG_DS,
+	PFX_SEG_ES,
+	PFX_SEG_FS,
+	PFX_SEG_GS,
+	PFX_OPSIZE,	// Operand-size override
+	PFX_ADSIZE,	// Address-size override
+	PFX_REX,	// only in 64-bit mode
+	PFX_EVEX,
+	PFX_VEX_3B,
+	PFX_VEX_2B,
+	PFX_XOP,	// -OR- POP
+};
+
+#define isLegacyPrefix(class) ((class) != PFX_NONE && (class) <= PFX_ADSIZE)
+
+#define NO PFX_NONE
+#define LR PFX_LOCK_REP
+#define Sc PFX_SEG_CS
+#define Ss PFX_SEG_SS
+#define Sd PFX_SEG_DS
+#define Se PFX_SEG_ES
+#define Sf PFX_SEG_FS
+#define Sg PFX_SEG_GS
+#define Op PFX_OPSIZE
+#define Ad PFX_ADSIZE
+#define RX PFX_REX
+#define EV PFX_EVEX
+#define V3 PFX_VEX_3B
+#define V2 PFX_VEX_2B
+#define XO PFX_XOP
+static const uint8_t prefixClass[256] = {
+	//0   1   2   3   4   5   6   7   8   9   a   b   c   d   e   f
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // 00
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // 10
+	NO, NO, NO, NO, NO, NO, Se, NO, NO, NO, NO, NO, NO, NO, Sc, NO, // 20
+	NO, NO, NO, NO, NO, NO, Ss, NO, NO, NO, NO, NO, NO, NO, Sd, NO, // 30
+	RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, // 40
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // 50
+	NO, NO, EV, NO, Sf, Sg, Op, Ad, NO, NO, NO, NO, NO, NO, NO, NO, // 60
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // 70
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, XO, // 80
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // 90
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // a0
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // b0
+	NO, NO, NO, NO, V3, V2, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // c0
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // d0
+	NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // e0
+	LR, NO, LR, LR, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, // f0
+};
+#undef NO
+#undef LR
+#undef Sc
+#undef Ss
+#undef Sd
+#undef Se
+#undef Sf
+#undef Sg
+#undef Op
+#undef Ad
+#undef RX
+#undef EV
+#undef V3
+#undef V2
+#undef XO
+
 /*
  * setPrefixPresent - Marks that a particular prefix is present as mandatory
  *
@@ -403,54 +503,46 @@ static void setPrefixPresent(struct InternalInstruction *insn, uint8_t prefix)
  */
 static int readPrefixes(struct InternalInstruction* insn)
 {
-	bool isPrefix = true;
 	uint8_t byte = 0;
 	uint8_t nextByte;
+	uint8_t byteClass;
+
+	while (true) {
+		/* If we fail reading prefixes, just stop here and let the opcode reader deal with it */
+		if (consumeByte(insn, &byte))
+			return -1;
+
+		// most instructions have no prefix
+		byteClass = prefixClass[byte];
+		if (byteClass == PFX_NONE)
+			break;
+
+		if (byteClass == PFX_REX) {
+			if (insn->mode != MODE_64BIT) {
+				byteClass = PFX_NONE;
+				break;
+			}
 
-	while (isPrefix) {
-		if (insn->mode == MODE_64BIT) {
 			// eliminate consecutive redundant REX bytes in front
-			if (consumeByte(insn, &byte))
+			if (lookAtByte(insn, &nextByte))	// out of input code
 				return -1;
+			while (prefixClass[nextByte] == PFX_REX) {
+				// another REX prefix, but we only remember the last one
+				consumeByte(insn, &byte);
+				if (lookAtByte(insn, &nextByte))
+					return -1;
+			}
 
-			if ((byte & 0xf0) == 0x40) {
-				while(true) {
-					if (lookAtByte(insn, &byte))	// out of input code
-						return -1;
-					if ((byte & 0xf0) == 0x40) {
-						// another REX prefix, but we only remember the last one
-						if (consumeByte(insn, &byte))
-							return -1;
-					} else
-						break;
-				}
+			// keep the last REX byte if next byte is not a legacy prefix
+			if (!isLegacyPrefix(prefixClass[nextByte]))
+				break;
 
-				// recover the last REX byte if next byte is not a legacy prefix
-				switch (byte) {
-					case 0xf2:  /* REPNE/REPNZ */
-					case 0xf3:  /* REP or REPE/REPZ */
-					case 0xf0:  /* LOCK */
-					case 0x2e:  /* CS segment override -OR- Branch not taken */
-					case 0x36:  /* SS segment override -OR- Branch taken */
-					case 0x3e:  /* DS segment override */
-					case 0x26:  /* ES segment override */
-					case 0x64:  /* FS segment override */
-					case 0x65:  /* GS segment override */
-					case 0x66:  /* Operand-size override */
-					case 0x67:  /* Address-size override */
-						break;
-					default:    /* Not a prefix byte */
-						unconsumeByte(insn);
-						break;
-				}
-			} else {
-				unconsumeByte(insn);
-			}
+			consumeByte(insn, &byte);
+			byteClass = prefixClass[byte];
 		}
 
-		/* If we fail reading prefixes, just stop here and let the opcode reader deal with it */
-		if (consumeByte(insn, &byte))
-			return -1;
+		if (!isLegacyPrefix(byteClass))
+			break;
 
 		if (insn->readerCursor - 1 == insn->startLocation
 				&& (byte == 0xf2 || byte == 0xf3)) {
@@ -496,229 +588,207 @@ static int readPrefixes(struct InternalInstruction* insn)
 			}
 		}
 
-		switch (byte) {
-			case 0xf0:  /* LOCK */
-			case 0xf2:  /* REPNE/REPNZ */
-			case 0xf3:  /* REP or REPE/REPZ */
+		switch (byteClass) {
+			case PFX_LOCK_REP:
 				// only accept the last prefix
 				setPrefixPresent(insn, byte);
 				insn->prefix0 = byte;
 				break;
 
-			case 0x2e:  /* CS segment override -OR- Branch not taken */
-			case 0x36:  /* SS segment override -OR- Branch taken */
-			case 0x3e:  /* DS segment override */
-			case 0x26:  /* ES segment override */
-			case 0x64:  /* FS segment override */
-			case 0x65:  /* GS segment override */
-				switch (byte) {
-					case 0x2e:
-						insn->segmentOverride = SEG_OVERRIDE_CS;
-						insn->prefix1 = byte;
-						break;
-					case 0x36:
-						insn->segmentOverride = SEG_OVERRIDE_SS;
-						insn->prefix1 = byte;
-						break;
-					case 0x3e:
-						insn->segmentOverride = SEG_OVERRIDE_DS;
-						insn->prefix1 = byte;
-						break;
-					case 0x26:
-						insn->segmentOverride = SEG_OVERRIDE_ES;
-						insn->prefix1 = byte;
-						break;
-					case 0x64:
-						insn->segmentOverride = SEG_OVERRIDE_FS;
-						insn->prefix1 = byte;
-						break;
-					case 0x65:
-						insn->segmentOverride = SEG_OVERRIDE_GS;
-						insn->prefix1 = byte;
-						break;
-					default:
-						// debug("Unhandled override");
-						return -1;
-				}
-				setPrefixPresent(insn, byte);
-				break;
-
-			case 0x66:  /* Operand-size override */
+			case PFX_OPSIZE:
 				insn->hasOpSize = true;
 				setPrefixPresent(insn, byte);
 				insn->prefix2 = byte;
 				break;
 
-			case 0x67:  /* Address-size override */
+			case PFX_ADSIZE:
 				insn->hasAdSize = true;
 				setPrefixPresent(insn, byte);
 				insn->prefix3 = byte;
 				break;
-			default:    /* Not a prefix byte */
-				isPrefix = false;
+
+			default:    /* Segment override */
+				insn->segmentOverride = (SegmentOverride)
+					(SEG_OVERRIDE_CS + byteClass - PFX_SEG_CS);
+				insn->prefix1 = byte;
 				break;
 		}
 	}
 
 	insn->vectorExtensionType = TYPE_NO_VEX_XOP;
 
-	if (byte == 0x62) {
-		uint8_t byte1, byte2;
+	switch (byteClass) {
+		case PFX_EVEX: {
+			uint8_t byte1, byte2;
 
-		if (consumeByte(insn, &byte1)) {
-			// dbgprintf(insn, "Couldn't read second byte of EVEX prefix");
-			return -1;
-		}
+			if (consumeByte(insn, &byte1)) {
+				// dbgprintf(insn, "Couldn't read second byte of EVEX prefix");
+				return -1;
+			}
 
-		if (lookAtByte(insn, &byte2)) {
-			// dbgprintf(insn, "Couldn't read third byte of EVEX prefix");
-			unconsumeByte(insn); /* unconsume byte1 */
-			unconsumeByte(insn); /* unconsume byte  */
-		} else {
-			if ((insn->mode == MODE_64BIT || (byte1 & 0xc0) == 0xc0) &&
-					((~byte1 & 0xc) == 0xc) && ((byte2 & 0x4) == 0x4)) {
-				insn->vectorExtensionType = TYPE_EVEX;
-			} else {
+			if (lookAtByte(insn, &byte2)) {
+				// dbgprintf(insn, "Couldn't read third byte of EVEX prefix");
 				unconsumeByte(insn); /* unconsume byte1 */
 				unconsumeByte(insn); /* unconsume byte  */
+			} else {
+				if ((insn->mode == MODE_64BIT || (byte1 & 0xc0) == 0xc0) &&
+						((~byte1 & 0xc) == 0xc) && ((byte2 & 0x4) == 0x4)) {
+					insn->vectorExtensionType = TYPE_EVEX;
+				} else {
+					unconsumeByte(insn); /* unconsume byte1 */
+					unconsumeByte(insn); /* unconsume byte  */
+				}
 			}
-		}
 
-		if (insn->vectorExtensionType == TYPE_EVEX) {
-			insn->vectorExtensionPrefix[0] = byte;
-			insn->vectorExtensionPrefix[1] = byte1;
-			if (consumeByte(insn, &insn->vectorExtensionPrefix[2])) {
-				// dbgprintf(insn, "Couldn't read third byte of EVEX prefix");
-				return -1;
-			}
+			if (insn->vectorExtensionType == TYPE_EVEX) {
+				insn->vectorExtensionPrefix[0] = byte;
+				insn->vectorExtensionPrefix[1] = byte1;
+				if (consumeByte(insn, &insn->vectorExtensionPrefix[2])) {
+					// dbgprintf(insn, "Couldn't read third byte of EVEX prefix");
+					return -1;
+				}
 
-			if (consumeByte(insn, &insn->vectorExtensionPrefix[3])) {
-				// dbgprintf(insn, "Couldn't read fourth byte of EVEX prefix");
-				return -1;
+				if (consumeByte(insn, &insn->vectorExtensionPrefix[3])) {
+					// dbgprintf(insn, "Couldn't read fourth byte of EVEX prefix");
+					return -1;
+				}
+
+				/* We simulate the REX prefix for simplicity's sake */
+				if (insn->mode == MODE_64BIT) {
+					insn->rexPrefix = 0x40
+						| (wFromEVEX3of4(insn->vectorExtensionPrefix[2]) << 3)
+						| (rFromEVEX2of4(insn->vectorExtensionPrefix[1]) << 2)
+						| (xFromEVEX2of4(insn->vectorExtensionPrefix[1]) << 1)
+						| (bFromEVEX2of4(insn->vectorExtensionPrefix[1]) << 0);
+				}
+
+				// dbgprintf(insn, "Found EVEX prefix 0x%hhx 0x%hhx 0x%hhx 0x%hhx",
+				// 		insn->vectorExtensionPrefix[0], insn->vectorExtensionPrefix[1],
+				// 		insn->vectorExtensionPrefix[2], insn->vectorExtensionPrefix[3]);
 			}
+			break;
+		}
+
+		case PFX_VEX_3B: {
+			uint8_t byte1;
 
-			/* We simulate the REX prefix for simplicity's sake */
-			if (insn->mode == MODE_64BIT) {
-				insn->rexPrefix = 0x40
-					| (wFromEVEX3of4(insn->vectorExtensionPrefix[2]) << 3)
-					| (rFromEVEX2of4(insn->vectorExtensionPrefix[1]) << 2)
-					| (xFromEVEX2of4(insn->vectorExtensionPrefix[1]) << 1)
-					| (bFromEVEX2of4(insn->vectorExtensionPrefix[1]) << 0);
+			if (lookAtByte(insn, &byte1)) {
+				// dbgprintf(insn, "Couldn't read second byte of VEX");
+				return -1;
 			}
 
-			// dbgprintf(insn, "Found EVEX prefix 0x%hhx 0x%hhx 0x%hhx 0x%hhx",
-			// 		insn->vectorExtensionPrefix[0], insn->vectorExtensionPrefix[1],
-			// 		insn->vectorExtensionPrefix[2], insn->vectorExtensionPrefix[3]);
-		}
-	} else if (byte == 0xc4) {
-		uint8_t byte1;
+			if (insn->mode == MODE_64BIT || (byte1 & 0xc0) == 0xc0)
+				insn->vectorExtensionType = TYPE_VEX_3B;
+			else
+				unconsumeByte(insn);
 
-		if (lookAtByte(insn, &byte1)) {
-			// dbgprintf(insn, "Couldn't read second byte of VEX");
-			return -1;
+			if (insn->vectorExtensionType == TYPE_VEX_3B) {
+				insn->vectorExtensionPrefix[0] = byte;
+				consumeByte(insn, &insn->vectorExtensionPrefix[1]);
+				consumeByte(insn, &insn->vectorExtensionPrefix[2]);
+
+				/* We simulate the REX prefix for simplicity's sake */
+				if (insn->mode == MODE_64BIT)
+					insn->rexPrefix = 0x40
+						| (wFromVEX3of3(insn->vectorExtensionPrefix[2]) << 3)
+						| (rFromVEX2of3(insn->vectorExtensionPrefix[1]) << 2)
+						| (xFromVEX2of3(insn->vectorExtensionPrefix[1]) << 1)
+						| (bFromVEX2of3(insn->vectorExtensionPrefix[1]) << 0);
+
+				// dbgprintf(insn, "Found VEX prefix 0x%hhx 0x%hhx 0x%hhx",
+				// 		insn->vectorExtensionPrefix[0], insn->vectorExtensionPrefix[1],
+				// 		insn->vectorExtensionPrefix[2]);
+			}
+			break;
 		}
 
-		if (insn->mode == MODE_64BIT || (byte1 & 0xc0) == 0xc0)
-			insn->vectorExtensionType = TYPE_VEX_3B;
-		else
-			unconsumeByte(insn);
+		case PFX_VEX_2B: {
+			uint8_t byte1;
 
-		if (insn->vectorExtensionType == TYPE_VEX_3B) {
-			insn->vectorExtensionPrefix[0] = byte;
-			consumeByte(insn, &insn->vectorExtensionPrefix[1]);
-			consumeByte(insn, &insn->vectorExtensionPrefix[2]);
-
-			/* We simulate the REX prefix for simplicity's sake */
-			if (insn->mode == MODE_64BIT)
-				insn->rexPrefix = 0x40
-					| (wFromVEX3of3(insn->vectorExtensionPrefix[2]) << 3)
-					| (rFromVEX2of3(insn->vectorExtensionPrefix[1]) << 2)
-					| (xFromVEX2of3(insn->vectorExtensionPrefix[1]) << 1)
-					| (bFromVEX2of3(insn->vectorExtensionPrefix[1]) << 0);
-
-			// dbgprintf(insn, "Found VEX prefix 0x%hhx 0x%hhx 0x%hhx",
-			// 		insn->vectorExtensionPrefix[0], insn->vectorExtensionPrefix[1],
-			// 		insn->vectorExtensionPrefix[2]);
-		}
-	} else if (byte == 0xc5) {
-		uint8_t byte1;
+			if (lookAtByte(insn, &byte1)) {
+				// dbgprintf(insn, "Couldn't read second byte of VEX");
+				return -1;
+			}
 
-		if (lookAtByte(insn, &byte1)) {
-			// dbgprintf(insn, "Couldn't read second byte of VEX");
-			return -1;
-		}
+			if (insn->mode == MODE_64BIT || (byte1 & 0xc0) == 0xc0)
+				insn->vectorExtensionType = TYPE_VEX_2B;
+			else
+				unconsumeByte(insn);
 
-		if (insn->mode == MODE_64BIT || (byte1 & 0xc0) == 0xc0)
-			insn->vectorExtensionType = TYPE_VEX_2B;
-		else
-			unconsumeByte(insn);
+			if (insn->vectorExtensionType == TYPE_VEX_2B) {
+				insn->vectorExtensionPrefix[0] = byte;
+				consumeByte(insn, &insn->vectorExtensionPrefix[1]);
 
-		if (insn->vectorExtensionType == TYPE_VEX_2B) {
-			insn->vectorExtensionPrefix[0] = byte;
-			consumeByte(insn, &insn->vectorExtensionPrefix[1]);
+				if (insn->mode == MODE_64BIT)
+					insn->rexPrefix = 0x40
+						| (rFromVEX2of2(insn->vectorExtensionPrefix[1]) << 2);
 
-			if (insn->mode == MODE_64BIT)
-				insn->rexPrefix = 0x40
-					| (rFromVEX2of2(insn->vectorExtensionPrefix[1]) << 2);
+				switch (ppFromVEX2of2(insn->vectorExtensionPrefix[1])) {
+					default:
+						break;
+					case VEX_PREFIX_66:
+						insn->hasOpSize = true;
+						break;
+				}
 
-			switch (ppFromVEX2of2(insn->vectorExtensionPrefix[1])) {
-				default:
-					break;
-				case VEX_PREFIX_66:
-					insn->hasOpSize = true;
-					break;
+				// dbgprintf(insn, "Found VEX prefix 0x%hhx 0x%hhx",
+				// 		insn->vectorExtensionPrefix[0],
+				// 		insn->vectorExtensionPrefix[1]);
 			}
-
-			// dbgprintf(insn, "Found VEX prefix 0x%hhx 0x%hhx",
-			// 		insn->vectorExtensionPrefix[0],
-			// 		insn->vectorExtensionPrefix[1]);
+			break;
 		}
-	} else if (byte == 0x8f) {
-		uint8_t byte1;
 
-		if (lookAtByte(insn, &byte1)) {
-			// dbgprintf(insn, "Couldn't read second byte of XOP");
-			return -1;
-		}
+		case PFX_XOP: {
+			uint8_t byte1;
 
-		if ((byte1 & 0x38) != 0x0) /* 0 in these 3 bits is a POP instruction. */
-			insn->vectorExtensionType = TYPE_XOP;
-		else
-			unconsumeByte(insn);
+			if (lookAtByte(insn, &byte1)) {
+				// dbgprintf(insn, "Couldn't read second byte of XOP");
+				return -1;
+			}
 
-		if (insn->vectorExtensionType == TYPE_XOP) {
-			insn->vectorExtensionPrefix[0] = byte;
-			consumeByte(insn, &insn->vectorExtensionPrefix[1]);
-			consumeByte(insn, &insn->vectorExtensionPrefix[2]);
+			if ((byte1 & 0x38) != 0x0) /* 0 in these 3 bits is a POP instruction. */
+				insn->vectorExtensionType = TYPE_XOP;
+			else
+				unconsumeByte(insn);
 
-			/* We simulate the REX prefix for simplicity's sake */
-			if (insn->mode == MODE_64BIT)
-				insn->rexPrefix = 0x40
-					| (wFromXOP3of3(insn->vectorExtensionPrefix[2]) << 3)
-					| (rFromXOP2of3(insn->vectorExtensionPrefix[1]) << 2)
-					| (xFromXOP2of3(insn->vectorExtensionPrefix[1]) << 1)
-					| (bFromXOP2of3(insn->vectorExtensionPrefix[1]) << 0);
+			if (insn->vectorExtensionType == TYPE_XOP) {
+				insn->vectorExtensionPrefix[0] = byte;
+				consumeByte(insn, &insn->vectorExtensionPrefix[1]);
+				consumeByte(insn, &insn->vectorExtensionPrefix[2]);
 
-			switch (ppFromXOP3of3(insn->vectorExtensionPrefix[2])) {
-				default:
-					break;
-				case VEX_PREFIX_66:
-					insn->hasOpSize = true;
-					break;
-			}
+				/* We simulate the REX prefix for simplicity's sake */
+				if (insn->mode == MODE_64BIT)
+					insn->rexPrefix = 0x40
+						| (wFromXOP3of3(insn->vectorExtensionPrefix[2]) << 3)
+						| (rFromXOP2of3(insn->vectorExtensionPrefix[1]) << 2)
+						| (xFromXOP2of3(insn->vectorExtensionPrefix[1]) << 1)
+						| (bFromXOP2of3(insn->vectorExtensionPrefix[1]) << 0);
 
-			// dbgprintf(insn, "Found XOP prefix 0x%hhx 0x%hhx 0x%hhx",
-			// 		insn->vectorExtensionPrefix[0], insn->vectorExtensionPrefix[1],
-			// 		insn->vectorExtensionPrefix[2]);
+				switch (ppFromXOP3of3(insn->vectorExtensionPrefix[2])) {
+					default:
+						break;
+					case VEX_PREFIX_66:
+						insn->hasOpSize = true;
+						break;
+				}
+
+				// dbgprintf(insn, "Found XOP prefix 0x%hhx 0x%hhx 0x%hhx",
+				// 		insn->vectorExtensionPrefix[0], insn->vectorExtensionPrefix[1],
+				// 		insn->vectorExtensionPrefix[2]);
+			}
+			break;
 		}
-	} else if (isREX(insn, byte)) {
-		if (lookAtByte(insn, &nextByte))
-			return -1;
 
-		insn->rexPrefix = byte;
-		// dbgprintf(insn, "Found REX prefix 0x%hhx", byte);
-	} else
-		unconsumeByte(insn);
+		case PFX_REX:
+			// the next byte was read above
+			insn->rexPrefix = byte;
+			// dbgprintf(insn, "Found REX prefix 0x%hhx", byte);
+			break;
+
+		default:
+			unconsumeByte(insn);
+			break;
+	}
 
 	if (insn->mode == MODE_16BIT) {
 		insn->registerSize = (insn->hasOpSize ? 4 : 2);
@@ -2325,10 +2395,21 @@ int decodeInstruction(struct InternalInstruction *insn,
 		uint64_t startLoc,
 		DisassemblerMode mode)
 {
+	const struct reader_info *info = readerArg;
+
 	insn->reader = reader;
 	insn->readerArg = readerArg;
 	insn->startLocation = startLoc;
 	insn->readerCursor = startLoc;
+
+	// a valid instruction can be read from the buffer without bounds checks
+	// if the buffer does not end within the maximum instruction length.
+	// Longer byte sequences and the end of the buffer use the reader.
+	insn->directBytes = info->code + (startLoc - info->offset);
+	if (info->size - (startLoc - info->offset) >= 15)
+		insn->directEnd = startLoc + 15;
+	else
+		insn->directEnd = startLoc;
 	insn->mode = mode;
 	insn->numImmediatesConsumed = 0;
 
@@ -619,6 +619,11 @@ typedef struct InternalInstruction {
   const void* readerArg;
   /* The address of the next byte to read via the reader */
   uint64_t readerCursor;
+  /* The bytes from startLocation on, read without the reader below
+     directEnd. directEnd is startLocation if the buffer ends within the
+     maximum instruction length. */
+  const uint8_t *directBytes;
+  uint64_t directEnd;
 
   /* General instruction information */
 
@@ -703,8 +708,8 @@ typedef struct InternalInstruction {
  * @param insn      - The buffer to store the instruction in.  Allocated by the
  *                    consumer.
  * @param reader    - The byteReader_t for the bytes to be read.
- * @param readerArg - An argument to pass to the reader for storing context
- *                    specific to the consumer.  May be NULL.
+ * @param readerArg - The struct reader_info of the buffer, passed to the
+ *                    reader.  Bytes are also read from its code directly.
  * @param logger    - The dlog_t to be used in printing status messages from the
  *                    disassembler.  May be NULL.
  * @param loggerArg - An argument to pass to the logger for storing context
@@ -63,7 +63,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O);
 
 static void set_mem_access(MCInst *MI, bool status)
 {
-	if (MI->csh->detail_opt != CS_OPT_ON)
+	if (!(MI->detail_parts & CS_OPT_DETAIL_OPERANDS))
 		return;
 
 	MI->csh->doing_mem = status;
@@ -457,7 +457,7 @@ static void printSrcIdx(MCInst *MI, unsigned Op, SStream *O)
 	MCOperand *SegReg;
 	int reg;
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 #ifndef CAPSTONE_DIET
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 #endif
@@ -482,7 +482,7 @@ static void printSrcIdx(MCInst *MI, unsigned Op, SStream *O)
 	// If this has a segment register, print it.
 	if (reg) {
 		_printOperand(MI, Op + 1, O);
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_register_map(reg);
 		}
 		SStream_concat0(O, ":");
@@ -497,7 +497,7 @@ static void printSrcIdx(MCInst *MI, unsigned Op, SStream *O)
 
 static void printDstIdx(MCInst *MI, unsigned Op, SStream *O)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 #ifndef CAPSTONE_DIET
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 #endif
@@ -519,7 +519,7 @@ static void printDstIdx(MCInst *MI, unsigned Op, SStream *O)
 	// DI accesses are always ES-based on non-64bit mode
 	if (MI->csh->mode != CS_MODE_64) {
 		SStream_concat0(O, "es:[");
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_REG_ES;
 		}
 	} else
@@ -593,7 +593,7 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 	MCOperand *SegReg = MCInst_getOperand(MI, Op + 1);
 	int reg;
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 #ifndef CAPSTONE_DIET
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 #endif
@@ -617,7 +617,7 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 	if (reg) {
 		_printOperand(MI, Op + 1, O);
 		SStream_concat0(O, ":");
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_register_map(reg);
 		}
 	}
@@ -626,7 +626,7 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 
 	if (MCOperand_isImm(DispSpec)) {
 		int64_t imm = MCOperand_getImm(DispSpec);
-		if (MI->csh->detail_opt)
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.disp = imm;
 
 		if (imm < 0)
@@ -637,7 +637,7 @@ static void printMemOffset(MCInst *MI, unsigned Op, SStream *O)
 
 	SStream_concat0(O, "]");
 
-	if (MI->csh->detail_opt)
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 		MI->flat_insn->detail->x86.op_count++;
 
 	if (MI->op1_size == 0)
@@ -650,7 +650,7 @@ static void printU8Imm(MCInst *MI, unsigned Op, SStream *O)
 
 	printImm(MI, O, val, true);
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 #ifndef CAPSTONE_DIET
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 #endif
@@ -715,7 +715,7 @@ void X86_Intel_printInst(MCInst *MI, SStream *O, void *Info)
 	printInstruction(MI, O);
 
 	reg = X86_insn_reg_intel(MCInst_getOpcode(MI), &access1);
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 #ifndef CAPSTONE_DIET
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE] = {0};
 #endif
@@ -749,6 +749,11 @@ void X86_Intel_printInst(MCInst *MI, SStream *O, void *Info)
 		get_op_access(MI->csh, MCInst_getOpcode(MI), access, &MI->flat_insn->detail->x86.eflags);
 		MI->flat_insn->detail->x86.operands[0].access = access[0];
 		MI->flat_insn->detail->x86.operands[1].access = access[1];
+#endif
+	} else if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
+#ifndef CAPSTONE_DIET
+		// eflags come with the operand access otherwise
+		X86_get_op_access(MI->csh, MCInst_getOpcode(MI), &MI->flat_insn->detail->x86.eflags);
 #endif
 	}
 
@@ -772,7 +777,7 @@ static void printPCRelImm(MCInst *MI, unsigned OpNo, SStream *O)
 
 		printImm(MI, O, imm, true);
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 #ifndef CAPSTONE_DIET
 			uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 #endif
@@ -808,7 +813,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 		unsigned int reg = MCOperand_getReg(Op);
 
 		printRegName(O, reg);
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			if (MI->csh->doing_mem) {
 				MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.base = X86_register_map(reg);
 			} else {
@@ -895,7 +900,7 @@ static void printOperand(MCInst *MI, unsigned OpNo, SStream *O)
 				break;
 		}
 
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			if (MI->csh->doing_mem) {
 				MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.disp = imm;
 			} else {
@@ -938,7 +943,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 	MCOperand *SegReg = MCInst_getOperand(MI, Op + X86_AddrSegmentReg);
 	int reg;
 
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 #ifndef CAPSTONE_DIET
 		uint8_t access[CS_X86_MAXIMUM_OPERAND_SIZE];
 #endif
@@ -963,7 +968,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 	reg = MCOperand_getReg(SegReg);
 	if (reg) {
 		_printOperand(MI, Op + X86_AddrSegmentReg, O);
-		if (MI->csh->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.segment = X86_register_map(reg);
 		}
 		SStream_concat0(O, ":");
@@ -986,7 +991,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 
 	if (MCOperand_isImm(DispSpec)) {
 		int64_t DispVal = MCOperand_getImm(DispSpec);
-		if (MI->csh->detail_opt)
+		if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 			MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].mem.disp = DispVal;
 		if (DispVal) {
 			if (NeedPlus) {
@@ -1017,7 +1022,7 @@ static void printMemReference(MCInst *MI, unsigned Op, SStream *O)
 
 	SStream_concat0(O, "]");
 
-	if (MI->csh->detail_opt)
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS)
 		MI->flat_insn->detail->x86.op_count++;
 
 	if (MI->op1_size == 0)
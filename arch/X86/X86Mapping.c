@@ -955,12 +955,22 @@ const char *X86_group_name(csh handle, unsigned int id)
 const insn_map_x86 insns[] = {	// reduce x86 instructions
 #include "X86MappingInsn_reduce.inc"
 };
+
+// id-to-index map of insns, off by one: 0 is "not found"
+static const unsigned short insns_idx[] = {
+#include "X86MappingInsnIdx_reduce.inc"
+};
 #else
 #include "X86GenInstrInfo.inc"
 
 const insn_map_x86 insns[] = {	// full x86 instructions
 #include "X86MappingInsn.inc"
 };
+
+// id-to-index map of insns, off by one: 0 is "not found"
+static const unsigned short insns_idx[] = {
+#include "X86MappingInsnIdx.inc"
+};
 #endif
 
 #ifndef CAPSTONE_DIET
@@ -982,43 +992,18 @@ static void arr_replace(uint16_t *arr, uint8_t max, x86_reg r1, x86_reg r2)
 // return -1 if not found
 unsigned int find_insn(unsigned int id)
 {
-	// binary searching since the IDs are sorted in order
-	unsigned int left, right, m;
-	unsigned int max = ARR_SIZE(insns);
-
-	right = max - 1;
-
-	if (id < insns[0].id || id > insns[right].id)
-		// not found
-		return -1;
-
-	left = 0;
-
-	while(left <= right) {
-		m = (left + right) / 2;
-		if (id == insns[m].id) {
-			return m;
-		}
-
-		if (id < insns[m].id)
-			right = m - 1;
-		else
-			left = m + 1;
-	}
-
-	// not found
-	// printf("NOT FOUNDDDDDDDDDDDDDDD id = %u\n", id);
-	return -1;
+	return (unsigned int)insn_find(insns_idx, ARR_SIZE(insns_idx), id) - 1;
 }
 
 // given internal insn id, return public instruction info
-void X86_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void X86_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
+	cs_struct *h = MI->csh;
 	unsigned int i = find_insn(id);
 	if (i != -1) {
 		insn->id = insns[i].mapid;
 
-		if (h->detail_opt) {
+		if (MI->detail_parts & CS_OPT_DETAIL_IMPLICIT_REGS) {
 #ifndef CAPSTONE_DIET
 			memcpy(insn->detail->regs_read, insns[i].regs_use, sizeof(insns[i].regs_use));
 			insn->detail->regs_read_count = (uint8_t)count_positive(insns[i].regs_use);
@@ -1173,7 +1158,11 @@ void X86_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 					insn->detail->regs_read_count = 1;
 					break;
 			}
+#endif
+		}
 
+		if (MI->detail_parts & CS_OPT_DETAIL_GROUPS) {
+#ifndef CAPSTONE_DIET
 			memcpy(insn->detail->groups, insns[i].groups, sizeof(insns[i].groups));
 			insn->detail->groups_count = (uint8_t)count_positive8(insns[i].groups);
 
@@ -1207,347 +1196,97 @@ void X86_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
 // this is needed because LLVM embeds these register names into AsmStrs[],
 // but not separately in operands
 struct insn_reg {
-	uint16_t insn;
 	x86_reg reg;
 	enum cs_ac_type access;
 };
 
 struct insn_reg2 {
-	uint16_t insn;
 	x86_reg reg1, reg2;
 	enum cs_ac_type access1, access2;
 };
 
-static const struct insn_reg insn_regs_att[] = {
-	{ X86_INSB, X86_REG_DX, CS_AC_READ },
-	{ X86_INSL, X86_REG_DX, CS_AC_READ },
-	{ X86_INSW, X86_REG_DX, CS_AC_READ },
-	{ X86_MOV16o16a, X86_REG_AX, CS_AC_READ },
-	{ X86_MOV16o32a, X86_REG_AX, CS_AC_READ },
-	{ X86_MOV16o64a, X86_REG_AX, CS_AC_READ },
-	{ X86_MOV32o16a, X86_REG_EAX, CS_AC_READ },
-	{ X86_MOV32o32a, X86_REG_EAX, CS_AC_READ },
-	{ X86_MOV32o64a, X86_REG_EAX, CS_AC_READ },
-	{ X86_MOV64o32a, X86_REG_RAX, CS_AC_READ },
-	{ X86_MOV64o64a, X86_REG_RAX, CS_AC_READ },
-	{ X86_MOV8o16a, X86_REG_AL, CS_AC_READ },
-	{ X86_MOV8o32a, X86_REG_AL, CS_AC_READ },
-	{ X86_MOV8o64a, X86_REG_AL, CS_AC_READ },
-	{ X86_OUT16ir, X86_REG_AX, CS_AC_READ },
-	{ X86_OUT32ir, X86_REG_EAX, CS_AC_READ },
-	{ X86_OUT8ir, X86_REG_AL, CS_AC_READ },
-	{ X86_POPDS16, X86_REG_DS, CS_AC_WRITE },
-	{ X86_POPDS32, X86_REG_DS, CS_AC_WRITE },
-	{ X86_POPES16, X86_REG_ES, CS_AC_WRITE },
-	{ X86_POPES32, X86_REG_ES, CS_AC_WRITE },
-	{ X86_POPFS16, X86_REG_FS, CS_AC_WRITE },
-	{ X86_POPFS32, X86_REG_FS, CS_AC_WRITE },
-	{ X86_POPFS64, X86_REG_FS, CS_AC_WRITE },
-	{ X86_POPGS16, X86_REG_GS, CS_AC_WRITE },
-	{ X86_POPGS32, X86_REG_GS, CS_AC_WRITE },
-	{ X86_POPGS64, X86_REG_GS, CS_AC_WRITE },
-	{ X86_POPSS16, X86_REG_SS, CS_AC_WRITE },
-	{ X86_POPSS32, X86_REG_SS, CS_AC_WRITE },
-	{ X86_PUSHCS16, X86_REG_CS, CS_AC_READ },
-	{ X86_PUSHCS32, X86_REG_CS, CS_AC_READ },
-	{ X86_PUSHDS16, X86_REG_DS, CS_AC_READ },
-	{ X86_PUSHDS32, X86_REG_DS, CS_AC_READ },
-	{ X86_PUSHES16, X86_REG_ES, CS_AC_READ },
-	{ X86_PUSHES32, X86_REG_ES, CS_AC_READ },
-	{ X86_PUSHFS16, X86_REG_FS, CS_AC_READ },
-	{ X86_PUSHFS32, X86_REG_FS, CS_AC_READ },
-	{ X86_PUSHFS64, X86_REG_FS, CS_AC_READ },
-	{ X86_PUSHGS16, X86_REG_GS, CS_AC_READ },
-	{ X86_PUSHGS32, X86_REG_GS, CS_AC_READ },
-	{ X86_PUSHGS64, X86_REG_GS, CS_AC_READ },
-	{ X86_PUSHSS16, X86_REG_SS, CS_AC_READ },
-	{ X86_PUSHSS32, X86_REG_SS, CS_AC_READ },
-	{ X86_RCL16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_RCL32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_RCL64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_RCL8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_RCR16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_RCR32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_RCR64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_RCR8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROL16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROL32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROL64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROL8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROR16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROR32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROR64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_ROR8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAL16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAL32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAL64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAL8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAR16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAR32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAR64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SAR8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHL16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHL32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHL64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHL8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHLD16mrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHLD16rrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHLD32mrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHLD32rrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHLD64mrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHLD64rrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHR16rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHR32rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHR64rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHR8rCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHRD16mrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHRD16rrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHRD32mrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHRD32rrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHRD64mrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_SHRD64rrCL, X86_REG_CL, CS_AC_READ },
-	{ X86_XCHG16ar, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_XCHG32ar, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_XCHG64ar, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
+// the entries of each list in X86MappingInsnReg.inc are numbered from 1,
+// and the *_idx[] tables map an instruction id to its entry (or 0)
+enum {
+	INSN_REG_ATT_NONE,
+#define INSN_REG_ATT(insn, reg, access) INSN_REG_ATT_##insn,
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_ATT
 };
 
-static const struct insn_reg insn_regs_att_extra[] = {
-	// dummy entry, to avoid empty array
-	{ 0, 0 },
-#ifndef CAPSTONE_X86_REDUCE
-	{ X86_ADD_FrST0, X86_REG_ST0, CS_AC_READ },
-	{ X86_DIVR_FrST0, X86_REG_ST0, CS_AC_READ },
-	{ X86_DIV_FrST0, X86_REG_ST0, CS_AC_READ },
-	{ X86_FNSTSW16r, X86_REG_AX, CS_AC_READ },
-	{ X86_MUL_FrST0, X86_REG_ST0, CS_AC_READ },
-	{ X86_SKINIT, X86_REG_EAX, CS_AC_READ },
-	{ X86_SUBR_FrST0, X86_REG_ST0, CS_AC_READ },
-	{ X86_SUB_FrST0, X86_REG_ST0, CS_AC_READ },
-	{ X86_VMLOAD32, X86_REG_EAX, CS_AC_READ },
-	{ X86_VMLOAD64, X86_REG_RAX, CS_AC_READ },
-	{ X86_VMRUN32, X86_REG_EAX, CS_AC_READ },
-	{ X86_VMRUN64, X86_REG_RAX, CS_AC_READ },
-	{ X86_VMSAVE32, X86_REG_EAX, CS_AC_READ },
-	{ X86_VMSAVE64, X86_REG_RAX, CS_AC_READ },
-#endif
+static const struct insn_reg insn_regs_att[] = {
+	{ 0 },
+#define INSN_REG_ATT(insn, reg, access) { reg, access },
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_ATT
 };
 
-static const struct insn_reg insn_regs_intel[] = {
-	{ X86_ADC16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_ADC32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_ADC64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_ADC8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_ADD16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_ADD32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_ADD64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_ADD8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_AND16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_AND32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_AND64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_AND8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_CMP16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_CMP32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_CMP64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_CMP8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_IN16ri, X86_REG_AX, CS_AC_WRITE },
-	{ X86_IN32ri, X86_REG_EAX, CS_AC_WRITE },
-	{ X86_IN8ri, X86_REG_AL, CS_AC_WRITE },
-	{ X86_LODSB, X86_REG_AL, CS_AC_WRITE },
-	{ X86_LODSL, X86_REG_EAX, CS_AC_WRITE },
-	{ X86_LODSQ, X86_REG_RAX, CS_AC_WRITE },
-	{ X86_LODSW, X86_REG_AX, CS_AC_WRITE },
-	{ X86_MOV16ao16, X86_REG_AX, CS_AC_WRITE },    // 16-bit A1 1020                  // mov     ax, word ptr [0x2010]
-	{ X86_MOV16ao32, X86_REG_AX, CS_AC_WRITE },    // 32-bit A1 10203040              // mov     ax, word ptr [0x40302010]
-	{ X86_MOV16ao64, X86_REG_AX, CS_AC_WRITE },    // 64-bit 66 A1 1020304050607080   // movabs  ax, word ptr [0x8070605040302010]
-	{ X86_MOV32ao16, X86_REG_EAX, CS_AC_WRITE },   // 32-bit 67 A1 1020               // mov     eax, dword ptr [0x2010]
-	{ X86_MOV32ao32, X86_REG_EAX, CS_AC_WRITE },   // 32-bit A1 10203040              // mov     eax, dword ptr [0x40302010]
-	{ X86_MOV32ao64, X86_REG_EAX, CS_AC_WRITE },   // 64-bit A1 1020304050607080      // movabs  eax, dword ptr [0x8070605040302010]
-	{ X86_MOV64ao32, X86_REG_RAX, CS_AC_WRITE },   // 64-bit 48 8B04 10203040         // mov     rax, qword ptr [0x40302010]
-	{ X86_MOV64ao64, X86_REG_RAX, CS_AC_WRITE },   // 64-bit 48 A1 1020304050607080   // movabs  rax, qword ptr [0x8070605040302010]
-	{ X86_MOV8ao16, X86_REG_AL, CS_AC_WRITE },     // 16-bit A0 1020                  // mov     al, byte ptr [0x2010]
-	{ X86_MOV8ao32, X86_REG_AL, CS_AC_WRITE },     // 32-bit A0 10203040              // mov     al, byte ptr [0x40302010]
-	{ X86_MOV8ao64, X86_REG_AL, CS_AC_WRITE },     // 64-bit 66 A0 1020304050607080   // movabs  al, byte ptr [0x8070605040302010]
-	{ X86_OR16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_OR32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_OR64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_OR8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_OUTSB, X86_REG_DX, CS_AC_WRITE },
-	{ X86_OUTSL, X86_REG_DX, CS_AC_WRITE },
-	{ X86_OUTSW, X86_REG_DX, CS_AC_WRITE },
-	{ X86_POPDS16, X86_REG_DS, CS_AC_WRITE },
-	{ X86_POPDS32, X86_REG_DS, CS_AC_WRITE },
-	{ X86_POPES16, X86_REG_ES, CS_AC_WRITE },
-	{ X86_POPES32, X86_REG_ES, CS_AC_WRITE },
-	{ X86_POPFS16, X86_REG_FS, CS_AC_WRITE },
-	{ X86_POPFS32, X86_REG_FS, CS_AC_WRITE },
-	{ X86_POPFS64, X86_REG_FS, CS_AC_WRITE },
-	{ X86_POPGS16, X86_REG_GS, CS_AC_WRITE },
-	{ X86_POPGS32, X86_REG_GS, CS_AC_WRITE },
-	{ X86_POPGS64, X86_REG_GS, CS_AC_WRITE },
-	{ X86_POPSS16, X86_REG_SS, CS_AC_WRITE },
-	{ X86_POPSS32, X86_REG_SS, CS_AC_WRITE },
-	{ X86_PUSHCS16, X86_REG_CS, CS_AC_READ },
-	{ X86_PUSHCS32, X86_REG_CS, CS_AC_READ },
-	{ X86_PUSHDS16, X86_REG_DS, CS_AC_READ },
-	{ X86_PUSHDS32, X86_REG_DS, CS_AC_READ },
-	{ X86_PUSHES16, X86_REG_ES, CS_AC_READ },
-	{ X86_PUSHES32, X86_REG_ES, CS_AC_READ },
-	{ X86_PUSHFS16, X86_REG_FS, CS_AC_READ },
-	{ X86_PUSHFS32, X86_REG_FS, CS_AC_READ },
-	{ X86_PUSHFS64, X86_REG_FS, CS_AC_READ },
-	{ X86_PUSHGS16, X86_REG_GS, CS_AC_READ },
-	{ X86_PUSHGS32, X86_REG_GS, CS_AC_READ },
-	{ X86_PUSHGS64, X86_REG_GS, CS_AC_READ },
-	{ X86_PUSHSS16, X86_REG_SS, CS_AC_READ },
-	{ X86_PUSHSS32, X86_REG_SS, CS_AC_READ },
-	{ X86_SBB16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SBB32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SBB64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SBB8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SCASB, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SCASL, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SCASQ, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SCASW, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SUB16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SUB32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SUB64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_SUB8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_TEST16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_TEST32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_TEST64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_TEST8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
-	{ X86_XOR16i16, X86_REG_AX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_XOR32i32, X86_REG_EAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_XOR64i32, X86_REG_RAX, CS_AC_WRITE | CS_AC_READ },
-	{ X86_XOR8i8, X86_REG_AL, CS_AC_WRITE | CS_AC_READ },
+static const uint8_t insn_regs_att_idx[] = {
+#define INSN_REG_ATT(insn, reg, access) [insn] = INSN_REG_ATT_##insn,
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_ATT
 };
 
-static const struct insn_reg insn_regs_intel_extra[] = {
-	// dummy entry, to avoid empty array
-	{ 0, 0, 0 },
-#ifndef CAPSTONE_X86_REDUCE
-	{ X86_CMOVBE_F, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_CMOVB_F, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_CMOVE_F, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_CMOVNBE_F, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_CMOVNB_F, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_CMOVNE_F, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_CMOVNP_F, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_CMOVP_F, X86_REG_ST0, CS_AC_WRITE },
-	// { X86_COMP_FST0r, X86_REG_ST0, CS_AC_WRITE },
-	// { X86_COM_FST0r, X86_REG_ST0, CS_AC_WRITE },
-	{ X86_FNSTSW16r, X86_REG_AX, CS_AC_WRITE },
-	{ X86_SKINIT, X86_REG_EAX, CS_AC_WRITE },
-	{ X86_VMLOAD32, X86_REG_EAX, CS_AC_WRITE },
-	{ X86_VMLOAD64, X86_REG_RAX, CS_AC_WRITE },
-	{ X86_VMRUN32, X86_REG_EAX, CS_AC_WRITE },
-	{ X86_VMRUN64, X86_REG_RAX, CS_AC_WRITE },
-	{ X86_VMSAVE32, X86_REG_EAX, CS_AC_READ },
-	{ X86_VMSAVE64, X86_REG_RAX, CS_AC_READ },
-	{ X86_XCH_F, X86_REG_ST0, CS_AC_WRITE },
-#endif
+enum {
+	INSN_REG_INTEL_NONE,
+#define INSN_REG_INTEL(insn, reg, access) INSN_REG_INTEL_##insn,
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_INTEL
 };
 
-static const struct insn_reg2 insn_regs_intel2[] = {
-	{ X86_IN16rr, X86_REG_AX, X86_REG_DX, CS_AC_WRITE, CS_AC_READ },
-	{ X86_IN32rr, X86_REG_EAX, X86_REG_DX, CS_AC_WRITE, CS_AC_READ },
-	{ X86_IN8rr, X86_REG_AL, X86_REG_DX, CS_AC_WRITE, CS_AC_READ },
-	{ X86_INVLPGA32, X86_REG_EAX, X86_REG_ECX, CS_AC_READ, CS_AC_READ },
-	{ X86_INVLPGA64, X86_REG_RAX, X86_REG_ECX, CS_AC_READ, CS_AC_READ },
-	{ X86_OUT16rr, X86_REG_DX, X86_REG_AX, CS_AC_READ, CS_AC_READ },
-	{ X86_OUT32rr, X86_REG_DX, X86_REG_EAX, CS_AC_READ, CS_AC_READ },
-	{ X86_OUT8rr, X86_REG_DX, X86_REG_AL, CS_AC_READ, CS_AC_READ },
+static const struct insn_reg insn_regs_intel[] = {
+	{ 0 },
+#define INSN_REG_INTEL(insn, reg, access) { reg, access },
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_INTEL
 };
 
-static int binary_search1(const struct insn_reg *insns, unsigned int max, unsigned int id)
-{
-	unsigned int first, last, mid;
-
-	first = 0;
-	last = max -1;
-
-	if (insns[0].insn > id || insns[last].insn < id) {
-		// not found
-		return -1;
-	}
-
-	while (first <= last) {
-		mid = (first + last) / 2;
-		if (insns[mid].insn < id) {
-			first = mid + 1;
-		} else if (insns[mid].insn == id) {
-			return mid;
-		} else {
-			if (mid == 0)
-				break;
-			last = mid - 1;
-		}
-	}
-
-	// not found
-	return -1;
-}
-
-static int binary_search2(const struct insn_reg2 *insns, unsigned int max, unsigned int id)
-{
-	unsigned int first, last, mid;
+static const uint8_t insn_regs_intel_idx[] = {
+#define INSN_REG_INTEL(insn, reg, access) [insn] = INSN_REG_INTEL_##insn,
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_INTEL
+};
 
-	first = 0;
-	last = max -1;
+enum {
+	INSN_REG_INTEL2_NONE,
+#define INSN_REG_INTEL2(insn, reg1, reg2, access1, access2) INSN_REG_INTEL2_##insn,
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_INTEL2
+};
 
-	if (insns[0].insn > id || insns[last].insn < id) {
-		// not found
-		return -1;
-	}
+static const struct insn_reg2 insn_regs_intel2[] = {
+	{ 0 },
+#define INSN_REG_INTEL2(insn, reg1, reg2, access1, access2) { reg1, reg2, access1, access2 },
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_INTEL2
+};
 
-	while (first <= last) {
-		mid = (first + last) / 2;
-		if (insns[mid].insn < id) {
-			first = mid + 1;
-		} else if (insns[mid].insn == id) {
-			return mid;
-		} else {
-			if (mid == 0)
-				break;
-			last = mid - 1;
-		}
-	}
+static const uint8_t insn_regs_intel2_idx[] = {
+#define INSN_REG_INTEL2(insn, reg1, reg2, access1, access2) [insn] = INSN_REG_INTEL2_##insn,
+#include "X86MappingInsnReg.inc"
+#undef INSN_REG_INTEL2
+};
 
-	// not found
-	return -1;
-}
+#define insn_reg_find(table, id) \
+	((id) < ARR_SIZE(table##_idx) ? table##_idx[id] : 0)
 
 // return register of given instruction id
 // return 0 if not found
 // this is to handle instructions embedding accumulate registers into AsmStrs[]
 x86_reg X86_insn_reg_intel(unsigned int id, enum cs_ac_type *access)
 {
-	int i;
-
-	i = binary_search1(insn_regs_intel, ARR_SIZE(insn_regs_intel), id);
-	if (i != -1) {
-		if (access) {
-			*access = insn_regs_intel[i].access;
-		}
-		return insn_regs_intel[i].reg;
-	}
+	unsigned int i = insn_reg_find(insn_regs_intel, id);
 
-	i = binary_search1(insn_regs_intel_extra, ARR_SIZE(insn_regs_intel_extra), id);
-	if (i != -1) {
-		if (access) {
-			*access = insn_regs_intel_extra[i].access;
-		}
-		return insn_regs_intel_extra[i].reg;
-	}
+	if (access)
+		*access = insn_regs_intel[i].access;
 
-	// not found
-	return 0;
+	return insn_regs_intel[i].reg;
 }
 
 bool X86_insn_reg_intel2(unsigned int id, x86_reg *reg1, enum cs_ac_type *access1, x86_reg *reg2, enum cs_ac_type *access2)
 {
-	int i = binary_search2(insn_regs_intel2, ARR_SIZE(insn_regs_intel2), id);
-	if (i != -1) {
+	unsigned int i = insn_reg_find(insn_regs_intel2, id);
+	if (i) {
 		*reg1 = insn_regs_intel2[i].reg1;
 		*reg2 = insn_regs_intel2[i].reg2;
 		if (access1)
@@ -1563,31 +1302,19 @@ bool X86_insn_reg_intel2(unsigned int id, x86_reg *reg1, enum cs_ac_type *access
 
 x86_reg X86_insn_reg_att(unsigned int id, enum cs_ac_type *access)
 {
-	int i;
-
-	i = binary_search1(insn_regs_att, ARR_SIZE(insn_regs_att), id);
-	if (i != -1) {
-		if (access)
-			*access = insn_regs_att[i].access;
-		return insn_regs_att[i].reg;
-	}
+	unsigned int i = insn_reg_find(insn_regs_att, id);
 
-	i = binary_search1(insn_regs_att_extra, ARR_SIZE(insn_regs_att_extra), id);
-	if (i != -1) {
-		if (access)
-			*access = insn_regs_att_extra[i].access;
-		return insn_regs_att_extra[i].reg;
-	}
+	if (access)
+		*access = insn_regs_att[i].access;
 
-	// not found
-	return 0;
+	return insn_regs_att[i].reg;
 }
 
 // ATT just reuses Intel data, but with the order of registers reversed
 bool X86_insn_reg_att2(unsigned int id, x86_reg *reg1, enum cs_ac_type *access1, x86_reg *reg2, enum cs_ac_type *access2)
 {
-	int i = binary_search2(insn_regs_intel2, ARR_SIZE(insn_regs_intel2), id);
-	if (i != -1) {
+	unsigned int i = insn_reg_find(insn_regs_intel2, id);
+	if (i) {
 		*reg1 = insn_regs_intel2[i].reg2;
 		*reg2 = insn_regs_intel2[i].reg1;
 		if (access1)
@@ -1866,7 +1593,7 @@ static bool valid_notrack(cs_struct *h, unsigned int opcode)
 // add *CX register to regs_read[] & regs_write[]
 static void add_cx(MCInst *MI)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_IMPLICIT_REGS) {
 		x86_reg cx;
 
 		if (MI->csh->mode & CS_MODE_16)
@@ -2004,7 +1731,7 @@ bool X86_lockrep(MCInst *MI, SStream *O)
 	}
 
 	// copy normalized prefix[] back to x86.prefix[]
-	if (MI->csh->detail_opt)
+	if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA)
 		memcpy(MI->flat_insn->detail->x86.prefix, MI->x86_prefix, ARR_SIZE(MI->x86_prefix));
 
 	return res;
@@ -2012,7 +1739,7 @@ bool X86_lockrep(MCInst *MI, SStream *O)
 
 void op_addReg(MCInst *MI, int reg)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_REG;
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].reg = reg;
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].size = MI->csh->regsize_map[reg];
@@ -2025,7 +1752,7 @@ void op_addReg(MCInst *MI, int reg)
 
 void op_addImm(MCInst *MI, int v)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].type = X86_OP_IMM;
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count].imm = v;
 		// if op_count > 0, then this operand's size is taken from the destination op
@@ -2045,28 +1772,28 @@ void op_addImm(MCInst *MI, int v)
 
 void op_addXopCC(MCInst *MI, int v)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
 		MI->flat_insn->detail->x86.xop_cc = v;
 	}
 }
 
 void op_addSseCC(MCInst *MI, int v)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
 		MI->flat_insn->detail->x86.sse_cc = v;
 	}
 }
 
 void op_addAvxCC(MCInst *MI, int v)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
 		MI->flat_insn->detail->x86.avx_cc = v;
 	}
 }
 
 void op_addAvxRoundingMode(MCInst *MI, int v)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
 		MI->flat_insn->detail->x86.avx_rm = v;
 	}
 }
@@ -2074,7 +1801,7 @@ void op_addAvxRoundingMode(MCInst *MI, int v)
 // below functions supply details to X86GenAsmWriter*.inc
 void op_addAvxZeroOpmask(MCInst *MI)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		// link with the previous operand
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count - 1].avx_zero_opmask = true;
 	}
@@ -2082,14 +1809,14 @@ void op_addAvxZeroOpmask(MCInst *MI)
 
 void op_addAvxSae(MCInst *MI)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_ARCH_EXTRA) {
 		MI->flat_insn->detail->x86.avx_sae = true;
 	}
 }
 
 void op_addAvxBroadcast(MCInst *MI, x86_avx_bcast v)
 {
-	if (MI->csh->detail_opt) {
+	if (MI->detail_parts & CS_OPT_DETAIL_OPERANDS) {
 		// link with the previous operand
 		MI->flat_insn->detail->x86.operands[MI->flat_insn->detail->x86.op_count - 1].avx_bcast = v;
 	}
@@ -2247,7 +1974,8 @@ unsigned short X86_register_map(unsigned short id)
 /// The post-printer function. Used to fixup flaws in the disassembly information
 /// of certain instructions.
 void X86_postprinter(csh handle, cs_insn *insn, SStream *mnem, MCInst *mci) {
-	if (!insn || !insn->detail) {
+	if (!insn || !insn->detail ||
+	    !(mci->detail_parts & CS_OPT_DETAIL_OPERANDS)) {
 		return;
 	}
 	switch (insn->id) {
@@ -36,7 +36,7 @@ x86_reg x86_map_segment(int r);
 const char *X86_reg_name(csh handle, unsigned int reg);
 
 // given internal insn id, return public instruction info
-void X86_get_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void X86_get_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 
 // return insn name, given insn id
 const char *X86_insn_name(csh handle, unsigned int id);
@@ -12,21 +12,19 @@
 
 cs_err X86_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
-
-	X86_init(mri);
+	const MCRegisterInfo *mri = X86_get_mri();
 
 	// by default, we use Intel syntax
 	ud->printer = X86_Intel_printInst;
 	ud->syntax = CS_OPT_SYNTAX_INTEL;
-	ud->printer_info = mri;
+	ud->printer_info = (void *)mri;
 	ud->disasm = X86_getInstruction;
 	ud->reg_name = X86_reg_name;
 	ud->insn_id = X86_get_insn_id;
 	ud->insn_name = X86_insn_name;
 	ud->group_name = X86_group_name;
 	ud->post_printer = X86_postprinter;
+	ud->insn_size = X86_getInsnSize;
 #ifndef CAPSTONE_DIET
 	ud->reg_access = X86_reg_access;
 #endif
@@ -765,7 +765,7 @@ bool XCore_getInstruction(csh ud, const uint8_t *code, size_t code_len, MCInst *
 	return false;
 }
 
-void XCore_init(MCRegisterInfo *MRI)
+const MCRegisterInfo *XCore_get_mri(void)
 {
 	/*
 	InitMCRegisterInfo(XCoreRegDesc, 17, RA, PC,
@@ -781,7 +781,7 @@ void XCore_init(MCRegisterInfo *MRI)
 	*/
 
 
-	MCRegisterInfo_InitMCRegisterInfo(MRI, XCoreRegDesc, 17,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(XCoreRegDesc, 17,
 			0, 0,
 			XCoreMCRegisterClasses, 2,
 			0, 0,
@@ -789,6 +789,8 @@ void XCore_init(MCRegisterInfo *MRI)
 			0,
 			XCoreSubRegIdxLists, 1,
 			0);
+
+	return &mri;
 }
 
 #endif
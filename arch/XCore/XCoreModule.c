@@ -12,13 +12,11 @@
 
 cs_err XCore_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_malloc(sizeof(*mri));
+	const MCRegisterInfo *mri = XCore_get_mri();
 
-	XCore_init(mri);
 	ud->printer = XCore_printInst;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = XCore_getInstruction;
 	ud->post_printer = XCore_post_printer;
 
@@ -38,13 +38,14 @@ static const map_insn_ops insn_operands[] = {
 #include "XtensaGenRegisterInfo.inc"
 #include "../../MathExtras.h"
 
-void Xtensa_init_mri(MCRegisterInfo *mri)
+const MCRegisterInfo *Xtensa_get_mri(void)
 {
-	MCRegisterInfo_InitMCRegisterInfo(
-		mri, XtensaRegDesc, ARR_SIZE(XtensaRegDesc), 0, 0,
+	static const MCRegisterInfo mri = MCREGISTERINFO_INIT(XtensaRegDesc, ARR_SIZE(XtensaRegDesc), 0, 0,
 		XtensaMCRegisterClasses, ARR_SIZE(XtensaMCRegisterClasses), 0,
 		0, XtensaRegDiffLists, NULL, XtensaSubRegIdxLists,
 		ARR_SIZE(XtensaSubRegIdxLists), XtensaRegEncodingTable);
+
+	return &mri;
 }
 
 void Xtensa_printer(MCInst *MI, SStream *OS, void *info)
@@ -78,7 +79,7 @@ const char *Xtensa_reg_name(csh handle, unsigned int id)
 	return Xtensa_LLVM_getRegisterName(id);
 }
 
-void Xtensa_insn_id(cs_struct *h, cs_insn *insn, unsigned int id)
+void Xtensa_insn_id(MCInst *MI, cs_insn *insn, unsigned int id)
 {
 	// Done in Xtensa_disasm
 }
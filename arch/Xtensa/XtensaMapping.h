@@ -10,12 +10,12 @@ typedef enum {
 #include "XtensaGenCSOpGroup.inc"
 } xtensa_op_group;
 
-void Xtensa_init_mri(MCRegisterInfo *mri);
+const MCRegisterInfo *Xtensa_get_mri(void);
 void Xtensa_printer(MCInst *MI, SStream *OS, void *info);
 bool Xtensa_disasm(csh handle, const uint8_t *code, size_t code_len,
 		   MCInst *instr, uint16_t *size, uint64_t address, void *info);
 const char *Xtensa_reg_name(csh handle, unsigned int id);
-void Xtensa_insn_id(cs_struct *h, cs_insn *insn, unsigned int id);
+void Xtensa_insn_id(MCInst *MI, cs_insn *insn, unsigned int id);
 const char *Xtensa_insn_name(csh handle, unsigned int id);
 const char *Xtensa_group_name(csh handle, unsigned int id);
 #ifndef CAPSTONE_DIET
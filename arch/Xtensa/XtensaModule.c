@@ -9,13 +9,11 @@
 
 cs_err Xtensa_global_init(cs_struct *ud)
 {
-	MCRegisterInfo *mri;
-	mri = cs_mem_calloc(1, sizeof(*mri));
+	const MCRegisterInfo *mri = Xtensa_get_mri();
 
-	Xtensa_init_mri(mri);
 	ud->printer = Xtensa_printer;
-	ud->printer_info = mri;
-	ud->getinsn_info = mri;
+	ud->printer_info = (void *)mri;
+	ud->getinsn_info = (void *)mri;
 	ud->disasm = Xtensa_disasm;
 	ud->reg_name = Xtensa_reg_name;
 	ud->insn_id = Xtensa_insn_id;
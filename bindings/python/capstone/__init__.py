@@ -170,6 +170,8 @@ __all__ = [
     'CS_OPT_MNEMONIC',
     'CS_OPT_UNSIGNED',
     'CS_OPT_ONLY_OFFSET_BRANCH',
+    'CS_OPT_LITBASE',
+    'CS_OPT_NO_TEXT',
 
     'CS_ERR_OK',
     'CS_ERR_MEM',
@@ -391,6 +393,8 @@ CS_OPT_SKIPDATA_SETUP = 6      # Setup user-defined function for SKIPDATA option
 CS_OPT_MNEMONIC = 7  # Customize instruction mnemonic
 CS_OPT_UNSIGNED = 8  # Print immediate in unsigned form
 CS_OPT_ONLY_OFFSET_BRANCH = 9  # ARM, prints branch immediates without offset.
+CS_OPT_LITBASE = 10  # Xtensa, set the LITBASE value.
+CS_OPT_NO_TEXT = 11  # Don't emit the asm text, only fill the details.
 
 # Capstone option value
 CS_OPT_OFF = 0             # Turn OFF an option - default option of CS_OPT_DETAIL
@@ -596,6 +600,20 @@ class _cs_detail(ctypes.Structure):
     )
 
 
+# member of _cs_arch used by each CS_ARCH_*. The core only allocates
+# that member of the detail, not the whole union.
+_cs_arch_member = (
+    'arm', 'aarch64', 'systemz', 'mips', 'x86', 'ppc', 'sparc', 'xcore', 'm68k',
+    'tms320c64x', 'm680x', 'evm', 'mos65xx', 'wasm', 'bpf', 'riscv', 'sh',
+    'tricore', 'alpha', 'hppa', 'loongarch', 'xtensa',
+)
+
+
+def _cs_detail_size(arch):
+    member = getattr(_cs_arch, _cs_arch_member[arch])
+    return _cs_detail.arch.offset + member.size
+
+
 class _cs_insn(ctypes.Structure):
     _fields_ = (
         ('id', ctypes.c_uint),
@@ -607,6 +625,7 @@ class _cs_insn(ctypes.Structure):
         ('op_str', ctypes.c_char * 160),
         ('is_alias', ctypes.c_bool),
         ('usesAliasDetails', ctypes.c_bool),
+        ('pred_block', ctypes.c_uint8 * 3),
         ('detail', ctypes.POINTER(_cs_detail)),
     )
 
@@ -782,7 +801,7 @@ class CsInsn(object):
             # save detail
             self._raw.detail = ctypes.pointer(all_info.detail._type_())
             ctypes.memmove(ctypes.byref(self._raw.detail[0]), ctypes.byref(all_info.detail[0]),
-                           ctypes.sizeof(type(all_info.detail[0])))
+                           _cs_detail_size(self._cs.arch))
 
     def __repr__(self):
         return '<CsInsn 0x%x [%s]: %s %s>' % (self.address, self.bytes.hex(), self.mnemonic, self.op_str)
@@ -17,6 +17,14 @@
 #include "utils.h"
 #include "MCRegisterInfo.h"
 
+#ifdef CAPSTONE_HAS_THREADS
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
 #if defined(_KERNEL_MODE)
 #include "windows\winkernel_mm.h"
 #endif
@@ -456,6 +464,191 @@ static const uint32_t all_arch = 0
 	;
 #endif
 
+// The part of cs_detail used by each architecture, and where its operands
+// are. Only this part is allocated for an insn. The compact detail
+// (CS_OPT_DETAIL_COMPACT) only keeps the operands which are used.
+typedef struct cs_detail_layout {
+	uint16_t size;		// offsetof(cs_detail, <arch>) + sizeof(cs_<arch>)
+	uint16_t ops;		// offset of the operands in cs_detail
+	uint16_t op_size;	// size of one operand, 0 if the arch has none
+	uint16_t op_count;	// offset of op_count in cs_detail
+	uint8_t max_ops;	// number of operands in cs_<arch>
+} cs_detail_layout;
+
+#define CS_DETAIL_LAYOUT(arch) \
+	{ \
+		offsetof(cs_detail, arch) + sizeof(cs_##arch), \
+		offsetof(cs_detail, arch.operands), \
+		sizeof(((cs_detail *)NULL)->arch.operands[0]), \
+		offsetof(cs_detail, arch.op_count), \
+		ARR_SIZE(((cs_detail *)NULL)->arch.operands), \
+	}
+
+static const cs_detail_layout detail_layouts[MAX_ARCH] = {
+	CS_DETAIL_LAYOUT(arm),
+	CS_DETAIL_LAYOUT(aarch64),
+	CS_DETAIL_LAYOUT(systemz),
+	CS_DETAIL_LAYOUT(mips),
+	CS_DETAIL_LAYOUT(x86),
+	CS_DETAIL_LAYOUT(ppc),
+	CS_DETAIL_LAYOUT(sparc),
+	CS_DETAIL_LAYOUT(xcore),
+	CS_DETAIL_LAYOUT(m68k),
+	CS_DETAIL_LAYOUT(tms320c64x),
+	CS_DETAIL_LAYOUT(m680x),
+	// EVM has no operands
+	{
+		offsetof(cs_detail, evm) + sizeof(cs_evm),
+		offsetof(cs_detail, evm) + sizeof(cs_evm),
+		0, 0, 0,
+	},
+	CS_DETAIL_LAYOUT(mos65xx),
+	CS_DETAIL_LAYOUT(wasm),
+	CS_DETAIL_LAYOUT(bpf),
+	CS_DETAIL_LAYOUT(riscv),
+	CS_DETAIL_LAYOUT(sh),
+	CS_DETAIL_LAYOUT(tricore),
+	CS_DETAIL_LAYOUT(alpha),
+	CS_DETAIL_LAYOUT(hppa),
+	CS_DETAIL_LAYOUT(loongarch),
+	CS_DETAIL_LAYOUT(xtensa),
+};
+
+// all details start 8-byte aligned
+#define DETAIL_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+// offset of the arch specific part, the same for all archs
+#define DETAIL_ARCH_OFFSET offsetof(cs_detail, x86)
+
+// check if the decoder of @arch can fill only the @parts of the detail
+// (CS_OPT_DETAIL_<part>), and leave the others out
+static bool detail_parts_valid(cs_arch arch, cs_opt_value parts)
+{
+	cs_opt_value with_ops;	// parts filled along with the operands only
+
+	if (parts == CS_DETAIL_PARTS)
+		return true;
+
+	switch (arch) {
+		default:
+			// the whole detail is always filled
+			return false;
+		case CS_ARCH_X86:
+			return true;
+		case CS_ARCH_ARM:
+		case CS_ARCH_AARCH64:
+		case CS_ARCH_PPC:
+			// some implicit registers are found with the operands
+			with_ops = CS_OPT_DETAIL_IMPLICIT_REGS |
+				CS_OPT_DETAIL_ARCH_EXTRA;
+			break;
+		case CS_ARCH_MIPS:
+		case CS_ARCH_SYSTEMZ:
+		case CS_ARCH_LOONGARCH:
+			// the other fields of <arch> are filled with the operands
+			with_ops = CS_OPT_DETAIL_ARCH_EXTRA;
+			break;
+	}
+
+	return (parts & CS_OPT_DETAIL_OPERANDS) || !(parts & with_ops);
+}
+
+// Header of a compact detail (CS_OPT_DETAIL_COMPACT). It is followed by
+// the used operands, the implicit registers read and written, the groups,
+// and the fields of cs_<arch> other than the operands. Everything after
+// the header has the layout of cs_detail, only the unused entries of the
+// lists are left out. So the record is never larger than the detail.
+typedef struct cs_packed_detail {
+	uint16_t size;	// size of the record, a multiple of 8
+	uint8_t regs_read_count;
+	uint8_t regs_write_count;
+	uint8_t groups_count;
+	uint8_t op_count;
+	bool writeback;
+	uint8_t padding;
+} cs_packed_detail;
+
+// pack the detail in @slot in place, return the size of the record
+static size_t detail_pack(const cs_struct *handle, void *slot)
+{
+	const cs_detail_layout *l = &detail_layouts[handle->arch];
+	size_t ops_end = l->ops + l->max_ops * l->op_size;
+	cs_packed_detail *pd = slot;
+	uint8_t *p = slot;
+	cs_detail detail;
+	size_t off, n;
+
+	memcpy(&detail, slot, l->size);
+
+	pd->regs_read_count =
+		MIN(detail.regs_read_count, ARR_SIZE(detail.regs_read));
+	pd->regs_write_count =
+		MIN(detail.regs_write_count, ARR_SIZE(detail.regs_write));
+	pd->groups_count = MIN(detail.groups_count, ARR_SIZE(detail.groups));
+	pd->op_count = l->op_size ?
+		MIN(((uint8_t *)&detail)[l->op_count], l->max_ops) : 0;
+	pd->writeback = detail.writeback;
+	pd->padding = 0;
+
+	off = sizeof(*pd);
+	n = pd->op_count * l->op_size;
+	memcpy(p + off, (uint8_t *)&detail + l->ops, n);
+	off += n;
+	n = pd->regs_read_count * sizeof(detail.regs_read[0]);
+	memcpy(p + off, detail.regs_read, n);
+	off += n;
+	n = pd->regs_write_count * sizeof(detail.regs_write[0]);
+	memcpy(p + off, detail.regs_write, n);
+	off += n;
+	memcpy(p + off, detail.groups, pd->groups_count);
+	off += pd->groups_count;
+	n = l->ops - DETAIL_ARCH_OFFSET;
+	memcpy(p + off, (uint8_t *)&detail + DETAIL_ARCH_OFFSET, n);
+	off += n;
+	n = l->size - ops_end;
+	memcpy(p + off, (uint8_t *)&detail + ops_end, n);
+	off += n;
+
+	memset(p + off, 0, DETAIL_ALIGN(off) - off);
+	pd->size = (uint16_t)DETAIL_ALIGN(off);
+
+	return pd->size;
+}
+
+// expand the compact detail @pd into @detail
+static void detail_unpack(const cs_struct *handle, const cs_packed_detail *pd,
+		cs_detail *detail)
+{
+	const cs_detail_layout *l = &detail_layouts[handle->arch];
+	size_t ops_end = l->ops + l->max_ops * l->op_size;
+	const uint8_t *p = (const uint8_t *)pd;
+	size_t off, n;
+
+	memset(detail, 0, l->size);
+
+	off = sizeof(*pd);
+	n = pd->op_count * l->op_size;
+	memcpy((uint8_t *)detail + l->ops, p + off, n);
+	off += n;
+	n = pd->regs_read_count * sizeof(detail->regs_read[0]);
+	memcpy(detail->regs_read, p + off, n);
+	off += n;
+	n = pd->regs_write_count * sizeof(detail->regs_write[0]);
+	memcpy(detail->regs_write, p + off, n);
+	off += n;
+	memcpy(detail->groups, p + off, pd->groups_count);
+	off += pd->groups_count;
+	n = l->ops - DETAIL_ARCH_OFFSET;
+	memcpy((uint8_t *)detail + DETAIL_ARCH_OFFSET, p + off, n);
+	off += n;
+	memcpy((uint8_t *)detail + ops_end, p + off, l->size - ops_end);
+
+	detail->regs_read_count = pd->regs_read_count;
+	detail->regs_write_count = pd->regs_write_count;
+	detail->groups_count = pd->groups_count;
+	detail->writeback = pd->writeback;
+}
+
 
 #if defined(CAPSTONE_USE_SYS_DYN_MEM)
 #if !defined(CAPSTONE_HAS_OSXKERNEL) && !defined(_KERNEL_MODE)
@@ -771,6 +964,23 @@ const char * CAPSTONE_API cs_strerror(cs_err code)
 	}
 }
 
+/// Computes the feature bitset of the current mode once, so testing a feature
+/// with CS_hasFeature() is a single bit test.
+void CS_updateFeatureBits(cs_struct *handle)
+{
+	unsigned int i;
+
+	memset(handle->feature_bits, 0, sizeof(handle->feature_bits));
+	if (!handle->feature_bits_of)
+		return;
+
+	CS_ASSERT_RET(handle->num_features <= CS_MAX_FEATURES);
+	for (i = 0; i < handle->num_features; i++) {
+		if (handle->feature_bits_of(handle->mode, i))
+			handle->feature_bits[i / 64] |= (uint64_t)1 << (i % 64);
+	}
+}
+
 CAPSTONE_EXPORT
 cs_err CAPSTONE_API cs_open(cs_arch arch, cs_mode mode, csh *handle)
 {
@@ -799,6 +1009,7 @@ cs_err CAPSTONE_API cs_open(cs_arch arch, cs_mode mode, csh *handle)
 		ud->mode = mode;
 		// by default, do not break instruction into details
 		ud->detail_opt = CS_OPT_OFF;
+		ud->detail_size = DETAIL_ALIGN(detail_layouts[arch].size);
 		ud->PrintBranchImmAsAddress = true;
 
 		// default skipdata setup
@@ -810,6 +1021,9 @@ cs_err CAPSTONE_API cs_open(cs_arch arch, cs_mode mode, csh *handle)
 			*handle = 0;
 			return err;
 		}
+		CS_updateFeatureBits(ud);
+
+		MCInst_Init(&ud->iter_mci, ud->arch);
 
 		*handle = (uintptr_t)ud;
 
@@ -833,8 +1047,10 @@ cs_err CAPSTONE_API cs_close(csh *handle)
 
 	ud = (struct cs_struct *)(*handle);
 
-	if (ud->printer_info)
+	// the MCRegisterInfo of most archs is shared, and not ours to free
+	if (ud->printer_info_size)
 		cs_mem_free(ud->printer_info);
+	cs_mem_free(ud->alias_idx);
 
 	// free the linked list of customized mnemonic
 	tmp = ud->mnem_list;
@@ -844,7 +1060,6 @@ cs_err CAPSTONE_API cs_close(csh *handle)
 		tmp = next;
 	}
 
-	cs_mem_free(ud->insn_cache);
 
 	memset(ud, 0, sizeof(*ud));
 	cs_mem_free(ud);
@@ -856,6 +1071,68 @@ cs_err CAPSTONE_API cs_close(csh *handle)
 	return CS_ERR_OK;
 }
 
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_clone(csh src, csh *dst)
+{
+	struct cs_struct *handle, *ud;
+	struct insn_mnem *m, *tmp, **next;
+
+	handle = (struct cs_struct *)(uintptr_t)src;
+	if (!handle || !dst)
+		return CS_ERR_CSH;
+
+	ud = cs_mem_malloc(sizeof(*ud));
+	if (!ud) {
+		handle->errnum = CS_ERR_MEM;
+		return CS_ERR_MEM;
+	}
+
+	// arch & mode, the options and the arch tables all come from @src.
+	// The tables are read-only, so they are shared.
+	memcpy(ud, handle, sizeof(*ud));
+	ud->errnum = CS_ERR_OK;
+	ud->mnem_list = NULL;
+	// the alias index is built again on first use
+	ud->alias_idx = NULL;
+	ud->alias_idx_size = 0;
+	ud->alias_idx_of = NULL;
+	// no IT/VPT block of @src carries over to the new handle
+	memset(&ud->ITBlock, 0, sizeof(ud->ITBlock));
+	memset(&ud->VPTBlock, 0, sizeof(ud->VPTBlock));
+	MCInst_Init(&ud->iter_mci, ud->arch);
+
+	// decoder state kept in the printer info is owned by each handle
+	if (handle->printer_info_size) {
+		ud->printer_info = cs_mem_malloc(handle->printer_info_size);
+		if (!ud->printer_info) {
+			cs_mem_free(ud);
+			handle->errnum = CS_ERR_MEM;
+			return CS_ERR_MEM;
+		}
+		memcpy(ud->printer_info, handle->printer_info, handle->printer_info_size);
+	}
+
+	// so are the customized mnemonics
+	next = &ud->mnem_list;
+	for (m = handle->mnem_list; m; m = m->next) {
+		tmp = cs_mem_malloc(sizeof(*tmp));
+		if (!tmp) {
+			csh h = (uintptr_t)ud;
+			cs_close(&h);
+			handle->errnum = CS_ERR_MEM;
+			return CS_ERR_MEM;
+		}
+		tmp->insn = m->insn;
+		tmp->next = NULL;
+		*next = tmp;
+		next = &tmp->next;
+	}
+
+	*dst = (uintptr_t)ud;
+
+	return CS_ERR_OK;
+}
+
 /// replace str1 in target with str2; target starts with str1
 /// output is put into result (which is array of char with size CS_MNEMONIC_SIZE)
 /// return 0 on success, -1 on failure
@@ -880,6 +1157,66 @@ static int str_replace(char *result, char *target, const char *str1, char *str2)
 }
 #endif
 
+// prepare the stream the asm printer writes the text of one insn into
+static void insn_stream_init(struct cs_struct *handle, SStream *OS)
+{
+	SStream_Init(OS);
+	// With CS_OPT_NO_TEXT the printer still runs to fill the details.
+	// Only the mnemonic is kept, because some archs derive the alias id
+	// from it. AArch64 parses the full asm text to complete its details.
+	if (handle->no_text && handle->arch != CS_ARCH_AARCH64)
+		SStream_MnemOnly(OS);
+}
+
+// The slots insns are decoded into don't come zeroed. The archs only set
+// the alias fields for an alias, so clear them for all the others.
+static void insn_clear_alias(cs_insn *insn)
+{
+	insn->is_alias = false;
+	insn->usesAliasDetails = false;
+	insn->alias_id = 0;
+}
+
+// For Arm, @insn keeps the IT/VPT state it is decoded in, so
+// cs_insn_format() can decode it in the same state again:
+// pred_block[0]: the IT condition + 1, or 0 outside of an IT block
+// pred_block[1]: 1 if more insns of the IT block follow @insn
+// pred_block[2]: the VPT predicate, or 0 outside of a VPT block
+static void insn_save_pred_block(const cs_struct *handle, cs_insn *insn)
+{
+	const ARM_ITBlock *it = &handle->ITBlock;
+	const ARM_VPTBlock *vpt = &handle->VPTBlock;
+
+	if (handle->arch != CS_ARCH_ARM)
+		return;
+
+	insn->pred_block[0] = it->size ? it->ITStates[it->size - 1] + 1 : 0;
+	insn->pred_block[1] = it->size > 1;
+	insn->pred_block[2] = vpt->size ? vpt->VPTStates[vpt->size - 1] : 0;
+}
+
+// set up the IT/VPT state of @handle which @insn was decoded in
+static void insn_load_pred_block(cs_struct *handle, const cs_insn *insn)
+{
+	ARM_ITBlock *it = &handle->ITBlock;
+	ARM_VPTBlock *vpt = &handle->VPTBlock;
+
+	it->size = 0;
+	vpt->size = 0;
+	if (handle->arch != CS_ARCH_ARM)
+		return;
+
+	// only the top of the stack is used for @insn
+	if (insn->pred_block[0]) {
+		it->ITStates[0] = it->ITStates[1] = insn->pred_block[0] - 1;
+		it->size = insn->pred_block[1] ? 2 : 1;
+	}
+	if (insn->pred_block[2]) {
+		vpt->VPTStates[0] = insn->pred_block[2];
+		vpt->size = 1;
+	}
+}
+
 // fill insn with mnemonic & operands info
 static void fill_insn(struct cs_struct *handle, cs_insn *insn, SStream *OS, MCInst *mci,
 		PostPrinter_t postprinter, const uint8_t *code)
@@ -905,8 +1242,11 @@ static void fill_insn(struct cs_struct *handle, cs_insn *insn, SStream *OS, MCIn
 		postprinter((csh)handle, insn, OS, mci);
 
 #ifndef CAPSTONE_DIET
-	memset(insn->mnemonic, '\0', sizeof(insn->mnemonic));
-	memset(insn->op_str, '\0', sizeof(insn->op_str));
+	if (handle->no_text) {
+		insn->mnemonic[0] = '\0';
+		return;
+	}
+
 	SStream_extract_mnem_opstr(OS, insn->mnemonic, sizeof(insn->mnemonic), insn->op_str, sizeof(insn->op_str));
 	for (sp = insn->mnemonic; *sp; sp++) {
 		if (*sp == '|')	// lock|rep prefix for x86
@@ -1009,11 +1349,41 @@ static uint8_t skipdata_size(cs_struct *handle)
 	}
 }
 
+// size of every instruction for archs & modes with a fixed instruction width,
+// or 0 if the size varies.
+static uint8_t fixed_insn_size(cs_struct *handle)
+{
+	switch(handle->arch) {
+		default:
+			return 0;
+		case CS_ARCH_ARM:
+			// Thumb is variable
+			if (handle->mode & CS_MODE_THUMB)
+				return 0;
+			return 4;
+		case CS_ARCH_MIPS:
+			// microMips, nanoMips & Mips16 are variable
+			if (handle->mode & (CS_MODE_MICRO | CS_MODE_NANOMIPS | CS_MODE_MIPS16))
+				return 0;
+			return 4;
+		case CS_ARCH_AARCH64:
+		case CS_ARCH_SPARC:
+		case CS_ARCH_TMS320C64X:
+		case CS_ARCH_ALPHA:
+		case CS_ARCH_HPPA:
+		case CS_ARCH_LOONGARCH:
+			return 4;
+		case CS_ARCH_XTENSA:
+			return 3;
+	}
+}
+
 CAPSTONE_EXPORT
 cs_err CAPSTONE_API cs_option(csh ud, cs_opt_type type, size_t value)
 {
 	struct cs_struct *handle;
 	cs_opt_mnem *opt;
+	cs_err err;
 
 	// cs_option() can be called with NULL handle just for CS_OPT_MEM
 	// This is supposed to be executed before all other APIs (even cs_open())
@@ -1041,10 +1411,27 @@ cs_err CAPSTONE_API cs_option(csh ud, cs_opt_type type, size_t value)
 			handle->imm_unsigned = (cs_opt_value)value;
 			return CS_ERR_OK;
 
-		case CS_OPT_DETAIL:
-			handle->detail_opt |= (cs_opt_value)value;
+		case CS_OPT_NO_TEXT:
+			handle->no_text = (value == CS_OPT_ON);
 			return CS_ERR_OK;
 
+		case CS_OPT_DETAIL: {
+			// no part selected means all parts
+			cs_opt_value parts = value & CS_DETAIL_PARTS;
+			if (!parts)
+				parts = CS_DETAIL_PARTS;
+			if (!detail_parts_valid(handle->arch, parts))
+				return CS_ERR_OPTION;
+
+			handle->detail_compact = value & CS_OPT_DETAIL_COMPACT;
+			handle->detail_opt |= (cs_opt_value)(value &
+					~(CS_OPT_DETAIL_COMPACT | CS_DETAIL_PARTS));
+			handle->detail_parts = parts;
+			if (!handle->detail_opt)
+				handle->detail_parts = CS_OPT_OFF;
+			return CS_ERR_OK;
+		}
+
 		case CS_OPT_SKIPDATA:
 			handle->skipdata = (value == CS_OPT_ON);
 			if (handle->skipdata) {
@@ -1134,7 +1521,11 @@ cs_err CAPSTONE_API cs_option(csh ud, cs_opt_type type, size_t value)
 	if (!arch_configs[handle->arch].arch_option)
 		return CS_ERR_ARCH;
 
-	return arch_configs[handle->arch].arch_option(handle, type, value);
+	err = arch_configs[handle->arch].arch_option(handle, type, value);
+	if (type == CS_OPT_MODE && err == CS_ERR_OK)
+		CS_updateFeatureBits(handle);
+
+	return err;
 }
 
 // generate @op_str for data instruction of SKIPDATA
@@ -1169,6 +1560,55 @@ static void skipdata_opstr(char *opstr, const uint8_t *buffer, size_t size)
 }
 #endif
 
+// point @detail of the first @count insns into @details, which follows them.
+// With a @stride, insn[i] owns the slot at i * @stride, even if it has no
+// detail (SKIPDATA). Compact details (@stride 0) follow each other.
+static void rebase_details(cs_insn *insn, size_t count, uint8_t *details,
+		size_t stride)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		if (!insn[i].detail)
+			continue;
+		if (stride) {
+			insn[i].detail = (cs_detail *)(details + i * stride);
+		} else {
+			insn[i].detail = (cs_detail *)details;
+			details += ((cs_packed_detail *)details)->size;
+		}
+	}
+}
+
+// The insns returned by cs_disasm() share one block with their details, so
+// cs_free() releases both at once: room for @max insns, followed by
+// @detail_max bytes for details, of which the first @used bytes are taken.
+// Resize it to @new_max insns and @new_detail_max bytes for details.
+// Return the new block, or NULL if there is not enough memory.
+static cs_insn *resize_insns(cs_insn *insn, size_t count, size_t max,
+		size_t new_max, size_t used, size_t new_detail_max, size_t stride)
+{
+	cs_insn *tmp;
+
+	// when shrinking, the details move down before the block is cut
+	if (new_max < max)
+		memmove(insn + new_max, insn + max, used);
+
+	tmp = cs_mem_realloc(insn, new_max * sizeof(cs_insn) + new_detail_max);
+	if (!tmp) {
+		if (new_max > max)
+			return NULL;
+		// the old block is large enough
+		tmp = insn;
+	}
+
+	if (new_max > max)
+		memmove(tmp + new_max, tmp + max, used);
+	rebase_details(tmp, count, (uint8_t *)(tmp + new_max), stride);
+
+	return tmp;
+}
+
 // dynamically allocate memory to contain disasm insn
 // NOTE: caller must free() the allocated memory itself to avoid memory leaking
 CAPSTONE_EXPORT
@@ -1177,18 +1617,19 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 	struct cs_struct *handle;
 	MCInst mci;
 	uint16_t insn_size;
-	size_t c = 0, i;
-	unsigned int f = 0;	// index of the next instruction in the cache
+	size_t c = 0;
 	cs_insn *insn_cache;	// cache contains disassembled instructions
-	void *total = NULL;
-	size_t total_size = 0;	// total size of output buffer containing all insns
+	cs_insn *total = NULL;	// all insns, followed by their details
+	size_t max;		// number of insns @total has room for
+	size_t stride = 0;	// bytes reserved for the detail of one insn
+	size_t used = 0;	// bytes of @total taken by details
+	bool packed;
 	bool r;
-	void *tmp;
+	cs_insn *tmp;
 	size_t skipdata_bytes;
 	uint64_t offset_org; // save all the original info of the buffer
 	size_t size_org;
 	const uint8_t *buffer_org;
-	unsigned int cache_size = INSN_CACHE_SIZE;
 	size_t next_offset;
 
 	handle = (struct cs_struct *)(uintptr_t)ud;
@@ -1200,9 +1641,10 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 
 	handle->errnum = CS_ERR_OK;
 
+	max = INSN_CACHE_SIZE;
 #ifdef CAPSTONE_USE_SYS_DYN_MEM
 	if (count > 0 && count <= INSN_CACHE_SIZE)
-		cache_size = (unsigned int) count;
+		max = count;
 #endif
 
 	// save the original offset for SKIPDATA
@@ -1210,27 +1652,54 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 	offset_org = offset;
 	size_org = size;
 
-	total_size = sizeof(cs_insn) * cache_size;
-	total = cs_mem_calloc(sizeof(cs_insn), cache_size);
+	if (handle->detail_opt)
+		stride = handle->detail_size;
+	packed = handle->detail_compact;
+
+	total = cs_mem_malloc(max * (sizeof(cs_insn) + stride));
 	if (total == NULL) {
 		// insufficient memory
 		handle->errnum = CS_ERR_MEM;
 		return 0;
 	}
 
-	insn_cache = total;
-
 	while (size > 0) {
+		if (c == max) {
+			// full cache, so expand the cache to contain incoming insns
+			size_t new_max = max * 8 / 5; // * 1.6 ~ golden ratio
+
+			tmp = resize_insns(total, c, max, new_max, used,
+					new_max * stride, packed ? 0 : stride);
+			if (tmp == NULL) {	// insufficient memory
+				cs_mem_free(total);
+				*insn = NULL;
+				handle->errnum = CS_ERR_MEM;
+				return 0;
+			}
+
+			total = tmp;
+			max = new_max;
+		}
+
+		insn_cache = total + c;
+
 		MCInst_Init(&mci, handle->arch);
 		mci.csh = handle;
+		mci.detail_opt = handle->detail_opt;
+		mci.detail_parts = handle->detail_parts;
 
 		// relative branches need to know the address & size of current insn
 		mci.address = offset;
 
-		if (handle->detail_opt) {
-			// allocate memory for @detail pointer
+		if (stride) {
+			// every insn starts with zeroed details. A compact detail is
+			// packed right after the previous one, a full one gets the
+			// slot with its own index.
+			if (!packed)
+				used = c * stride;
 			insn_cache->detail =
-				cs_mem_calloc(1, sizeof(cs_detail));
+				(cs_detail *)((uint8_t *)(total + max) + used);
+			memset(insn_cache->detail, 0, stride);
 		} else {
 			insn_cache->detail = NULL;
 		}
@@ -1238,6 +1707,8 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 		// save all the information for non-detailed mode
 		mci.flat_insn = insn_cache;
 		mci.flat_insn->address = offset;
+		insn_clear_alias(insn_cache);
+		insn_save_pred_block(handle, insn_cache);
 #ifdef CAPSTONE_DIET
 		// zero out mnemonic & op_str
 		mci.flat_insn->mnemonic[0] = '\0';
@@ -1247,13 +1718,13 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 		r = handle->disasm(ud, buffer, size, &mci, &insn_size, offset, handle->getinsn_info);
 		if (r) {
 			SStream ss;
-			SStream_Init(&ss);
+			insn_stream_init(handle, &ss);
 
 			mci.flat_insn->size = insn_size;
 
 			// map internal instruction opcode to public insn ID
 
-			handle->insn_id(handle, insn_cache, mci.Opcode);
+			handle->insn_id(&mci, insn_cache, mci.Opcode);
 
 			handle->printer(&mci, &ss, handle->printer_info);
 			fill_insn(handle, insn_cache, &ss, &mci, handle->post_printer, buffer);
@@ -1262,15 +1733,15 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 			if (handle->arch == CS_ARCH_X86 && insn_cache->id != X86_INS_VCMP)
 				insn_cache->id += mci.popcode_adjust;
 
+			if (stride)
+				used += packed ?
+					detail_pack(handle, insn_cache->detail) :
+					stride;
+
 			next_offset = insn_size;
 		} else	{
 			// encounter a broken instruction
 
-			// free memory of @detail pointer
-			if (handle->detail_opt) {
-				cs_mem_free(insn_cache->detail);
-			}
-
 			// if there is no request to skip data, or remaining data is too small,
 			// then bail out
 			if (!handle->skipdata || handle->skipdata_size > size)
@@ -1307,42 +1778,12 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 			next_offset = skipdata_bytes;
 		}
 
-		// one more instruction entering the cache
-		f++;
-
 		// one more instruction disassembled
 		c++;
 		if (count > 0 && c == count)
 			// already got requested number of instructions
 			break;
 
-		if (f == cache_size) {
-			// full cache, so expand the cache to contain incoming insns
-			cache_size = cache_size * 8 / 5; // * 1.6 ~ golden ratio
-			total_size += (sizeof(cs_insn) * cache_size);
-			tmp = cs_mem_realloc(total, total_size);
-			if (tmp == NULL) {	// insufficient memory
-				if (handle->detail_opt) {
-					insn_cache = (cs_insn *)total;
-					for (i = 0; i < c; i++, insn_cache++)
-						cs_mem_free(insn_cache->detail);
-				}
-
-				cs_mem_free(total);
-				*insn = NULL;
-				handle->errnum = CS_ERR_MEM;
-				return 0;
-			}
-
-			total = tmp;
-			// continue to fill in the cache after the last instruction
-			insn_cache = (cs_insn *)((char *)total + sizeof(cs_insn) * c);
-
-			// reset f back to 0, so we fill in the cache from beginning
-			f = 0;
-		} else
-			insn_cache++;
-
 		buffer += next_offset;
 		size -= next_offset;
 		offset += next_offset;
@@ -1352,25 +1793,12 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 		// we did not disassemble any instruction
 		cs_mem_free(total);
 		total = NULL;
-	} else if (f != cache_size) {
-		// total did not fully use the last cache, so downsize it
-		tmp = cs_mem_realloc(total, total_size - (cache_size - f) * sizeof(*insn_cache));
-		if (tmp == NULL) {	// insufficient memory
-			// free all detail pointers
-			if (handle->detail_opt) {
-				insn_cache = (cs_insn *)total;
-				for (i = 0; i < c; i++, insn_cache++)
-					cs_mem_free(insn_cache->detail);
-			}
-
-			cs_mem_free(total);
-			*insn = NULL;
-
-			handle->errnum = CS_ERR_MEM;
-			return 0;
-		}
-
-		total = tmp;
+	} else {
+		// downsize the block to the insns and details it really holds
+		if (stride && !packed)
+			used = c * stride;
+		total = resize_insns(total, c, max, c, used, used,
+				packed ? 0 : stride);
 	}
 
 	*insn = total;
@@ -1381,13 +1809,8 @@ size_t CAPSTONE_API cs_disasm(csh ud, const uint8_t *buffer, size_t size, uint64
 CAPSTONE_EXPORT
 void CAPSTONE_API cs_free(cs_insn *insn, size_t count)
 {
-	size_t i;
-
-	// free all detail pointers
-	for (i = 0; i < count; i++)
-		cs_mem_free(insn[i].detail);
-
-	// then free pointer to cs_insn array
+	// the details live in the same block as the insns.
+	// this also covers the single insn allocated by cs_malloc().
 	cs_mem_free(insn);
 }
 
@@ -1396,25 +1819,18 @@ cs_insn * CAPSTONE_API cs_malloc(csh ud)
 {
 	cs_insn *insn;
 	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	// room for the detail right after the insn
+	size_t detail_size = handle->detail_opt ? handle->detail_size : 0;
 
-	insn = cs_mem_malloc(sizeof(cs_insn));
+	insn = cs_mem_malloc(sizeof(cs_insn) + detail_size);
 	if (!insn) {
 		// insufficient memory
 		handle->errnum = CS_ERR_MEM;
 		return NULL;
-	} else {
-		if (handle->detail_opt) {
-			// allocate memory for @detail pointer
-			insn->detail = cs_mem_malloc(sizeof(cs_detail));
-			if (insn->detail == NULL) {	// insufficient memory
-				cs_mem_free(insn);
-				handle->errnum = CS_ERR_MEM;
-				return NULL;
-			}
-		} else
-			insn->detail = NULL;
 	}
 
+	insn->detail = detail_size ? (cs_detail *)(insn + 1) : NULL;
+
 	return insn;
 }
 
@@ -1425,7 +1841,7 @@ bool CAPSTONE_API cs_disasm_iter(csh ud, const uint8_t **code, size_t *size,
 {
 	struct cs_struct *handle;
 	uint16_t insn_size;
-	MCInst mci;
+	MCInst *mci;
 	bool r;
 
 	handle = (struct cs_struct *)(uintptr_t)ud;
@@ -1435,38 +1851,50 @@ bool CAPSTONE_API cs_disasm_iter(csh ud, const uint8_t **code, size_t *size,
 
 	handle->errnum = CS_ERR_OK;
 
-	MCInst_Init(&mci, handle->arch);
-	mci.csh = handle;
+	mci = &handle->iter_mci;
+	MCInst_Init(mci, handle->arch);
+	mci->csh = handle;
+	mci->detail_opt = handle->detail_opt;
+	mci->detail_parts = handle->detail_parts;
 
 	// relative branches need to know the address & size of current insn
-	mci.address = *address;
+	mci->address = *address;
+
+	if (insn->detail)
+		// same as cs_disasm(), every insn starts with zeroed details
+		memset(insn->detail, 0, handle->detail_size);
 
 	// save all the information for non-detailed mode
-	mci.flat_insn = insn;
-	mci.flat_insn->address = *address;
+	mci->flat_insn = insn;
+	mci->flat_insn->address = *address;
+	insn_clear_alias(insn);
+	insn_save_pred_block(handle, insn);
 #ifdef CAPSTONE_DIET
 	// zero out mnemonic & op_str
-	mci.flat_insn->mnemonic[0] = '\0';
-	mci.flat_insn->op_str[0] = '\0';
+	mci->flat_insn->mnemonic[0] = '\0';
+	mci->flat_insn->op_str[0] = '\0';
 #endif
 
-	r = handle->disasm(ud, *code, *size, &mci, &insn_size, *address, handle->getinsn_info);
+	r = handle->disasm(ud, *code, *size, mci, &insn_size, *address, handle->getinsn_info);
 	if (r) {
 		SStream ss;
-		SStream_Init(&ss);
+		insn_stream_init(handle, &ss);
 
-		mci.flat_insn->size = insn_size;
+		mci->flat_insn->size = insn_size;
 
 		// map internal instruction opcode to public insn ID
-		handle->insn_id(handle, insn, mci.Opcode);
+		handle->insn_id(mci, insn, mci->Opcode);
 
-		handle->printer(&mci, &ss, handle->printer_info);
+		handle->printer(mci, &ss, handle->printer_info);
 
-		fill_insn(handle, insn, &ss, &mci, handle->post_printer, *code);
+		fill_insn(handle, insn, &ss, mci, handle->post_printer, *code);
 
 		// adjust for pseudo opcode (X86)
 		if (handle->arch == CS_ARCH_X86)
-			insn->id += mci.popcode_adjust;
+			insn->id += mci->popcode_adjust;
+
+		if (insn->detail && handle->detail_compact)
+			detail_pack(handle, insn->detail);
 
 		*code += insn_size;
 		*size -= insn_size;
@@ -1514,80 +1942,1464 @@ bool CAPSTONE_API cs_disasm_iter(csh ud, const uint8_t **code, size_t *size,
 	return true;
 }
 
-// return friendly name of register in a string
-CAPSTONE_EXPORT
-const char * CAPSTONE_API cs_reg_name(csh ud, unsigned int reg)
-{
-	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
-
-	if (!handle || handle->reg_name == NULL) {
-		return NULL;
-	}
+// the detail a decode loop fills. It is usually the one of the handle options,
+// but an internal user can ask for more without touching the options.
+struct detail_level {
+	cs_opt_value opt;	// CS_OPT_DETAIL value, CS_OPT_OFF for no detail
+	cs_opt_value parts;	// CS_OPT_DETAIL_<part> values of the parts to fill
+	bool compact;	// pack the detail of every insn
+};
 
-	return handle->reg_name(ud, reg);
+static void handle_detail_level(const cs_struct *handle,
+		struct detail_level *level)
+{
+	level->opt = handle->detail_opt;
+	level->parts = handle->detail_parts;
+	level->compact = handle->detail_compact;
 }
 
-CAPSTONE_EXPORT
-const char * CAPSTONE_API cs_insn_name(csh ud, unsigned int insn)
+// decode the insn at @buffer into @insn, whose detail (if any) is set up
+// already. @level tells which detail to fill.
+// A broken insn is turned into data if SKIPDATA allows it.
+// @code, @size & @address describe the whole buffer for the SKIPDATA callback.
+// Returns the number of bytes consumed, or 0 to stop decoding.
+static size_t disasm_one(cs_struct *handle, const struct detail_level *level,
+		MCInst *mci, cs_insn *insn, const uint8_t *buffer, size_t remain,
+		uint64_t offset, const uint8_t *code, size_t size, uint64_t address)
 {
-	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	uint16_t insn_size;
+	size_t skipdata_bytes;
 
-	if (!handle || handle->insn_name == NULL) {
-		return NULL;
-	}
+	MCInst_Init(mci, handle->arch);
+	mci->csh = handle;
+	mci->detail_opt = level->opt;
+	mci->detail_parts = level->parts;
 
-	return handle->insn_name(ud, insn);
-}
+	// relative branches need to know the address & size of current insn
+	mci->address = offset;
 
-CAPSTONE_EXPORT
-const char * CAPSTONE_API cs_group_name(csh ud, unsigned int group)
-{
-	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	if (insn->detail)
+		// same as cs_disasm(), every insn starts with zeroed details
+		memset(insn->detail, 0, handle->detail_size);
 
-	if (!handle || handle->group_name == NULL) {
-		return NULL;
-	}
+	// save all the information for non-detailed mode
+	mci->flat_insn = insn;
+	mci->flat_insn->address = offset;
+	insn_clear_alias(insn);
+	insn_save_pred_block(handle, insn);
+#ifdef CAPSTONE_DIET
+	// zero out mnemonic & op_str
+	mci->flat_insn->mnemonic[0] = '\0';
+	mci->flat_insn->op_str[0] = '\0';
+#endif
 
-	return handle->group_name(ud, group);
-}
+	if (handle->disasm((csh)handle, buffer, remain, mci, &insn_size, offset, handle->getinsn_info)) {
+		SStream ss;
+		insn_stream_init(handle, &ss);
 
-CAPSTONE_EXPORT
-bool CAPSTONE_API cs_insn_group(csh ud, const cs_insn *insn, unsigned int group_id)
-{
-	struct cs_struct *handle;
-	if (!ud)
-		return false;
+		mci->flat_insn->size = insn_size;
 
-	handle = (struct cs_struct *)(uintptr_t)ud;
+		// map internal instruction opcode to public insn ID
+		handle->insn_id(mci, insn, mci->Opcode);
 
-	if (!handle->detail_opt) {
-		handle->errnum = CS_ERR_DETAIL;
-		return false;
-	}
+		handle->printer(mci, &ss, handle->printer_info);
+		fill_insn(handle, insn, &ss, mci, handle->post_printer, buffer);
 
-	if (!insn->id) {
-		handle->errnum = CS_ERR_SKIPDATA;
-		return false;
-	}
+		// adjust for pseudo opcode (X86)
+		if (handle->arch == CS_ARCH_X86 && insn->id != X86_INS_VCMP)
+			insn->id += mci->popcode_adjust;
 
-	if (!insn->detail) {
-		handle->errnum = CS_ERR_DETAIL;
-		return false;
+		if (insn->detail && level->compact)
+			detail_pack(handle, insn->detail);
+
+		return insn_size;
 	}
 
-	return arr_exist8(insn->detail->groups, insn->detail->groups_count, group_id);
-}
+	// encounter a broken instruction
 
-CAPSTONE_EXPORT
-bool CAPSTONE_API cs_reg_read(csh ud, const cs_insn *insn, unsigned int reg_id)
-{
-	struct cs_struct *handle;
-	if (!ud)
-		return false;
+	// if there is no request to skip data, or remaining data is too small,
+	// then bail out
+	if (!handle->skipdata || handle->skipdata_size > remain)
+		return 0;
 
-	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (handle->skipdata_setup.callback) {
+		skipdata_bytes = handle->skipdata_setup.callback(code, size,
+				(size_t)(offset - address), handle->skipdata_setup.user_data);
+		if (skipdata_bytes > remain)
+			// remaining data is not enough
+			return 0;
 
-	if (!handle->detail_opt) {
+		if (!skipdata_bytes)
+			// user requested not to skip data, so bail out
+			return 0;
+	} else
+		skipdata_bytes = handle->skipdata_size;
+
+	// we have to skip some amount of data, depending on arch & mode
+	insn->id = 0;	// invalid ID for this "data" instruction
+	insn->address = offset;
+	insn->size = (uint16_t)skipdata_bytes;
+	memcpy(insn->bytes, buffer, skipdata_bytes);
+#ifdef CAPSTONE_DIET
+	insn->mnemonic[0] = '\0';
+	insn->op_str[0] = '\0';
+#else
+	strncpy(insn->mnemonic, handle->skipdata_setup.mnemonic,
+			sizeof(insn->mnemonic) - 1);
+	skipdata_opstr(insn->op_str, buffer, skipdata_bytes);
+#endif
+	insn->detail = NULL;
+
+	return skipdata_bytes;
+}
+
+// decode up to @count insns into @insn. The detail of insn[i] goes into the
+// slot at i * @stride of @details.
+static size_t disasm_into(cs_struct *handle, const uint8_t **code,
+		size_t *size, uint64_t *address, cs_insn *insn, uint8_t *details,
+		size_t stride, size_t count)
+{
+	struct detail_level level;
+	MCInst mci;
+	size_t c = 0;
+	const uint8_t *buffer;
+	size_t remain;
+	uint64_t offset;
+	size_t next_offset;
+
+	handle_detail_level(handle, &level);
+	buffer = *code;
+	remain = *size;
+	offset = *address;
+
+	while (remain > 0 && c < count) {
+		cs_insn *cur = insn + c;
+
+		cur->detail = level.opt ?
+			(cs_detail *)(details + c * stride) : NULL;
+
+		next_offset = disasm_one(handle, &level, &mci, cur, buffer, remain,
+				offset, *code, *size, *address);
+		if (!next_offset)
+			break;
+
+		c++;
+
+		buffer += next_offset;
+		remain -= next_offset;
+		offset += next_offset;
+	}
+
+	// let the caller resume right after the last decoded insn
+	*code = buffer;
+	*size = remain;
+	*address = offset;
+
+	return c;
+}
+
+// batch disassembling into buffers provided by the caller
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_into(csh ud, const uint8_t **code, size_t *size,
+		uint64_t *address, cs_insn *insn, cs_detail *detail, size_t count)
+{
+	struct cs_struct *handle;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	if (!code || !size || !address || !insn) {
+		handle->errnum = CS_ERR_OPTION;
+		return 0;
+	}
+
+	if (handle->detail_opt && !detail) {
+		// details are requested, but there is nowhere to put them
+		handle->errnum = CS_ERR_DETAIL;
+		return 0;
+	}
+
+	return disasm_into(handle, code, size, address, insn, (uint8_t *)detail,
+			sizeof(cs_detail), count);
+}
+
+// streaming disassembling, one insn at a time handed to a callback
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_cb(csh ud, const uint8_t *code, size_t size,
+		uint64_t address, cs_disasm_cb_t cb, void *user_data)
+{
+	struct cs_struct *handle;
+	// the same insn & detail are reused for the whole buffer
+	cs_insn insn;
+	cs_detail detail;
+	struct detail_level level;
+	MCInst mci;
+	size_t c = 0;
+	size_t pos = 0;
+	size_t next_offset;
+	uint64_t next;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	if (!code || !cb) {
+		handle->errnum = CS_ERR_OPTION;
+		return 0;
+	}
+
+	handle_detail_level(handle, &level);
+	while (pos < size) {
+		insn.detail = level.opt ? &detail : NULL;
+
+		next_offset = disasm_one(handle, &level, &mci, &insn, code + pos,
+				size - pos, address + pos, code, size, address);
+		if (!next_offset)
+			break;
+
+		c++;
+
+		next = address + pos + next_offset;
+		switch (cb((csh)handle, &insn, &next, user_data)) {
+		case CS_CB_CONTINUE:
+			pos += next_offset;
+			break;
+		case CS_CB_SKIP:
+			if (next < address || next - address >= size)
+				// nothing left to decode there
+				return c;
+			if (next - address != pos + next_offset) {
+				// an IT/VPT block does not carry over to another place
+				handle->ITBlock.size = 0;
+				handle->VPTBlock.size = 0;
+			}
+			pos = (size_t)(next - address);
+			break;
+		case CS_CB_STOP:
+		default:
+			return c;
+		}
+	}
+
+	return c;
+}
+
+#ifndef CAPSTONE_DIET
+// the kind of control flow @insn ends a basic block with
+static cs_block_end block_end(const cs_struct *handle, const cs_insn *insn)
+{
+	const cs_detail *d = insn->detail;
+	cs_block_end end = CS_BLOCK_END_NONE;
+	unsigned int i, n;
+
+	// an insn of several groups takes the strongest kind
+	for (i = 0; i < d->groups_count; i++) {
+		switch (d->groups[i]) {
+		case CS_GRP_JUMP:
+			end = MAX(end, CS_BLOCK_END_JUMP);
+			break;
+		case CS_GRP_CALL:
+			end = MAX(end, CS_BLOCK_END_CALL);
+			break;
+		case CS_GRP_RET:
+			end = MAX(end, CS_BLOCK_END_RET);
+			break;
+		case CS_GRP_IRET:
+			end = MAX(end, CS_BLOCK_END_IRET);
+			break;
+		}
+	}
+
+	// control flow which these archs do not put in the common groups
+	switch (handle->arch) {
+	default:
+		break;
+	case CS_ARCH_SPARC:
+		switch (insn->id) {
+		case SPARC_INS_CALL:
+			return CS_BLOCK_END_CALL;
+		case SPARC_INS_RET:
+		case SPARC_INS_RETL:
+			return CS_BLOCK_END_RET;
+		case SPARC_INS_RETT:
+			return CS_BLOCK_END_IRET;
+		case SPARC_INS_JMP:
+		case SPARC_INS_JMPL:
+			return MAX(end, CS_BLOCK_END_JUMP);
+		}
+		break;
+	case CS_ARCH_SH:
+		switch (insn->id) {
+		case SH_INS_RTS:
+		case SH_INS_RTS_N:
+		case SH_INS_RTV_N:
+			return CS_BLOCK_END_RET;
+		case SH_INS_RTE:
+			return CS_BLOCK_END_IRET;
+		}
+		break;
+	case CS_ARCH_HPPA:
+		switch (insn->id) {
+		case HPPA_INS_RFI:
+		case HPPA_INS_RFIR:
+			return CS_BLOCK_END_IRET;
+		// branch target stack, no control flow
+		case HPPA_INS_CLRBTS:
+		case HPPA_INS_POPBTS:
+		case HPPA_INS_PUSHNOM:
+		case HPPA_INS_PUSHBTS:
+			return end;
+		}
+		for (i = 0; i < d->groups_count; i++)
+			if (d->groups[i] == HPPA_GRP_BRANCH)
+				break;
+		if (i == d->groups_count)
+			break;
+		// a branch which links to a register other than %r0 is a call
+		n = d->hppa.op_count;
+		if (n && d->hppa.operands[n - 1].type == HPPA_OP_REG &&
+		    d->hppa.operands[n - 1].reg != HPPA_REG_GR0)
+			return CS_BLOCK_END_CALL;
+		return CS_BLOCK_END_JUMP;
+	}
+
+	return end;
+}
+
+// true if the control flow insn @insn is followed by a delay slot
+static bool block_delay_slot(const cs_struct *handle, const cs_insn *insn)
+{
+	switch (handle->arch) {
+	default:
+		return false;
+	case CS_ARCH_MIPS:
+		if (handle->mode & CS_MODE_NANOMIPS)
+			return false;
+		if (handle->mode & CS_MODE_MIPS16)
+			// Mips16 branches have none, only the jumps have one
+			return insn->id == MIPS_INS_JAL ||
+			       insn->id == MIPS_INS_JALX ||
+			       insn->id == MIPS_INS_JALR ||
+			       insn->id == MIPS_INS_JR;
+		switch (insn->id) {
+		// compact branches & exception returns
+		case MIPS_INS_BALC:
+		case MIPS_INS_BALRSC:
+		case MIPS_INS_BBEQZC:
+		case MIPS_INS_BBNEZC:
+		case MIPS_INS_BC:
+		case MIPS_INS_BC16:
+		case MIPS_INS_BC1EQZC:
+		case MIPS_INS_BC1NEZC:
+		case MIPS_INS_BC2EQZC:
+		case MIPS_INS_BC2NEZC:
+		case MIPS_INS_BEQC:
+		case MIPS_INS_BEQIC:
+		case MIPS_INS_BEQZALC:
+		case MIPS_INS_BEQZC:
+		case MIPS_INS_BEQZC16:
+		case MIPS_INS_BGEC:
+		case MIPS_INS_BGEIC:
+		case MIPS_INS_BGEIUC:
+		case MIPS_INS_BGEUC:
+		case MIPS_INS_BGEZALC:
+		case MIPS_INS_BGEZC:
+		case MIPS_INS_BGTZALC:
+		case MIPS_INS_BGTZC:
+		case MIPS_INS_BLEZALC:
+		case MIPS_INS_BLEZC:
+		case MIPS_INS_BLTC:
+		case MIPS_INS_BLTIC:
+		case MIPS_INS_BLTIUC:
+		case MIPS_INS_BLTUC:
+		case MIPS_INS_BLTZALC:
+		case MIPS_INS_BLTZC:
+		case MIPS_INS_BNEC:
+		case MIPS_INS_BNEIC:
+		case MIPS_INS_BNEZALC:
+		case MIPS_INS_BNEZC:
+		case MIPS_INS_BNEZC16:
+		case MIPS_INS_BNVC:
+		case MIPS_INS_BOVC:
+		case MIPS_INS_BPOSGE32C:
+		case MIPS_INS_BRSC:
+		case MIPS_INS_JALRC:
+		case MIPS_INS_JALRC_HB:
+		case MIPS_INS_JIALC:
+		case MIPS_INS_JIC:
+		case MIPS_INS_JRADDIUSP:
+		case MIPS_INS_JRC:
+		case MIPS_INS_JRC16:
+		case MIPS_INS_JRCADDIUSP:
+		case MIPS_INS_DERET:
+		case MIPS_INS_ERET:
+		case MIPS_INS_ERETNC:
+			return false;
+		}
+		return true;
+	case CS_ARCH_SPARC:
+		// the delay slot of "ba,a" is never executed
+		if ((insn->id == SPARC_INS_B || insn->id == SPARC_INS_FB) &&
+		    (insn->detail->sparc.hint & SPARC_HINT_A) &&
+		    (insn->detail->sparc.cc == SPARC_CC_INVALID ||
+		     insn->detail->sparc.cc == SPARC_CC_ICC_A ||
+		     insn->detail->sparc.cc == SPARC_CC_FCC_A))
+			return false;
+		return true;
+	case CS_ARCH_SH:
+		switch (insn->id) {
+		case SH_INS_BRA:
+		case SH_INS_BRAF:
+		case SH_INS_BSR:
+		case SH_INS_BSRF:
+		case SH_INS_BF_S:
+		case SH_INS_BT_S:
+		case SH_INS_JMP:
+		case SH_INS_JSR:
+		case SH_INS_RTS:
+		case SH_INS_RTE:
+			return true;
+		}
+		return false;
+	case CS_ARCH_HPPA:
+		return insn->id != HPPA_INS_RFI && insn->id != HPPA_INS_RFIR;
+	}
+}
+
+// store in @target the direct target of the jump or call @insn, if it has one
+static bool block_target(const cs_struct *handle, const cs_insn *insn,
+		uint64_t *target)
+{
+	const cs_detail *d = insn->detail;
+	bool relative = false;
+	int i;
+
+	for (i = 0; i < d->groups_count; i++)
+		if (d->groups[i] == CS_GRP_BRANCH_RELATIVE)
+			relative = true;
+
+	// walk the operands backwards, the target is the last one
+	switch (handle->arch) {
+	default:
+		return false;
+	case CS_ARCH_X86:
+		// far jumps & calls take a segment too
+		if (!relative)
+			return false;
+		for (i = d->x86.op_count - 1; i >= 0; i--)
+			if (d->x86.operands[i].type == X86_OP_IMM) {
+				*target = d->x86.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_ARM:
+		if (!relative)
+			return false;
+		for (i = d->arm.op_count - 1; i >= 0; i--)
+			if (d->arm.operands[i].type == ARM_OP_IMM) {
+				*target = (uint32_t)d->arm.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_AARCH64:
+		if (!relative)
+			return false;
+		for (i = d->aarch64.op_count - 1; i >= 0; i--)
+			if (d->aarch64.operands[i].type == AARCH64_OP_IMM) {
+				*target = d->aarch64.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_MIPS:
+		// "j" & "jal" are not relative, but their target is known
+		for (i = d->mips.op_count - 1; i >= 0; i--)
+			if (d->mips.operands[i].type == MIPS_OP_IMM) {
+				*target = d->mips.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_PPC:
+		if (!relative)
+			return false;
+		for (i = d->ppc.op_count - 1; i >= 0; i--)
+			if (d->ppc.operands[i].type == PPC_OP_IMM) {
+				*target = d->ppc.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_SPARC:
+		for (i = d->sparc.op_count - 1; i >= 0; i--)
+			if (d->sparc.operands[i].type == SPARC_OP_IMM) {
+				*target = d->sparc.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_SYSTEMZ:
+		if (!relative)
+			return false;
+		for (i = d->systemz.op_count - 1; i >= 0; i--)
+			if (d->systemz.operands[i].type == SYSTEMZ_OP_IMM) {
+				*target = d->systemz.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_RISCV:
+		// the target is an offset to the insn
+		if (!relative && insn->id != RISCV_INS_JAL &&
+		    insn->id != RISCV_INS_C_J && insn->id != RISCV_INS_C_JAL)
+			return false;
+		for (i = d->riscv.op_count - 1; i >= 0; i--)
+			if (d->riscv.operands[i].type == RISCV_OP_IMM) {
+				*target = insn->address + d->riscv.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_LOONGARCH:
+		// the target is an offset to the insn
+		if (!relative)
+			return false;
+		for (i = d->loongarch.op_count - 1; i >= 0; i--)
+			if (d->loongarch.operands[i].type == LOONGARCH_OP_IMM) {
+				*target = insn->address +
+					d->loongarch.operands[i].imm;
+				return true;
+			}
+		return false;
+	case CS_ARCH_M68K:
+		// the displacement counts from after the opcode word
+		for (i = d->m68k.op_count - 1; i >= 0; i--)
+			if (d->m68k.operands[i].type == M68K_OP_BR_DISP) {
+				*target = insn->address + 2 +
+					d->m68k.operands[i].br_disp.disp;
+				return true;
+			}
+		return false;
+	case CS_ARCH_SH:
+		for (i = d->sh.op_count - 1; i >= 0; i--)
+			if (d->sh.operands[i].type == SH_OP_MEM &&
+			    d->sh.operands[i].mem.address == SH_OP_MEM_PCR) {
+				*target = d->sh.operands[i].mem.disp;
+				return true;
+			}
+		return false;
+	case CS_ARCH_HPPA:
+		// the target is an offset to the insn
+		for (i = d->hppa.op_count - 1; i >= 0; i--)
+			if (d->hppa.operands[i].type == HPPA_OP_TARGET) {
+				*target = insn->address + d->hppa.operands[i].imm;
+				return true;
+			}
+		return false;
+	}
+}
+#endif
+
+// decode one basic block
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_block(csh ud, const uint8_t *code, size_t size,
+		uint64_t address, cs_block *block)
+{
+	struct cs_struct *handle;
+#ifndef CAPSTONE_DIET
+	struct detail_level level;
+	cs_opt_value detail_opt;
+	bool compact;
+	MCInst mci;
+	cs_insn *total, *tmp;
+	size_t max = 16;	// most blocks are short
+	size_t stride;		// bytes of one detail
+	size_t used;		// bytes of details kept for the caller
+	size_t c = 0;
+	size_t pos = 0;
+	size_t next_offset;
+	bool ended = false;	// the control flow insn was decoded
+	size_t delay_slots = 0;	// insns still to decode after it
+	size_t i;
+#endif
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	if (!code || !block) {
+		handle->errnum = CS_ERR_OPTION;
+		return 0;
+	}
+
+	memset(block, 0, sizeof(*block));
+	block->next = address;
+
+#ifdef CAPSTONE_DIET
+	// no groups to find the end of the block
+	handle->errnum = CS_ERR_DIET;
+	return 0;
+#else
+	// the groups & operands are needed to find the end of the block, so
+	// they are always filled. The other parts are only filled if the
+	// caller asks for them, and the arch can leave them out.
+	// The details are packed at the end, as the caller asked.
+	detail_opt = handle->detail_opt;
+	compact = handle->detail_compact;
+	level.opt = detail_opt ? detail_opt : CS_OPT_ON;
+	level.parts = detail_opt ? handle->detail_parts : CS_OPT_OFF;
+	level.parts |= CS_OPT_DETAIL_GROUPS | CS_OPT_DETAIL_OPERANDS;
+	if (!detail_parts_valid(handle->arch, level.parts))
+		level.parts = CS_DETAIL_PARTS;
+	level.compact = false;
+	stride = handle->detail_size;
+
+	total = cs_mem_malloc(max * (sizeof(cs_insn) + stride));
+	if (!total) {
+		handle->errnum = CS_ERR_MEM;
+		return 0;
+	}
+
+	// the block can start anywhere, so no IT/VPT block carries over
+	handle->ITBlock.size = 0;
+	handle->VPTBlock.size = 0;
+
+	while (pos < size) {
+		cs_insn *cur;
+
+		if (c == max) {
+			size_t new_max = max * 2;
+
+			tmp = resize_insns(total, c, max, new_max, c * stride,
+					new_max * stride, stride);
+			if (!tmp) {
+				cs_mem_free(total);
+				total = NULL;
+				c = 0;
+				handle->errnum = CS_ERR_MEM;
+				break;
+			}
+
+			total = tmp;
+			max = new_max;
+		}
+
+		cur = total + c;
+		cur->detail = (cs_detail *)((uint8_t *)(total + max) + c * stride);
+
+		next_offset = disasm_one(handle, &level, &mci, cur, code + pos,
+				size - pos, address + pos, code, size, address);
+		if (!next_offset)
+			break;
+
+		c++;
+		pos += next_offset;
+
+		if (ended) {
+			if (delay_slots)
+				delay_slots--;
+			if (!delay_slots && !handle->ITBlock.size)
+				break;
+			continue;
+		}
+
+		// data in SKIPDATA mode has no detail
+		if (!cur->detail)
+			continue;
+
+		block->end = block_end(handle, cur);
+		if (block->end == CS_BLOCK_END_NONE)
+			continue;
+
+		if (block->end == CS_BLOCK_END_JUMP ||
+		    block->end == CS_BLOCK_END_CALL)
+			block->has_target = block_target(handle, cur,
+					&block->target);
+
+		// the delay slot and the rest of an ARM IT block belong to
+		// the same block
+		ended = true;
+		delay_slots = block_delay_slot(handle, cur) ? 1 : 0;
+		if (!delay_slots && !handle->ITBlock.size)
+			break;
+	}
+
+	if (!c) {
+		cs_mem_free(total);
+		return 0;
+	}
+
+	// keep only the details the caller asked for
+	used = 0;
+	for (i = 0; i < c; i++) {
+		cs_detail *detail = total[i].detail;
+
+		if (!detail)
+			continue;
+
+		if (!detail_opt) {
+			total[i].detail = NULL;
+			continue;
+		}
+
+		if (compact) {
+			// records never grow, so they only move down
+			size_t n = detail_pack(handle, detail);
+
+			memmove((uint8_t *)(total + max) + used, detail, n);
+			used += n;
+		}
+	}
+	if (detail_opt && !compact)
+		used = c * stride;
+
+	block->insn = resize_insns(total, c, max, c, used, used,
+			compact ? 0 : stride);
+	block->count = c;
+	block->next = address + pos;
+
+	return c;
+#endif
+}
+
+#ifdef CAPSTONE_HAS_THREADS
+// don't bother spawning threads for less code than this per thread
+#define PARALLEL_MIN_CHUNK (16 * 1024)
+
+// one piece of the buffer decoded by cs_disasm_parallel()
+struct disasm_chunk {
+	cs_struct *handle;
+	void (*run)(struct disasm_chunk *chunk);
+	const uint8_t *code;
+	size_t size;
+	uint64_t address;
+	size_t offset;		// offset of this chunk in the whole buffer
+	size_t limit;		// only insns starting in the first @limit bytes belong to it
+	cs_insn *insn;		// first slot for this chunk
+	uint8_t *detail;	// first detail slot for this chunk (or NULL)
+	size_t stride;		// bytes of one detail slot
+	size_t max;		// number of slots of this chunk
+	size_t count;		// number of decoded insns
+	bool stopped;		// decoding stopped on an invalid insn inside the chunk
+};
+
+static void disasm_chunk(struct disasm_chunk *chunk)
+{
+	chunk->count = disasm_into(chunk->handle, &chunk->code, &chunk->size,
+			&chunk->address, chunk->insn, chunk->detail, chunk->stride,
+			chunk->max);
+}
+
+// make room for @n more insns in the slots of @chunk.
+// The slots are a block like the one of cs_disasm().
+static bool reserve_insns(struct disasm_chunk *chunk, size_t n)
+{
+	size_t max;
+	cs_insn *tmp;
+
+	if (chunk->count + n <= chunk->max)
+		return true;
+
+	max = chunk->max * 8 / 5; // * 1.6 ~ golden ratio, like cs_disasm()
+	if (max < chunk->count + n)
+		max = chunk->count + n + INSN_CACHE_SIZE;
+
+	if (!chunk->insn) {
+		tmp = cs_mem_malloc(max * (sizeof(cs_insn) + chunk->stride));
+	} else {
+		tmp = resize_insns(chunk->insn, chunk->count, chunk->max, max,
+				chunk->count * chunk->stride, max * chunk->stride,
+				chunk->stride);
+	}
+	if (!tmp)
+		return false;
+
+	chunk->insn = tmp;
+	chunk->detail = chunk->stride ? (uint8_t *)(tmp + max) : NULL;
+	chunk->max = max;
+
+	return true;
+}
+
+// decode all insns starting in the first @limit bytes of the chunk.
+// The number of insns is not known up front, so the chunk owns its slots
+// and grows them on demand.
+static void sweep_chunk(struct disasm_chunk *chunk)
+{
+	uint64_t start = chunk->address;
+	size_t n, want;
+
+	// x86 insns are 4 bytes on average
+	if (!reserve_insns(chunk, chunk->limit / 4)) {
+		chunk->handle->errnum = CS_ERR_MEM;
+		return;
+	}
+
+	while (chunk->size && chunk->address - start < chunk->limit) {
+		uint8_t *detail;
+
+		if (!reserve_insns(chunk, 1)) {
+			chunk->handle->errnum = CS_ERR_MEM;
+			return;
+		}
+
+		want = chunk->max - chunk->count;
+		detail = chunk->detail ?
+			chunk->detail + chunk->count * chunk->stride : NULL;
+		n = disasm_into(chunk->handle, &chunk->code, &chunk->size,
+				&chunk->address, chunk->insn + chunk->count,
+				detail, chunk->stride, want);
+		chunk->count += n;
+		if (n < want)
+			break;
+	}
+
+	chunk->stopped = chunk->size && chunk->address - start < chunk->limit;
+
+	// drop the insns which belong to the next chunk
+	while (chunk->count && chunk->insn[chunk->count - 1].address - start >= chunk->limit)
+		chunk->count--;
+}
+
+#ifdef _WIN32
+typedef HANDLE cs_thread_t;
+
+static DWORD WINAPI chunk_thread(LPVOID arg)
+{
+	struct disasm_chunk *chunk = (struct disasm_chunk *)arg;
+
+	chunk->run(chunk);
+	return 0;
+}
+
+static bool thread_start(cs_thread_t *t, struct disasm_chunk *chunk)
+{
+	*t = CreateThread(NULL, 0, chunk_thread, chunk, 0, NULL);
+	return *t != NULL;
+}
+
+static void thread_join(cs_thread_t t)
+{
+	WaitForSingleObject(t, INFINITE);
+	CloseHandle(t);
+}
+#else
+typedef pthread_t cs_thread_t;
+
+static void *chunk_thread(void *arg)
+{
+	struct disasm_chunk *chunk = (struct disasm_chunk *)arg;
+
+	chunk->run(chunk);
+	return NULL;
+}
+
+static bool thread_start(cs_thread_t *t, struct disasm_chunk *chunk)
+{
+	return pthread_create(t, NULL, chunk_thread, chunk) == 0;
+}
+
+static void thread_join(cs_thread_t t)
+{
+	pthread_join(t, NULL);
+}
+#endif
+
+// run all @chunks, the first one on the calling thread with @handle itself,
+// every other one on a worker with its own copy of @handle.
+// Return false if memory for the workers is missing.
+static bool run_chunks(cs_struct *handle, struct disasm_chunk *chunks,
+		size_t nchunks)
+{
+	cs_thread_t *threads;
+	bool *started;
+	size_t i;
+	csh clone;
+
+	threads = cs_mem_calloc(nchunks, sizeof(*threads));
+	started = cs_mem_calloc(nchunks, sizeof(*started));
+	if (!threads || !started) {
+		cs_mem_free(threads);
+		cs_mem_free(started);
+		return false;
+	}
+
+	chunks[0].handle = handle;
+	for (i = 1; i < nchunks; i++) {
+		if (cs_clone((csh)handle, &clone) == CS_ERR_OK) {
+			chunks[i].handle = (cs_struct *)clone;
+			started[i] = thread_start(&threads[i], &chunks[i]);
+		} else
+			// decode it here instead, after the first chunk
+			chunks[i].handle = handle;
+	}
+	handle->errnum = CS_ERR_OK;
+
+	chunks[0].run(&chunks[0]);
+	for (i = 1; i < nchunks; i++) {
+		if (started[i])
+			thread_join(threads[i]);
+		else
+			chunks[i].run(&chunks[i]);
+	}
+
+	// keep the first error of the workers
+	for (i = 1; i < nchunks; i++) {
+		if (chunks[i].handle == handle)
+			continue;
+		if (chunks[i].handle->errnum != CS_ERR_OK && handle->errnum == CS_ERR_OK)
+			handle->errnum = chunks[i].handle->errnum;
+		clone = (csh)chunks[i].handle;
+		cs_close(&clone);
+		chunks[i].handle = handle;
+	}
+
+	cs_mem_free(threads);
+	cs_mem_free(started);
+
+	return true;
+}
+
+// hand the first @c insns in @total, a block with @slots slots of
+// @stride detail bytes, over to the caller
+static size_t disasm_result(cs_insn *total, size_t c, size_t slots,
+		size_t stride, cs_insn **insn)
+{
+	if (!c) {
+		cs_mem_free(total);
+		*insn = NULL;
+		return 0;
+	}
+
+	*insn = resize_insns(total, c, slots, c, c * stride, c * stride, stride);
+
+	return c;
+}
+
+// fixed-width insns: the boundaries are known up front, so every chunk
+// decodes exactly the insns cs_disasm() would, right into the final slots.
+static size_t disasm_fixed(cs_struct *handle, const uint8_t *code,
+		size_t code_size, uint64_t address, size_t nthreads, uint8_t width,
+		cs_insn **insn)
+{
+	struct disasm_chunk *chunks;
+	cs_insn *total;
+	uint8_t *details;
+	size_t stride = handle->detail_opt ? handle->detail_size : 0;
+	size_t slots, chunk_size, c, i;
+
+	// every insn gets its slot up front, so the chunks can be decoded
+	// in place and need no copy afterwards.
+	slots = code_size / width;
+	total = cs_mem_malloc(slots * (sizeof(cs_insn) + stride));
+	chunks = cs_mem_calloc(nthreads, sizeof(*chunks));
+	if (!total || !chunks) {
+		cs_mem_free(chunks);
+		handle->errnum = CS_ERR_MEM;
+		return disasm_result(total, 0, slots, stride, insn);
+	}
+	details = (uint8_t *)(total + slots);
+
+	// split at instruction boundaries. The last chunk gets the rest,
+	// including trailing bytes too short for an instruction.
+	chunk_size = slots / nthreads * width;
+	for (i = 0; i < nthreads; i++) {
+		size_t first = i * (chunk_size / width);
+
+		chunks[i].run = disasm_chunk;
+		chunks[i].code = code + i * chunk_size;
+		chunks[i].address = address + i * chunk_size;
+		chunks[i].size = i == nthreads - 1 ? code_size - i * chunk_size : chunk_size;
+		chunks[i].insn = total + first;
+		chunks[i].detail = details + first * stride;
+		chunks[i].stride = stride;
+		chunks[i].max = i == nthreads - 1 ? slots - first : chunk_size / width;
+	}
+
+	if (!run_chunks(handle, chunks, nthreads)) {
+		cs_mem_free(chunks);
+		handle->errnum = CS_ERR_MEM;
+		return disasm_result(total, 0, slots, stride, insn);
+	}
+
+	// concatenate in address order. Like cs_disasm(), the result ends
+	// at the first chunk which stopped on an invalid instruction.
+	c = 0;
+	for (i = 0; i < nthreads; i++) {
+		if (c == (size_t)(chunks[i].insn - total))
+			c += chunks[i].count;
+	}
+
+	cs_mem_free(chunks);
+
+	return disasm_result(total, c, slots, stride, insn);
+}
+
+// append the insns of @chunk from index @first on to @out
+static bool splice_chunk(struct disasm_chunk *out, struct disasm_chunk *chunk,
+		size_t first)
+{
+	size_t n = chunk->count - first;
+	const cs_insn *last = &chunk->insn[chunk->count - 1];
+	size_t skip = (size_t)(last->address + last->size - out->address);
+
+	if (!reserve_insns(out, n))
+		return false;
+
+	// the details are rebased when the result is handed out
+	memcpy(out->insn + out->count, chunk->insn + first, n * sizeof(cs_insn));
+	if (out->detail)
+		memcpy(out->detail + out->count * out->stride,
+				chunk->detail + first * chunk->stride, n * out->stride);
+	out->count += n;
+
+	out->code += skip;
+	out->size -= skip;
+	out->address += skip;
+
+	return true;
+}
+
+// variable-width insns: every chunk is decoded speculatively from its first
+// byte, which might be in the middle of an insn. The exact insn stream in
+// @out then runs through the chunks. Where it does not hit an insn start of
+// the next chunk, it is decoded serially until both converge. For x86 this
+// self-synchronization happens within a few instructions.
+static size_t disasm_sweep(cs_struct *handle, const uint8_t *code,
+		size_t code_size, uint64_t address, size_t count, size_t nthreads,
+		cs_insn **insn)
+{
+	struct disasm_chunk *chunks, *chunk;
+	struct disasm_chunk out = { 0 };
+	size_t stride = handle->detail_opt ? handle->detail_size : 0;
+	size_t chunk_size, end, pos, i, j;
+	// insns starting right before the end of a chunk must be complete
+	size_t pad = 16 + handle->skipdata_size;
+
+	chunks = cs_mem_calloc(nthreads, sizeof(*chunks));
+	if (!chunks) {
+		handle->errnum = CS_ERR_MEM;
+		*insn = NULL;
+		return 0;
+	}
+
+	chunk_size = code_size / nthreads;
+	for (i = 0; i < nthreads; i++) {
+		chunks[i].run = sweep_chunk;
+		chunks[i].handle = handle;
+		chunks[i].stride = stride;
+		chunks[i].offset = i * chunk_size;
+		chunks[i].limit = i == nthreads - 1 ? code_size - i * chunk_size : chunk_size;
+		chunks[i].code = code + chunks[i].offset;
+		chunks[i].address = address + chunks[i].offset;
+		chunks[i].size = code_size - chunks[i].offset;
+		if (chunks[i].size > chunks[i].limit + pad)
+			chunks[i].size = chunks[i].limit + pad;
+	}
+
+	out.handle = handle;
+	out.stride = stride;
+	out.code = code;
+	out.size = code_size;
+	out.address = address;
+
+	if (!run_chunks(handle, chunks, nthreads))
+		handle->errnum = CS_ERR_MEM;
+	if (handle->errnum != CS_ERR_OK)
+		goto out;
+
+	for (i = 0; i < nthreads; i++) {
+		chunk = &chunks[i];
+		end = chunk->offset + chunk->limit;
+		j = 0;
+
+		while ((pos = (size_t)(out.address - address)) < end) {
+			if (count && out.count >= count)
+				goto out;
+
+			while (j < chunk->count && (size_t)(chunk->insn[j].address - address) < pos)
+				j++;
+
+			if (j < chunk->count && chunk->insn[j].address == out.address) {
+				// in sync: the rest of the chunk is what cs_disasm() gets
+				if (!splice_chunk(&out, chunk, j)) {
+					handle->errnum = CS_ERR_MEM;
+					goto out;
+				}
+				if (chunk->stopped)
+					goto out;
+				break;
+			}
+
+			if (!reserve_insns(&out, 1)) {
+				handle->errnum = CS_ERR_MEM;
+				goto out;
+			}
+			if (!disasm_into(handle, &out.code, &out.size,
+						&out.address, out.insn + out.count,
+						out.detail ? out.detail +
+						out.count * stride : NULL,
+						stride, 1))
+				// invalid insn, cs_disasm() stops here as well
+				goto out;
+			out.count++;
+		}
+	}
+
+out:
+	for (i = 0; i < nthreads; i++)
+		cs_mem_free(chunks[i].insn);
+	cs_mem_free(chunks);
+
+	if (handle->errnum == CS_ERR_MEM)
+		out.count = 0;
+	if (count && out.count > count)
+		out.count = count;
+
+	return disasm_result(out.insn, out.count, out.max, stride, insn);
+}
+#endif
+
+// multi-threaded disassembling
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_parallel(csh ud, const uint8_t *code,
+		size_t code_size, uint64_t address, size_t count, size_t nthreads,
+		cs_insn **insn)
+{
+#ifdef CAPSTONE_HAS_THREADS
+	struct cs_struct *handle;
+	uint8_t width;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle || !insn)
+		return 0;
+
+	// the SKIPDATA callback sees the whole buffer, so it can't be split.
+	// compact details don't have a fixed slot to be decoded into.
+	if ((handle->skipdata && handle->skipdata_setup.callback) ||
+			handle->detail_compact)
+		return cs_disasm(ud, code, code_size, address, count, insn);
+
+	width = fixed_insn_size(handle);
+	if (width) {
+		// data skipped in SKIPDATA mode must keep the boundaries aligned
+		if (handle->skipdata && handle->skipdata_size != width)
+			return cs_disasm(ud, code, code_size, address, count, insn);
+		if (count > 0 && count < code_size / width)
+			code_size = count * width;
+	} else if (handle->arch == CS_ARCH_X86) {
+		// no need to look further than @count of the longest insns
+		size_t longest = handle->skipdata_size > 15 ? handle->skipdata_size : 15;
+		if (count > 0 && count < code_size / longest)
+			code_size = count * longest;
+	} else {
+		// insn boundaries depend on decoder state (like ARM IT blocks)
+		return cs_disasm(ud, code, code_size, address, count, insn);
+	}
+
+	if (nthreads > code_size / PARALLEL_MIN_CHUNK)
+		nthreads = code_size / PARALLEL_MIN_CHUNK;
+	if (nthreads < 2)
+		return cs_disasm(ud, code, code_size, address, count, insn);
+
+	handle->errnum = CS_ERR_OK;
+
+	if (width)
+		return disasm_fixed(handle, code, code_size, address, nthreads, width, insn);
+
+	return disasm_sweep(handle, code, code_size, address, count, nthreads, insn);
+#else
+	// no thread support in this build
+	return cs_disasm(ud, code, code_size, address, count, insn);
+#endif
+}
+
+// length-only decoding
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_insn_size(csh ud, const uint8_t *code, size_t code_size,
+		uint64_t address)
+{
+	struct cs_struct *handle;
+	uint16_t insn_size = 0;
+	cs_insn insn = { 0 };
+	MCInst *mci;
+	uint8_t fixed;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return 0;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	if (!code || !code_size)
+		return 0;
+
+	fixed = fixed_insn_size(handle);
+	if (fixed)
+		return code_size < fixed ? 0 : fixed;
+
+	if (handle->insn_size)
+		return handle->insn_size(handle, code, code_size);
+
+	// no length rule for this arch, so decode the insn, but skip
+	// the detail, the id mapping and the printer.
+	mci = &handle->iter_mci;
+	MCInst_Init(mci, handle->arch);
+	mci->csh = handle;
+	mci->detail_opt = CS_OPT_OFF;
+	mci->detail_parts = CS_OPT_OFF;
+	mci->address = address;
+	mci->flat_insn = &insn;
+	insn.address = address;
+
+	if (!handle->disasm(ud, code, code_size, mci, &insn_size, address, handle->getinsn_info))
+		insn_size = 0;
+
+	return insn_size;
+}
+
+// print the text of an insn decoded without it
+CAPSTONE_EXPORT
+bool CAPSTONE_API cs_insn_format(csh ud, const cs_insn *insn, char *buf)
+{
+	struct cs_struct *handle;
+#ifndef CAPSTONE_DIET
+	ARM_ITBlock it_block;
+	ARM_VPTBlock vpt_block;
+	bool no_text;
+	cs_insn tmp;
+	uint16_t insn_size;
+	size_t len;
+	MCInst *mci;
+	SStream ss;
+	bool r;
+#endif
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+	if (!handle) {
+		return false;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	if (!insn || !buf)
+		return false;
+
+	buf[0] = '\0';
+
+#ifdef CAPSTONE_DIET
+	// no text in DIET mode
+	handle->errnum = CS_ERR_DIET;
+	return false;
+#else
+	// the text is there already (text mode or SKIPDATA)
+	if (insn->mnemonic[0]) {
+		tmp = *insn;
+		r = true;
+	} else {
+		// decode the bytes of the insn again, this time with the printer,
+		// but without the detail. The insn is decoded in the Arm IT or
+		// VPT state it was decoded in first. The block state of the
+		// handle is kept, as the caller might be in the middle of a
+		// buffer.
+		mci = &handle->iter_mci;
+		MCInst_Init(mci, handle->arch);
+		mci->csh = handle;
+		mci->detail_opt = CS_OPT_OFF;
+		mci->detail_parts = CS_OPT_OFF;
+		mci->address = insn->address;
+		mci->flat_insn = &tmp;
+		tmp.address = insn->address;
+		tmp.detail = NULL;
+
+		no_text = handle->no_text;
+		it_block = handle->ITBlock;
+		vpt_block = handle->VPTBlock;
+		handle->no_text = false;
+		insn_load_pred_block(handle, insn);
+
+		r = handle->disasm(ud, insn->bytes, insn->size, mci, &insn_size,
+				insn->address, handle->getinsn_info);
+		if (r) {
+			insn_stream_init(handle, &ss);
+			tmp.size = insn_size;
+			handle->insn_id(mci, &tmp, mci->Opcode);
+			handle->printer(mci, &ss, handle->printer_info);
+			fill_insn(handle, &tmp, &ss, mci, handle->post_printer,
+					insn->bytes);
+		}
+
+		handle->no_text = no_text;
+		handle->ITBlock = it_block;
+		handle->VPTBlock = vpt_block;
+	}
+
+	if (!r)
+		return false;
+
+	// "mnemonic op_str", which fits as both parts are terminated
+	len = strlen(tmp.mnemonic);
+	memcpy(buf, tmp.mnemonic, len);
+	if (tmp.op_str[0]) {
+		buf[len++] = ' ';
+		memcpy(buf + len, tmp.op_str, strlen(tmp.op_str) + 1);
+	} else
+		buf[len] = '\0';
+
+	return true;
+#endif
+}
+
+// return friendly name of register in a string
+CAPSTONE_EXPORT
+const char * CAPSTONE_API cs_reg_name(csh ud, unsigned int reg)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle || handle->reg_name == NULL) {
+		return NULL;
+	}
+
+	return handle->reg_name(ud, reg);
+}
+
+CAPSTONE_EXPORT
+const char * CAPSTONE_API cs_insn_name(csh ud, unsigned int insn)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle || handle->insn_name == NULL) {
+		return NULL;
+	}
+
+	return handle->insn_name(ud, insn);
+}
+
+CAPSTONE_EXPORT
+const char * CAPSTONE_API cs_group_name(csh ud, unsigned int group)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle || handle->group_name == NULL) {
+		return NULL;
+	}
+
+	return handle->group_name(ud, group);
+}
+
+// the lists of a detail, either a cs_detail or a compact one
+static const uint16_t *detail_regs_read(const cs_struct *handle,
+		const cs_insn *insn, uint8_t *count)
+{
+	const cs_packed_detail *pd = (const cs_packed_detail *)insn->detail;
+
+	if (!handle->detail_compact) {
+		*count = insn->detail->regs_read_count;
+		return insn->detail->regs_read;
+	}
+
+	*count = pd->regs_read_count;
+	return (const uint16_t *)((const uint8_t *)(pd + 1) +
+			pd->op_count * detail_layouts[handle->arch].op_size);
+}
+
+static const uint16_t *detail_regs_write(const cs_struct *handle,
+		const cs_insn *insn, uint8_t *count)
+{
+	const cs_packed_detail *pd = (const cs_packed_detail *)insn->detail;
+	const uint16_t *regs_read;
+	uint8_t n;
+
+	if (!handle->detail_compact) {
+		*count = insn->detail->regs_write_count;
+		return insn->detail->regs_write;
+	}
+
+	regs_read = detail_regs_read(handle, insn, &n);
+	*count = pd->regs_write_count;
+	return regs_read + n;
+}
+
+static const uint8_t *detail_groups(const cs_struct *handle,
+		const cs_insn *insn, uint8_t *count)
+{
+	const cs_packed_detail *pd = (const cs_packed_detail *)insn->detail;
+	const uint16_t *regs_write;
+	uint8_t n;
+
+	if (!handle->detail_compact) {
+		*count = insn->detail->groups_count;
+		return insn->detail->groups;
+	}
+
+	regs_write = detail_regs_write(handle, insn, &n);
+	*count = pd->groups_count;
+	return (const uint8_t *)(regs_write + n);
+}
+
+// With CS_OPT_DETAIL_COMPACT, return a copy of @insn, whose detail is
+// expanded into @detail. The APIs which read cs_detail work on that copy.
+static const cs_insn *insn_unpacked(const cs_struct *handle,
+		const cs_insn *insn, cs_insn *copy, cs_detail *detail)
+{
+	if (!handle->detail_compact)
+		return insn;
+
+	*copy = *insn;
+	copy->detail = detail;
+	detail_unpack(handle, (const cs_packed_detail *)insn->detail, detail);
+
+	return copy;
+}
+
+CAPSTONE_EXPORT
+bool CAPSTONE_API cs_insn_group(csh ud, const cs_insn *insn, unsigned int group_id)
+{
+	struct cs_struct *handle;
+	const uint8_t *groups;
+	uint8_t count;
+	if (!ud)
+		return false;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle->detail_opt) {
+		handle->errnum = CS_ERR_DETAIL;
+		return false;
+	}
+
+	if (!insn->id) {
+		handle->errnum = CS_ERR_SKIPDATA;
+		return false;
+	}
+
+	if (!insn->detail) {
+		handle->errnum = CS_ERR_DETAIL;
+		return false;
+	}
+
+	groups = detail_groups(handle, insn, &count);
+
+	return arr_exist8(groups, count, group_id);
+}
+
+CAPSTONE_EXPORT
+bool CAPSTONE_API cs_reg_read(csh ud, const cs_insn *insn, unsigned int reg_id)
+{
+	struct cs_struct *handle;
+	const uint16_t *regs;
+	uint8_t count;
+	if (!ud)
+		return false;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle->detail_opt) {
 		handle->errnum = CS_ERR_DETAIL;
 		return false;
 	}
@@ -1602,13 +3414,17 @@ bool CAPSTONE_API cs_reg_read(csh ud, const cs_insn *insn, unsigned int reg_id)
 		return false;
 	}
 
-	return arr_exist(insn->detail->regs_read, insn->detail->regs_read_count, reg_id);
+	regs = detail_regs_read(handle, insn, &count);
+
+	return arr_exist(regs, count, reg_id);
 }
 
 CAPSTONE_EXPORT
 bool CAPSTONE_API cs_reg_write(csh ud, const cs_insn *insn, unsigned int reg_id)
 {
 	struct cs_struct *handle;
+	const uint16_t *regs;
+	uint8_t count;
 	if (!ud)
 		return false;
 
@@ -1629,7 +3445,9 @@ bool CAPSTONE_API cs_reg_write(csh ud, const cs_insn *insn, unsigned int reg_id)
 		return false;
 	}
 
-	return arr_exist(insn->detail->regs_write, insn->detail->regs_write_count, reg_id);
+	regs = detail_regs_write(handle, insn, &count);
+
+	return arr_exist(regs, count, reg_id);
 }
 
 CAPSTONE_EXPORT
@@ -1637,6 +3455,8 @@ int CAPSTONE_API cs_op_count(csh ud, const cs_insn *insn, unsigned int op_type)
 {
 	struct cs_struct *handle;
 	unsigned int count = 0, i;
+	cs_insn copy;
+	cs_detail detail;
 	if (!ud)
 		return -1;
 
@@ -1658,6 +3478,7 @@ int CAPSTONE_API cs_op_count(csh ud, const cs_insn *insn, unsigned int op_type)
 	}
 
 	handle->errnum = CS_ERR_OK;
+	insn = insn_unpacked(handle, insn, &copy, &detail);
 
 	switch (handle->arch) {
 		default:
@@ -1771,6 +3592,8 @@ int CAPSTONE_API cs_op_index(csh ud, const cs_insn *insn, unsigned int op_type,
 {
 	struct cs_struct *handle;
 	unsigned int count = 0, i;
+	cs_insn copy;
+	cs_detail detail;
 	if (!ud)
 		return -1;
 
@@ -1792,6 +3615,7 @@ int CAPSTONE_API cs_op_index(csh ud, const cs_insn *insn, unsigned int op_type,
 	}
 
 	handle->errnum = CS_ERR_OK;
+	insn = insn_unpacked(handle, insn, &copy, &detail);
 
 	switch (handle->arch) {
 		default:
@@ -1978,6 +3802,10 @@ cs_err CAPSTONE_API cs_regs_access(csh ud, const cs_insn *insn,
 		cs_regs regs_write, uint8_t *regs_write_count)
 {
 	struct cs_struct *handle;
+#ifndef CAPSTONE_DIET
+	cs_insn copy;
+	cs_detail detail;
+#endif
 
 	if (!ud)
 		return CS_ERR_CSH;
@@ -2005,6 +3833,7 @@ cs_err CAPSTONE_API cs_regs_access(csh ud, const cs_insn *insn,
 	}
 
 	if (handle->reg_access) {
+		insn = insn_unpacked(handle, insn, &copy, &detail);
 		handle->reg_access(insn, regs_read, regs_read_count, regs_write, regs_write_count);
 	} else {
 		// this arch is unsupported yet
@@ -2015,3 +3844,195 @@ cs_err CAPSTONE_API cs_regs_access(csh ud, const cs_insn *insn,
 	return CS_ERR_OK;
 #endif
 }
+
+// make a cs_regs_bitset of the first @count registers of @regs
+static void regs_bitset(cs_regs_bitset set, const uint16_t *regs, size_t count)
+{
+	size_t i;
+
+	memset(set, 0, sizeof(cs_regs_bitset));
+	for (i = 0; i < count; i++)
+		if (regs[i] < sizeof(cs_regs_bitset) * 8)
+			set[regs[i] >> 6] |= (uint64_t)1 << (regs[i] & 63);
+}
+
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_insn_groups_mask(csh ud, const cs_insn *insn,
+		cs_groups_mask groups)
+{
+	struct cs_struct *handle;
+	const uint8_t *list;
+	uint8_t count, i;
+
+	if (!ud)
+		return CS_ERR_CSH;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!handle->detail_opt) {
+		handle->errnum = CS_ERR_DETAIL;
+		return CS_ERR_DETAIL;
+	}
+
+	if (!insn->id) {
+		handle->errnum = CS_ERR_SKIPDATA;
+		return CS_ERR_SKIPDATA;
+	}
+
+	if (!insn->detail) {
+		handle->errnum = CS_ERR_DETAIL;
+		return CS_ERR_DETAIL;
+	}
+
+	memset(groups, 0, sizeof(cs_groups_mask));
+	list = detail_groups(handle, insn, &count);
+	for (i = 0; i < count; i++)
+		groups[list[i] >> 6] |= (uint64_t)1 << (list[i] & 63);
+
+	return CS_ERR_OK;
+}
+
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_regs_access_bitset(csh ud, const cs_insn *insn,
+		cs_regs_bitset regs_read, cs_regs_bitset regs_write)
+{
+	cs_regs read, write;
+	uint8_t read_count, write_count;
+	cs_err err;
+
+	err = cs_regs_access(ud, insn, read, &read_count, write, &write_count);
+	if (err != CS_ERR_OK)
+		return err;
+
+	regs_bitset(regs_read, read, read_count);
+	regs_bitset(regs_write, write, write_count);
+
+	return CS_ERR_OK;
+}
+
+// check that @insn has a detail to read, set the error of @handle if not
+static bool detail_readable(cs_struct *handle, const cs_insn *insn)
+{
+	if (!handle->detail_opt) {
+		handle->errnum = CS_ERR_DETAIL;
+		return false;
+	}
+
+	if (!insn->id) {
+		handle->errnum = CS_ERR_SKIPDATA;
+		return false;
+	}
+
+	if (!insn->detail) {
+		handle->errnum = CS_ERR_DETAIL;
+		return false;
+	}
+
+	handle->errnum = CS_ERR_OK;
+
+	return true;
+}
+
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_detail_unpack(csh ud, const cs_insn *insn,
+		cs_detail *detail)
+{
+	struct cs_struct *handle;
+
+	if (!ud)
+		return CS_ERR_CSH;
+
+	handle = (struct cs_struct *)(uintptr_t)ud;
+
+	if (!detail_readable(handle, insn))
+		return handle->errnum;
+
+	if (handle->detail_compact)
+		detail_unpack(handle, (const cs_packed_detail *)insn->detail, detail);
+	else
+		memcpy(detail, insn->detail, detail_layouts[handle->arch].size);
+
+	return CS_ERR_OK;
+}
+
+CAPSTONE_EXPORT
+const uint16_t * CAPSTONE_API cs_detail_regs_read(csh ud, const cs_insn *insn,
+		uint8_t *count)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+
+	*count = 0;
+	if (!handle || !detail_readable(handle, insn))
+		return NULL;
+
+	return detail_regs_read(handle, insn, count);
+}
+
+CAPSTONE_EXPORT
+const uint16_t * CAPSTONE_API cs_detail_regs_write(csh ud, const cs_insn *insn,
+		uint8_t *count)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+
+	*count = 0;
+	if (!handle || !detail_readable(handle, insn))
+		return NULL;
+
+	return detail_regs_write(handle, insn, count);
+}
+
+CAPSTONE_EXPORT
+const uint8_t * CAPSTONE_API cs_detail_groups(csh ud, const cs_insn *insn,
+		uint8_t *count)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+
+	*count = 0;
+	if (!handle || !detail_readable(handle, insn))
+		return NULL;
+
+	return detail_groups(handle, insn, count);
+}
+
+CAPSTONE_EXPORT
+int CAPSTONE_API cs_detail_op_count(csh ud, const cs_insn *insn)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	const cs_detail_layout *l;
+
+	if (!handle || !detail_readable(handle, insn))
+		return -1;
+
+	if (handle->detail_compact)
+		return ((const cs_packed_detail *)insn->detail)->op_count;
+
+	l = &detail_layouts[handle->arch];
+	if (!l->op_size)
+		return 0;
+
+	return ((const uint8_t *)insn->detail)[l->op_count];
+}
+
+CAPSTONE_EXPORT
+const void * CAPSTONE_API cs_detail_op(csh ud, const cs_insn *insn,
+		unsigned int index)
+{
+	struct cs_struct *handle = (struct cs_struct *)(uintptr_t)ud;
+	const cs_detail_layout *l;
+	int count = cs_detail_op_count(ud, insn);
+
+	if (count < 0)
+		return NULL;
+
+	if (index >= (unsigned int)count) {
+		handle->errnum = CS_ERR_OPTION;
+		return NULL;
+	}
+
+	l = &detail_layouts[handle->arch];
+	if (handle->detail_compact)
+		return (const uint8_t *)((const cs_packed_detail *)insn->detail + 1) +
+			index * l->op_size;
+
+	return (const uint8_t *)insn->detail + l->ops + index * l->op_size;
+}
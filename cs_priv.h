@@ -22,13 +22,24 @@ typedef bool (*Disasm_t)(csh handle, const uint8_t *code, size_t code_len, MCIns
 
 typedef const char *(*GetName_t)(csh handle, unsigned int id);
 
-typedef void (*GetID_t)(cs_struct *h, cs_insn *insn, unsigned int id);
+typedef void (*GetID_t)(MCInst *MI, cs_insn *insn, unsigned int id);
+
+// return the length of the insn at @code, or 0 if there is none.
+// The encoding is only checked as far as needed to get the length.
+typedef uint16_t (*GetInsnSize_t)(cs_struct *h, const uint8_t *code, size_t code_len);
 
 // return registers accessed by instruction
 typedef void (*GetRegisterAccess_t)(const cs_insn *insn,
 		cs_regs regs_read, uint8_t *regs_read_count,
 		cs_regs regs_write, uint8_t *regs_write_count);
 
+// return true if @feature is enabled in @mode.
+typedef bool (*GetFeatureBits_t)(unsigned int mode, unsigned int feature);
+
+// The feature bitset of cs_struct holds up to CS_MAX_FEATURES features.
+// It must be at least the <ARCH>_NumSubtargetFeatures of every architecture.
+#define CS_MAX_FEATURES 320
+
 // for ARM only
 typedef struct ARM_ITBlock {
 	unsigned char ITStates[8];
@@ -58,6 +69,7 @@ struct cs_struct {
 	cs_mode mode;
 	Printer_t printer;	// asm printer
 	void *printer_info; // aux info for printer
+	size_t printer_info_size; ///< Size of printer_info if the handle owns it. 0 if it is shared (like the MCRegisterInfo).
 	Disasm_t disasm;	// disassembler
 	void *getinsn_info; // auxiliary info for printer
 	GetName_t reg_name;
@@ -65,16 +77,26 @@ struct cs_struct {
 	GetName_t group_name;
 	GetID_t insn_id;
 	PostPrinter_t post_printer;
+	GetInsnSize_t insn_size;	// length-only decoder for cs_insn_size() (optional)
+	GetFeatureBits_t feature_bits_of;	// feature test of a mode (optional)
+	unsigned int num_features;	// number of features feature_bits_of() knows
+	uint16_t *alias_idx;	///< Indexed by opcode: position + 1 of the opcode in the alias table alias_idx_of, 0 if it has no aliases. Built by matchAliasPatterns() on first use.
+	size_t alias_idx_size;	///< Number of entries of alias_idx.
+	const void *alias_idx_of;	///< The OpToPatterns table alias_idx indexes.
+	uint64_t feature_bits[CS_MAX_FEATURES / 64]; ///< The features of the current mode, computed by feature_bits_of() whenever the mode changes. See CS_hasFeature().
 	cs_err errnum;
 	ARM_ITBlock ITBlock;	// for Arm only
 	ARM_VPTBlock VPTBlock;  // for ARM only
 	bool PrintBranchImmAsAddress;
 	bool ShowVSRNumsAsVR;
 	cs_opt_value detail_opt, imm_unsigned;
+	uint16_t detail_size;	///< Bytes of cs_detail used by the arch. Only that much is allocated for every insn.
+	bool detail_compact;	///< CS_OPT_DETAIL_COMPACT. Kept out of detail_opt, which the printers compare to CS_OPT_ON.
+	cs_opt_value detail_parts;	///< CS_OPT_DETAIL_<part> values of the parts to fill. 0 if detail is off.
+	bool no_text;	///< CS_OPT_NO_TEXT: Don't fill mnemonic and op_str.
 	int syntax;	// asm syntax for simple printer such as ARM, Mips & PPC
 	bool doing_mem;	// handling memory operand in InstPrinter code
 	bool doing_SME_Index; // handling a SME instruction that has index
-	unsigned short *insn_cache;	// index caching for mapping.c
 	bool skipdata;	// set this to True if we skip data when disassembling
 	uint8_t skipdata_size;	// how many bytes to skip
 	cs_opt_skipdata skipdata_setup;	// user-defined skipdata setup
@@ -82,10 +104,16 @@ struct cs_struct {
 	GetRegisterAccess_t reg_access;
 	struct insn_mnem *mnem_list;	// linked list of customized instruction mnemonic
 	uint32_t LITBASE; ///< The LITBASE register content. Bit 0 (LSB) indicatess if it is set. Bit[23:8] are the literal base address.
+	MCInst iter_mci; ///< MCInst reused by cs_disasm_iter(), so it is not set up on the stack for every call.
 };
 
 #define MAX_ARCH CS_ARCH_MAX
 
+// all parts of the detail which CS_OPT_DETAIL can select
+#define CS_DETAIL_PARTS \
+	(CS_OPT_DETAIL_GROUPS | CS_OPT_DETAIL_OPERANDS | \
+	 CS_OPT_DETAIL_IMPLICIT_REGS | CS_OPT_DETAIL_ARCH_EXTRA)
+
 // Returns a bool (0 or 1) whether big endian is enabled for a mode
 #define MODE_IS_BIG_ENDIAN(mode) (((mode) & CS_MODE_BIG_ENDIAN) != 0)
 
@@ -138,4 +166,14 @@ do { \
 } while(0)
 #endif
 
+/// Returns true if @feature is enabled in the current mode of @handle.
+/// It only tests a bit of the feature bitset of the handle.
+static inline bool CS_hasFeature(const cs_struct *handle, unsigned int feature)
+{
+	CS_ASSERT(feature < CS_MAX_FEATURES);
+	return (handle->feature_bits[feature / 64] >> (feature % 64)) & 1;
+}
+
+void CS_updateFeatureBits(cs_struct *handle);
+
 #endif
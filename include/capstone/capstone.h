@@ -266,12 +266,13 @@ typedef enum cs_opt_type {
 	CS_OPT_UNSIGNED,       ///< print immediate operands in unsigned form
 	CS_OPT_ONLY_OFFSET_BRANCH, ///< ARM, PPC, AArch64: Don't add the branch immediate value to the PC.
 	CS_OPT_LITBASE, ///< Xtensa, set the LITBASE value. LITBASE is set to 0 by default.
+	CS_OPT_NO_TEXT, ///< Don't emit the asm text. mnemonic and op_str stay empty, only the detail is filled. cs_insn_format() prints the text later.
 } cs_opt_type;
 
 /// Runtime option value (associated with option type above)
 typedef enum cs_opt_value {
-	CS_OPT_OFF = 0,  ///< Turn OFF an option - default for CS_OPT_DETAIL, CS_OPT_SKIPDATA, CS_OPT_UNSIGNED.
-	CS_OPT_ON = 1 << 0, ///< Turn ON an option (CS_OPT_DETAIL, CS_OPT_SKIPDATA).
+	CS_OPT_OFF = 0,  ///< Turn OFF an option - default for CS_OPT_DETAIL, CS_OPT_SKIPDATA, CS_OPT_UNSIGNED, CS_OPT_NO_TEXT.
+	CS_OPT_ON = 1 << 0, ///< Turn ON an option (CS_OPT_DETAIL, CS_OPT_SKIPDATA, CS_OPT_NO_TEXT).
 	CS_OPT_SYNTAX_DEFAULT = 1 << 1, ///< Default asm syntax (CS_OPT_SYNTAX).
 	CS_OPT_SYNTAX_INTEL = 1 << 2, ///< X86 Intel asm syntax - default on X86 (CS_OPT_SYNTAX).
 	CS_OPT_SYNTAX_ATT = 1 << 3,   ///< X86 ATT asm syntax (CS_OPT_SYNTAX).
@@ -282,6 +283,11 @@ typedef enum cs_opt_value {
 	CS_OPT_SYNTAX_PERCENT = 1 << 8, ///< Prints the % in front of PPC registers.
 	CS_OPT_SYNTAX_NO_DOLLAR = 1 << 9, ///< Does not print the $ in front of Mips registers.
 	CS_OPT_DETAIL_REAL = 1 << 1, ///< If enabled, always sets the real instruction detail. Even if the instruction is an alias.
+	CS_OPT_DETAIL_COMPACT = 1 << 2, ///< Store the detail in a compact encoding, without the unused operands and registers. Read it with the cs_detail_*() APIs only.
+	CS_OPT_DETAIL_GROUPS = 1 << 3, ///< Only fill the listed parts of the detail (CS_OPT_DETAIL). Without any CS_OPT_DETAIL_<part>, all parts are filled. Supported by AArch64, ARM, LoongArch, Mips, PPC, SystemZ and X86, cs_option() returns CS_ERR_OPTION for the other archs. This part is groups[].
+	CS_OPT_DETAIL_OPERANDS = 1 << 4, ///< Part of the detail: <arch>.operands[] and <arch>.op_count.
+	CS_OPT_DETAIL_IMPLICIT_REGS = 1 << 5, ///< Part of the detail: regs_read[] and regs_write[]. AArch64, ARM and PPC find some of them with the operands, so they need CS_OPT_DETAIL_OPERANDS too.
+	CS_OPT_DETAIL_ARCH_EXTRA = 1 << 6, ///< Part of the detail: the other fields of <arch> (e.g. X86 prefix, opcode, eflags). Only X86 fills them without the operands, the other archs need CS_OPT_DETAIL_OPERANDS too.
 } cs_opt_value;
 
 /// An option
@@ -486,6 +492,11 @@ typedef struct cs_insn {
 	/// False: The detail operands are from the real instruction.
 	bool usesAliasDetails;
 
+	/// Private, do not use: the Arm IT/VPT block state this instruction
+	/// was decoded in, for cs_insn_format(). It fills the padding before
+	/// @detail, so the size of cs_insn does not change.
+	uint8_t pred_block[3];
+
 	/// Pointer to cs_detail.
 	/// NOTE: detail pointer is only valid when both requirements below are met:
 	/// (1) CS_OP_DETAIL = CS_OPT_ON
@@ -493,6 +504,14 @@ typedef struct cs_insn {
 	///
 	/// NOTE 2: when in Skipdata mode, or when detail mode is OFF, even if this pointer
 	///     is not NULL, its content is still irrelevant.
+	///
+	/// NOTE 3: only the part of cs_detail used by the architecture of the
+	///     handle is allocated, so do not copy the whole structure.
+	///     cs_detail_unpack() copies it into a full cs_detail.
+	///
+	/// NOTE 4: with CS_OPT_DETAIL_COMPACT, this does not point to a
+	///     cs_detail, but to its compact encoding. Use the cs_detail_*()
+	///     APIs to read it.
 	cs_detail *detail;
 } cs_insn;
 
@@ -507,10 +526,10 @@ typedef struct cs_insn {
 /// These are values returned by cs_errno()
 typedef enum cs_err {
 	CS_ERR_OK = 0,   ///< No error: everything was fine
-	CS_ERR_MEM,      ///< Out-Of-Memory error: cs_open(), cs_disasm(), cs_disasm_iter()
+	CS_ERR_MEM,      ///< Out-Of-Memory error: cs_open(), cs_clone(), cs_disasm(), cs_disasm_iter()
 	CS_ERR_ARCH,     ///< Unsupported architecture: cs_open()
 	CS_ERR_HANDLE,   ///< Invalid handle: cs_op_count(), cs_op_index()
-	CS_ERR_CSH,      ///< Invalid csh argument: cs_close(), cs_errno(), cs_option()
+	CS_ERR_CSH,      ///< Invalid csh argument: cs_close(), cs_clone(), cs_errno(), cs_option()
 	CS_ERR_MODE,     ///< Invalid/unsupported mode: cs_open()
 	CS_ERR_OPTION,   ///< Invalid/unsupported option: cs_option()
 	CS_ERR_DETAIL,   ///< Information is unavailable because detail option is OFF
@@ -636,6 +655,26 @@ cs_err CAPSTONE_API cs_open(cs_arch arch, cs_mode mode, csh *handle);
 CAPSTONE_EXPORT
 cs_err CAPSTONE_API cs_close(csh *handle);
 
+/**
+ Create a new handle with the same architecture, mode and options as @src.
+ This is much cheaper than cs_open() plus setting all options again.
+
+ The new handle shares the read-only tables of the architecture with @src.
+ Only state that changes while disassembling (like the last error, or the
+ ARM IT block) is its own. So @src and the new handle can be used by
+ different threads at the same time, and closed in any order.
+
+ NOTE: the new handle must be released with cs_close() as well.
+
+ @src: handle returned by cs_open() or cs_clone()
+ @dst: pointer to the new handle, filled in on success.
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_clone(csh src, csh *dst);
+
 /**
  Set option for disassembling engine at runtime
 
@@ -778,6 +817,233 @@ bool CAPSTONE_API cs_disasm_iter(csh handle,
 	const uint8_t **code, size_t *size,
 	uint64_t *address, cs_insn *insn);
 
+/**
+ Disassemble binary code into instruction and detail arrays provided by the caller.
+ This API does not allocate any memory, so the same buffers can be reused
+ across calls, e.g. one pair per worker thread.
+
+ NOTE 1: like cs_disasm_iter(), this API updates @code, @size & @address to
+ point right after the last instruction written to @insn. So to continue
+ decoding a buffer longer than @count instructions, simply call it again.
+
+ NOTE 2: if the detail option is ON, @detail must have room for @count
+ cs_detail structures. insn[i].detail then points to detail[i] (or is NULL
+ for data in SKIPDATA mode). If the detail option is OFF, @detail can be NULL.
+
+ NOTE 3: the instructions must not be released with cs_free().
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled
+ @size: size of above code
+ @address: address of the first insn in given raw code buffer
+ @insn: array of at least @count instructions to be filled in by this API.
+ @detail: array of at least @count details, or NULL if detail option is OFF.
+ @count: maximum number of instructions to be disassembled.
+
+ @return: the number of instructions written to @insn.
+ This is less than @count if the end of the buffer or an invalid
+ instruction was reached.
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_into(csh handle,
+	const uint8_t **code, size_t *size,
+	uint64_t *address, cs_insn *insn,
+	cs_detail *detail, size_t count);
+
+/// Return value of a cs_disasm_cb() callback
+typedef enum cs_cb_action {
+	CS_CB_CONTINUE = 0, ///< Decode the instruction right after this one.
+	CS_CB_STOP,	    ///< Stop decoding. cs_disasm_cb() returns.
+	CS_CB_SKIP,	    ///< Continue decoding at the address stored in @next.
+} cs_cb_action;
+
+/**
+ User-defined callback function for cs_disasm_cb().
+
+ @handle: handle passed to cs_disasm_cb()
+ @insn: the instruction just decoded. It is only valid during this call,
+	because the same instruction and detail are reused for the next one.
+ @next: address of the instruction right after @insn. With CS_CB_SKIP, the
+	callback stores here the address to continue decoding at, which must lie
+	inside the buffer. Decoding stops otherwise.
+ @user_data: user-data passed to cs_disasm_cb().
+
+ @return: CS_CB_CONTINUE, CS_CB_STOP or CS_CB_SKIP.
+*/
+typedef cs_cb_action (CAPSTONE_API *cs_disasm_cb_t)(csh handle,
+	cs_insn *insn, uint64_t *next, void *user_data);
+
+/**
+ Disassemble binary code and hand every instruction to the callback @cb.
+ Unlike cs_disasm(), no memory is allocated whatever the size of @code, and
+ unlike cs_disasm_iter(), there is no API call for every instruction.
+ The callback can stop decoding or continue at another address inside @code,
+ e.g. to follow branches for a recursive traversal.
+
+ NOTE: an invalid instruction stops decoding, unless SKIPDATA mode is ON. Then
+ the data is handed to @cb like with cs_disasm(), with no detail.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled
+ @size: size of above code
+ @address: address of the first insn in given raw code buffer
+ @cb: callback called for every decoded instruction.
+ @user_data: user-data passed to @cb.
+
+ @return: the number of instructions handed to @cb.
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_cb(csh handle,
+	const uint8_t *code, size_t size,
+	uint64_t address, cs_disasm_cb_t cb, void *user_data);
+
+/// Kind of the control flow instruction which ends a basic block
+typedef enum cs_block_end {
+	CS_BLOCK_END_NONE = 0, ///< No control flow: the end of the buffer or invalid code was reached.
+	CS_BLOCK_END_JUMP,     ///< A jump (CS_GRP_JUMP), conditional or not.
+	CS_BLOCK_END_CALL,     ///< A call (CS_GRP_CALL).
+	CS_BLOCK_END_RET,      ///< A return (CS_GRP_RET).
+	CS_BLOCK_END_IRET,     ///< A return from interrupt (CS_GRP_IRET).
+} cs_block_end;
+
+/// Basic block returned by cs_disasm_block()
+typedef struct cs_block {
+	/// Instructions of the block, to be freed with cs_free(insn, count).
+	/// The control flow instruction is the last one, or the one before a
+	/// delay slot (Mips, Sparc, SH, HPPA).
+	cs_insn *insn;
+	size_t count; ///< Number of instructions in @insn.
+	cs_block_end end; ///< Kind of the control flow instruction.
+	bool has_target; ///< True if the jump or call has a direct target.
+	uint64_t target; ///< Address of the direct target, if @has_target.
+	uint64_t next; ///< Address right after the block, where a conditional jump or a call falls through.
+} cs_block;
+
+/**
+ Disassemble one basic block: the instructions up to and including the first
+ jump, call or return, as well as its delay slot on the architectures which
+ have one (Mips, Sparc, SH, HPPA). An ARM IT block is never split: it does
+ not carry over from previously decoded code, and the block does not end before
+ the last instruction of the IT block.
+
+ NOTE 1: the groups and operands are needed to find the end of the block, so
+ the details of @block->insn always have them when the detail option is on,
+ whatever parts it selects. Without the detail option @block->insn has no
+ details. The other options (e.g. CS_OPT_NO_TEXT) apply as with cs_disasm().
+
+ NOTE 2: the direct targets are resolved for AArch64, ARM, HPPA, LoongArch,
+ M68K, Mips, PPC, RISCV, Sparc, SH, SystemZ and X86.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled
+ @size: size of above code
+ @address: address of the first insn in given raw code buffer
+ @block: basic block filled in by this API.
+
+ @return: the number of instructions in the block, or 0 if the first
+ instruction could not be decoded. This API is not available with the
+ "diet" engine.
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_block(csh handle,
+	const uint8_t *code, size_t size,
+	uint64_t address, cs_block *block);
+
+/**
+ Disassemble binary code like cs_disasm(), but split the work over @nthreads
+ threads. The result is identical to the one of cs_disasm().
+
+ NOTE 1: instruction sets with a fixed instruction width (AArch64, ARM without
+ Thumb, Mips32/64, Sparc, TMS320C64x, Alpha, HPPA, LoongArch, Xtensa) are split
+ at instruction boundaries. X86 code is split at arbitrary offsets and decoded
+ speculatively. The pieces are then joined where the instruction stream of the
+ previous piece meets an instruction of the next one, which usually happens
+ within a few instructions. All other architectures and modes, as well as
+ SKIPDATA mode with a user callback, fall back to cs_disasm().
+
+ NOTE 2: every worker thread decodes its part of @code with its own copy of
+ @handle, so this API does not need any locking from the caller. Small buffers
+ are decoded on the calling thread only.
+
+ NOTE 3: if Capstone is built without thread support, this is the same as cs_disasm().
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code to be disassembled.
+ @code_size: size of the above code buffer.
+ @address: address of the first instruction in given raw code buffer.
+ @count: number of instructions to be disassembled, or 0 to get all of them
+ @nthreads: maximum number of threads to use, including the calling one.
+ @insn: array of instructions filled in by this API.
+	   NOTE: @insn will be allocated by this function, and should be freed
+	   with cs_free() API.
+
+ @return: the number of successfully disassembled instructions,
+ or 0 if this function failed to disassemble the given code
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_disasm_parallel(csh handle,
+		const uint8_t *code, size_t code_size,
+		uint64_t address,
+		size_t count,
+		size_t nthreads,
+		cs_insn **insn);
+
+/**
+ Return the length of the instruction at the start of @code, without
+ disassembling it. No instruction is built, mapped or printed, which makes this
+ much cheaper than cs_disasm_iter() to find instruction boundaries.
+
+ NOTE: for architectures with a length encoding (e.g. SystemZ, RISC-V compressed,
+ Thumb-2) or a fixed instruction width, the instruction is only checked as far
+ as needed to get its length. So a length can be returned for bytes which
+ cs_disasm() would reject. Other architectures decode the instruction fully.
+
+ @handle: handle returned by cs_open()
+ @code: buffer containing raw binary code
+ @code_size: size of above code
+ @address: address of the instruction in given raw code buffer
+
+ @return: the size of the instruction in bytes, or 0 if @code is too short
+ or does not start with a valid instruction.
+*/
+CAPSTONE_EXPORT
+size_t CAPSTONE_API cs_insn_size(csh handle, const uint8_t *code,
+	size_t code_size, uint64_t address);
+
+/**
+ Print the asm text of an instruction, which was disassembled with
+ CS_OPT_NO_TEXT ON. Decoding without text is much faster, so this allows to
+ disassemble a large buffer quickly and to only print the few instructions
+ which are actually shown.
+
+ The instruction is decoded again from its bytes & address, with the
+ options of @handle at the time of this call. The detail of @insn is not
+ touched. If @insn already has its text, that text is returned.
+
+ Instructions inside an ARM IT or VPT block are decoded with the condition
+ the block gave them when they were disassembled.
+
+ @handle: handle returned by cs_open(), which disassembled @insn
+ @insn: instruction returned by cs_disasm() or cs_disasm_iter()
+ @buf: buffer for the text "mnemonic op_str". It must have room for
+	sizeof(insn->mnemonic) + sizeof(insn->op_str) characters.
+
+ @return: true if the text was written to @buf, or false if the bytes of @insn
+ do not decode anymore (e.g. the mode was changed).
+
+ On failure, call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+bool CAPSTONE_API cs_insn_format(csh handle, const cs_insn *insn, char *buf);
+
 /**
  Return friendly name of register in a string.
  Find the instruction id from header file of corresponding architecture (arm.h for ARM,
@@ -940,6 +1206,123 @@ cs_err CAPSTONE_API cs_regs_access(csh handle, const cs_insn *insn,
 		cs_regs regs_read, uint8_t *regs_read_count,
 		cs_regs regs_write, uint8_t *regs_write_count);
 
+/// Set of group IDs: bit (id % 64) of word (id / 64) is set for every group
+/// in the set. Group IDs of all architectures are below 256.
+typedef uint64_t cs_groups_mask[4];
+
+/// Set of register IDs: bit (id % 64) of word (id / 64) is set for every
+/// register in the set. Register IDs of all architectures are below 1024.
+typedef uint64_t cs_regs_bitset[16];
+
+/// Check if the group or register @id is in the cs_groups_mask or
+/// cs_regs_bitset @set.
+#define CS_BITSET_HAS(set, id) (((set)[(id) >> 6] >> ((id) & 63)) & 1)
+
+/**
+ Retrieve the groups of an instruction as a set.
+ The set takes one AND per membership test (CS_BITSET_HAS()), and the sets
+ of several instructions are merged word by word.
+
+ NOTE: this API is only valid when detail option is ON (which is OFF by default)
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure returned from cs_disasm() or cs_disasm_iter()
+ @groups: on return, the groups the instruction belongs to.
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_insn_groups_mask(csh handle, const cs_insn *insn,
+		cs_groups_mask groups);
+
+/**
+ Retrieve all the registers accessed by an instruction, either explicitly or
+ implicitly, as sets. See cs_regs_access().
+
+ WARN: when in 'diet' mode, this API is irrelevant because engine does not
+ store registers.
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure returned from cs_disasm() or cs_disasm_iter()
+ @regs_read: on return, the registers read by the instruction.
+ @regs_write: on return, the registers written by the instruction.
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_regs_access_bitset(csh handle, const cs_insn *insn,
+		cs_regs_bitset regs_read, cs_regs_bitset regs_write);
+
+/**
+ Copy the detail of an instruction into a full cs_detail structure.
+ This works for details in the compact encoding (CS_OPT_DETAIL_COMPACT) too.
+
+ NOTE: only the part of @detail used by the architecture of @handle is
+ written.
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure received from cs_disasm() or cs_disasm_iter()
+ @detail: structure to be filled in by this API.
+
+ @return CS_ERR_OK on success, or other value on failure (refer to cs_err enum
+ for detailed error).
+*/
+CAPSTONE_EXPORT
+cs_err CAPSTONE_API cs_detail_unpack(csh handle, const cs_insn *insn,
+		cs_detail *detail);
+
+/**
+ Return the implicit registers read, the implicit registers written or the
+ groups of an instruction, for a cs_detail as well as for a compact detail
+ (CS_OPT_DETAIL_COMPACT).
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure received from cs_disasm() or cs_disasm_iter()
+ @count: on return, the number of entries of the list.
+
+ @return: the list, or NULL on failure. Call cs_errno() for error code.
+*/
+CAPSTONE_EXPORT
+const uint16_t * CAPSTONE_API cs_detail_regs_read(csh handle,
+		const cs_insn *insn, uint8_t *count);
+
+CAPSTONE_EXPORT
+const uint16_t * CAPSTONE_API cs_detail_regs_write(csh handle,
+		const cs_insn *insn, uint8_t *count);
+
+CAPSTONE_EXPORT
+const uint8_t * CAPSTONE_API cs_detail_groups(csh handle,
+		const cs_insn *insn, uint8_t *count);
+
+/**
+ Return the number of operands in the detail of an instruction, i.e. the
+ <arch>.op_count field. This works for compact details too.
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure received from cs_disasm() or cs_disasm_iter()
+
+ @return: the number of operands, or -1 on failure.
+*/
+CAPSTONE_EXPORT
+int CAPSTONE_API cs_detail_op_count(csh handle, const cs_insn *insn);
+
+/**
+ Return an operand of an instruction, i.e. &<arch>.operands[@index].
+ The operand has the type of the architecture (cs_x86_op for X86, ...).
+ This works for compact details too.
+
+ @handle: handle returned by cs_open()
+ @insn: disassembled instruction structure received from cs_disasm() or cs_disasm_iter()
+ @index: index of the operand, less than cs_detail_op_count(handle, insn).
+
+ @return: pointer to the operand, or NULL on failure.
+*/
+CAPSTONE_EXPORT
+const void * CAPSTONE_API cs_detail_op(csh handle, const cs_insn *insn,
+		unsigned int index);
+
 #ifdef __cplusplus
 }
 #endif
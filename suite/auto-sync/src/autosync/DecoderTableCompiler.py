@@ -0,0 +1,457 @@
+#!/usr/bin/env python3
+
+# Copyright © 2024 Rot127 <unisono@quyllur.org>
+# SPDX-License-Identifier: BSD-3
+
+import argparse
+import logging as log
+import re
+from pathlib import Path
+
+from autosync.Helper import fail_exit
+
+# Must match enum DecoderOps in MCFixedLenDisassembler.h
+MCD_OPS = {
+    "MCD_OPC_ExtractField": 1,
+    "MCD_OPC_FilterValue": 2,
+    "MCD_OPC_CheckField": 3,
+    "MCD_OPC_CheckPredicate": 4,
+    "MCD_OPC_Decode": 5,
+    "MCD_OPC_TryDecode": 6,
+    "MCD_OPC_SoftFail": 7,
+    "MCD_OPC_Fail": 8,
+    "MCD_OPC_ExtractFieldDispatch": 9,
+}
+MCD_OP_NAMES = {v: k for k, v in MCD_OPS.items()}
+
+# Fields of each op after the op byte.
+# "u8": a byte, "uleb": ULEB128 value, "skip": 24-bit NumToSkip
+MCD_OP_FIELDS = {
+    "MCD_OPC_ExtractField": ["u8", "u8"],
+    "MCD_OPC_FilterValue": ["uleb", "skip"],
+    "MCD_OPC_CheckField": ["u8", "u8", "uleb", "skip"],
+    "MCD_OPC_CheckPredicate": ["uleb", "skip"],
+    "MCD_OPC_Decode": ["uleb", "uleb"],
+    "MCD_OPC_TryDecode": ["uleb", "uleb", "skip"],
+    "MCD_OPC_SoftFail": ["uleb", "uleb"],
+    "MCD_OPC_Fail": [],
+}
+
+# The dispatch array of a field has 2^Len entries of 3 bytes.
+# It replaces the FilterValue chain following an ExtractField, if the chain
+# is long enough to pay for the array.
+DISPATCH_MIN_FILTERS = 3
+DISPATCH_MAX_LEN = 10
+DISPATCH_MAX_ENTRIES_PER_FILTER = 8
+
+BYTECODE_GUARD = "CAPSTONE_DECODER_BYTECODE"
+
+# The key of a table is a field of KEY_LEN bits. The key table has a bit set
+# for every field value, for which the table can decode an instruction.
+KEY_LEN = 12
+
+DISPATCH_CASE = [
+    "case MCD_OPC_ExtractFieldDispatch: {",
+    "  unsigned FieldStart = *++Ptr;",
+    "  unsigned FieldLen = *++Ptr;",
+    "  ++Ptr;",
+    "  CurFieldValue = fieldname(insn, FieldStart, FieldLen);",
+    "  /* Jump to the FilterValue body of the field value. */",
+    "  /* NumToSkip is a plain 24-bit integer, relative to the end of the array. */",
+    "  const uint8_t *Skip = Ptr + 3 * CurFieldValue;",
+    "  Ptr += 3 * (1u << FieldLen) + (Skip[0] | (Skip[1] << 8) | (Skip[2] << 16));",
+    "  break;",
+    "}",
+]
+
+
+class DecoderOp:
+    def __init__(self, pos: int, op: int, args: list[int], comment: str) -> None:
+        self.pos = pos
+        self.op = op
+        self.name = MCD_OP_NAMES.get(op)
+        self.args = args  # Decoded fields, skips as absolute target positions.
+        self.comment = comment
+        self.size = 0
+        self.new_pos = 0
+        # ExtractFieldDispatch: the target of each field value.
+        self.dispatch: list[int] = []
+
+
+class DecoderTableCompiler:
+    """
+    Compiles the byte-coded decoder tables of a <ARCH>GenDisassemblerTables.inc
+    file into tables with direct dispatch.
+
+    Each ExtractField which is followed by a long chain of FilterValue ops becomes
+    an ExtractFieldDispatch. It extracts the field and jumps with the field value
+    as index into an array of targets. The FilterValue chain stays in place,
+    because failed checks inside a FilterValue body continue with the next
+    FilterValue of the chain. So the result decodes exactly as the byte-coded table.
+
+    The byte-coded tables stay in the file, guarded by CAPSTONE_DECODER_BYTECODE.
+
+    With emit_keys, every table gets a key table <TABLE>Keys as well.
+    The disassemblers which probe several tables one after another check it
+    with decoderTableMayDecode(), before they call the decoder with the table.
+    """
+
+    def __init__(self, inc_file: Path, emit_keys: bool = False) -> None:
+        self.inc_file = inc_file
+        self.emit_keys = emit_keys
+
+    def compile(self) -> None:
+        with open(self.inc_file) as f:
+            content = f.read()
+        if BYTECODE_GUARD in content:
+            log.info(f"{self.inc_file.name}: decoder tables are already compiled.")
+            return
+        if "NumToSkip is a plain 24-bit integer" not in content:
+            fail_exit(f"{self.inc_file.name}: only 24-bit NumToSkip is supported.")
+
+        tables = re.compile(
+            r"^static const uint8_t (DecoderTable\w*)\[\] = \{\n(.*?)^\};\n",
+            re.M | re.S,
+        )
+        content = tables.sub(self.compile_table_match, content)
+        content = self.add_dispatch_case(content)
+        with open(self.inc_file, "w") as f:
+            f.write(content)
+
+    def compile_table_match(self, match: re.Match) -> str:
+        name = match.group(1)
+        ops, tail = self.parse_table(name, match.group(2))
+        keys = self.key_table(name, ops) if self.emit_keys else []
+        self.add_dispatches(ops)
+        compiled = self.layout(name, ops)
+        old_size = ops[-1].pos + ops[-1].size + len(tail)
+        new_size = ops[-1].new_pos + ops[-1].size + len(tail)
+        log.debug(f"{name}: {old_size} -> {new_size} bytes")
+        lines = [f"#ifdef {BYTECODE_GUARD}", match.group(0) + "#else"]
+        lines.append(f"static const uint8_t {name}[] = {{")
+        lines += compiled
+        lines += ["  " + ", ".join(str(b) for b in tail)] if tail else []
+        lines += ["};", f"#endif // {BYTECODE_GUARD}", ""]
+        lines += keys
+        return "\n".join(lines)
+
+    @staticmethod
+    def decode_uleb(data: list[int], i: int) -> tuple[int, int]:
+        value = 0
+        shift = 0
+        while True:
+            b = data[i]
+            value |= (b & 0x7F) << shift
+            shift += 7
+            i += 1
+            if not b & 0x80:
+                return value, i
+
+    @staticmethod
+    def encode_uleb(value: int) -> list[int]:
+        out = []
+        while True:
+            b = value & 0x7F
+            value >>= 7
+            if value:
+                out.append(b | 0x80)
+            else:
+                out.append(b)
+                return out
+
+    def parse_table(self, name: str, text: str) -> tuple[list[DecoderOp], list[int]]:
+        """Parses the table into ops. Returns the ops and the trailing bytes."""
+        data = []
+        comments = {}
+        for line in text.splitlines():
+            code, _, comment = line.partition("//")
+            code = re.sub(r"/\*.*?\*/", "", code)
+            tokens = [t.strip() for t in code.split(",") if t.strip()]
+            if not tokens:
+                continue
+            comments[len(data)] = comment.strip()
+            for t in tokens:
+                data.append(MCD_OPS[t] if t in MCD_OPS else int(t))
+
+        ops = []
+        i = 0
+        while i < len(data):
+            op = data[i]
+            op_name = MCD_OP_NAMES.get(op)
+            if op_name not in MCD_OP_FIELDS:
+                # Padding after the final MCD_OPC_Fail
+                break
+            pos = i
+            i += 1
+            args = []
+            for field in MCD_OP_FIELDS[op_name]:
+                if field == "u8":
+                    args.append(data[i])
+                    i += 1
+                elif field == "uleb":
+                    value, i = self.decode_uleb(data, i)
+                    args.append(value)
+                else:
+                    skip = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16)
+                    i += 3
+                    args.append(i + skip)
+            d_op = DecoderOp(pos, op, args, comments.get(pos, ""))
+            d_op.size = i - pos
+            ops.append(d_op)
+        tail = data[i:]
+
+        positions = {op.pos for op in ops}
+        positions.add(i)
+        for op in ops:
+            if op.name in ["MCD_OPC_FilterValue", "MCD_OPC_CheckField"]:
+                target = op.args[-1]
+            elif op.name in ["MCD_OPC_CheckPredicate", "MCD_OPC_TryDecode"]:
+                target = op.args[-1]
+            else:
+                continue
+            if target not in positions:
+                fail_exit(f"{name}: skip at {op.pos} to {target} is inside an op.")
+        return ops, tail
+
+    @staticmethod
+    def decode_paths(ops: list[DecoderOp]) -> set[tuple[int, int]]:
+        """
+        Returns the bits every path to a Decode or TryDecode op checks,
+        as (mask, value) pairs. An instruction can only be decoded by the table,
+        if it matches one of them. Checks of predicates are ignored.
+        """
+        by_pos = {op.pos: op for op in ops}
+        paths = set()
+        visited = set()
+        # Position, checked bits and the current field of ExtractField
+        stack = [(ops[0].pos, 0, 0, (0, 0))]
+        while stack:
+            state = stack.pop()
+            if state in visited:
+                continue
+            visited.add(state)
+            pos, mask, value, field = state
+            op = by_pos.get(pos)
+            if op is None:
+                continue
+            next_pos = pos + op.size
+
+            def check(start: int, length: int, field_value: int):
+                m = ((1 << length) - 1) << start
+                v = (field_value << start) & m
+                if value & mask & m != v & mask:
+                    # Contradicts a previous check.
+                    return None
+                return mask | m, (value & ~m) | v
+
+            if op.name == "MCD_OPC_ExtractField":
+                stack.append((next_pos, mask, value, tuple(op.args)))
+            elif op.name in ["MCD_OPC_FilterValue", "MCD_OPC_CheckField"]:
+                if op.name == "MCD_OPC_FilterValue":
+                    start, length = field
+                    field_value, target = op.args
+                else:
+                    start, length, field_value, target = op.args
+                stack.append((target, mask, value, field))
+                checked = check(start, length, field_value)
+                if checked:
+                    stack.append((next_pos, checked[0], checked[1], field))
+            elif op.name == "MCD_OPC_CheckPredicate":
+                stack.append((op.args[-1], mask, value, field))
+                stack.append((next_pos, mask, value, field))
+            elif op.name == "MCD_OPC_TryDecode":
+                paths.add((mask, value))
+                stack.append((op.args[-1], mask, value, field))
+            elif op.name == "MCD_OPC_Decode":
+                paths.add((mask, value))
+            elif op.name == "MCD_OPC_SoftFail":
+                stack.append((next_pos, mask, value, field))
+        return paths
+
+    def key_table(self, name: str, ops: list[DecoderOp]) -> list[str]:
+        """
+        Emits the key table of a decoder table. The key is the field of KEY_LEN
+        bits, which rules out the table for the most instructions.
+        """
+        paths = self.decode_paths(ops)
+        width = max([KEY_LEN] + [m.bit_length() for m, _ in paths])
+        key_mask = (1 << KEY_LEN) - 1
+        best = None
+        for start in range(width - KEY_LEN + 1):
+            keys = set()
+            for mask, value in paths:
+                fixed = (mask >> start) & key_mask
+                fixed_value = (value >> start) & fixed
+                # Every key which matches the checked bits.
+                free = key_mask & ~fixed
+                sub = free
+                while True:
+                    keys.add(fixed_value | sub)
+                    if sub == 0:
+                        break
+                    sub = (sub - 1) & free
+            if best is None or len(keys) < len(best[1]):
+                best = (start, keys)
+        start, keys = best
+        log.debug(f"{name}: key [{start + KEY_LEN - 1}:{start}], {len(keys)} of {1 << KEY_LEN} keys")
+
+        bits = [0] * ((1 << KEY_LEN) // 8)
+        for k in keys:
+            bits[k // 8] |= 1 << (k % 8)
+        lines = [
+            f"// The instructions {name} can decode, by the field",
+            f"// [{start + KEY_LEN - 1}:{start}]. See decoderTableMayDecode().",
+            f"static const uint8_t {name}Keys[] = {{",
+            f"  {start}, {KEY_LEN}, // Start, Len",
+        ]
+        for i in range(0, len(bits), 16):
+            lines.append("  " + ", ".join(str(b) for b in bits[i : i + 16]) + ",")
+        lines += ["};", ""]
+        return lines
+
+    def add_dispatches(self, ops: list[DecoderOp]) -> None:
+        by_pos = {op.pos: op for op in ops}
+        for i, op in enumerate(ops):
+            if op.name != "MCD_OPC_ExtractField" or i + 1 == len(ops):
+                continue
+            start, length = op.args
+            if length > DISPATCH_MAX_LEN:
+                continue
+
+            # Walk the FilterValue chain as the interpreter does, if no value
+            # matches. The first matching FilterValue wins.
+            bodies = {}
+            chain = ops[i + 1]
+            while chain and chain.name == "MCD_OPC_FilterValue":
+                value, target = chain.args
+                if value < (1 << length) and value not in bodies:
+                    bodies[value] = chain.pos + chain.size
+                chain = by_pos.get(target)
+            if chain is None:
+                # The chain ends at the padding after the final MCD_OPC_Fail.
+                continue
+            default = chain.pos
+
+            if len(bodies) < DISPATCH_MIN_FILTERS:
+                continue
+            if (1 << length) > DISPATCH_MAX_ENTRIES_PER_FILTER * len(bodies):
+                continue
+            op.name = "MCD_OPC_ExtractFieldDispatch"
+            op.op = MCD_OPS[op.name]
+            op.dispatch = [bodies.get(v, default) for v in range(1 << length)]
+            op.size = 3 + 3 * (1 << length)
+
+    def layout(self, name: str, ops: list[DecoderOp]) -> list[str]:
+        pos = 0
+        new_pos = {}
+        for op in ops:
+            op.new_pos = pos
+            new_pos[op.pos] = pos
+            pos += op.size
+        end = ops[-1].pos + ops[-1].size
+        new_pos[end] = pos
+
+        def skip_bytes(after: int, target: int) -> list[int]:
+            skip = new_pos[target] - after
+            if skip < 0 or skip >= (1 << 24):
+                fail_exit(f"{name}: NumToSkip {skip} does not fit into 24 bits.")
+            return [skip & 0xFF, (skip >> 8) & 0xFF, (skip >> 16) & 0xFF]
+
+        lines = []
+        for op in ops:
+            out = []
+            comment = op.comment
+            if op.name == "MCD_OPC_ExtractFieldDispatch":
+                start, length = op.args
+                out = [start, length]
+                array_end = op.new_pos + op.size
+                entries = []
+                for target in op.dispatch:
+                    entries.append(skip_bytes(array_end, target))
+                lines.append(self.format_op(op, out, comment))
+                for v in range(0, len(entries), 4):
+                    row = ", ".join(
+                        ", ".join(str(b) for b in e) for e in entries[v : v + 4]
+                    )
+                    lines.append(f"              {row}, // {v}-{v + 3}")
+                continue
+
+            fields = MCD_OP_FIELDS[op.name]
+            after = op.new_pos + 1
+            for field, arg in zip(fields, op.args):
+                if field == "u8":
+                    out.append(arg)
+                    after += 1
+                elif field == "uleb":
+                    enc = self.encode_uleb(arg)
+                    out += enc
+                    after += len(enc)
+                else:
+                    after += 3
+                    out += skip_bytes(after, arg)
+                    comment = re.sub(
+                        r"[Ss]kip to: \d+",
+                        lambda m: f"{m.group(0)[0]}kip to: {new_pos[arg]}",
+                        comment,
+                    )
+            lines.append(self.format_op(op, out, comment))
+        return lines
+
+    @staticmethod
+    def format_op(op: DecoderOp, out: list[int], comment: str) -> str:
+        pos = f"/* {op.new_pos} */"
+        text = f"{pos:<13} {op.name},"
+        if out:
+            text += " " + ", ".join(str(b) for b in out) + ","
+        if comment:
+            text += f" // {comment}"
+        return text
+
+    @staticmethod
+    def add_dispatch_case(content: str) -> str:
+        """
+        Adds the MCD_OPC_ExtractFieldDispatch case to the DecodeInstruction
+        macro. Byte-coded tables never use it.
+        """
+        case = re.compile(
+            r"^([ \t]*)case MCD_OPC_FilterValue: \{[ \t]*\\\n", re.M
+        )
+        match = case.search(content)
+        if not match:
+            fail_exit("DecodeInstruction has no MCD_OPC_FilterValue case.")
+        indent = match.group(1)
+        step = "\t" if indent.startswith("\t") else "  "
+        lines = []
+        for line in DISPATCH_CASE:
+            body = line.lstrip(" ")
+            depth = (len(line) - len(body)) // 2
+            lines.append(f"{indent}{step * depth}{body} \\\n")
+        return content[: match.start()] + "".join(lines) + content[match.start() :]
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(
+        prog="DecoderTableCompiler",
+        description="Compiles the decoder tables of a <ARCH>GenDisassemblerTables.inc file into dispatch tables.",
+    )
+    parser.add_argument(
+        dest="inc_files",
+        metavar="FILE",
+        nargs="+",
+        type=Path,
+        help="The <ARCH>GenDisassemblerTables.inc files to compile in place.",
+    )
+    parser.add_argument(
+        "--keys",
+        dest="emit_keys",
+        action="store_true",
+        help="Emit the key table of every decoder table.",
+    )
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    log.basicConfig(level=log.INFO, format="%(levelname)-5s - %(message)s")
+    args = parse_args()
+    for inc in args.inc_files:
+        DecoderTableCompiler(inc, args.emit_keys).compile()
@@ -11,6 +11,7 @@ import shutil
 import subprocess
 from pathlib import Path
 
+from autosync.DecoderTableCompiler import DecoderTableCompiler
 from autosync.Helper import fail_exit, get_path
 
 
@@ -51,6 +52,66 @@ class IncGenerator:
     def generate(self) -> None:
         self.gen_incs()
         self.move_mapping_files()
+        self.check_mapping_order()
+        self.patch_feature_checks()
+        self.compile_decoder_tables()
+
+    def patch_feature_checks(self) -> None:
+        """
+        Replaces the <ARCH>_getFeatureBits(Inst->csh->mode, F) calls of the decoder
+        predicates with CS_hasFeature(Inst->csh, F).
+        CS_hasFeature() tests a bit of the feature bitset, which is computed
+        once per mode. <ARCH>_getFeatureBits() walks the mode checks of the
+        feature on every call.
+        """
+        tables_file = self.output_dir_c_inc.joinpath(
+            f"{self.arch}GenDisassemblerTables.inc"
+        )
+        if not tables_file.exists():
+            return
+        with open(tables_file) as f:
+            content = f.read()
+        content, n = re.subn(
+            rf"\b{self.arch}_getFeatureBits\(\s*Inst->csh->mode,\s*",
+            "CS_hasFeature(Inst->csh, ",
+            content,
+        )
+        log.debug(f"Patched {n} feature checks in {tables_file.name}")
+        with open(tables_file, "w") as f:
+            f.write(content)
+
+    def compile_decoder_tables(self) -> None:
+        """
+        Compiles the byte-coded decoder tables into tables with direct dispatch.
+        See DecoderTableCompiler for details.
+        """
+        tables_file = self.output_dir_c_inc.joinpath(
+            f"{self.arch}GenDisassemblerTables.inc"
+        )
+        if not tables_file.exists():
+            return
+        # ARM and Mips probe several decoder tables for each instruction.
+        emit_keys = self.arch in ["ARM", "Mips"]
+        DecoderTableCompiler(tables_file, emit_keys).compile()
+
+    def check_mapping_order(self) -> None:
+        """
+        Checks that the <ARCH>GenCSMappingInsn.inc table is in MC opcode order.
+        map_cs_id() uses the opcode directly as index into this table.
+        """
+        mapping_file = self.output_dir_c_inc.joinpath(
+            f"{self.arch}GenCSMappingInsn.inc"
+        )
+        if not mapping_file.exists():
+            return
+        with open(mapping_file) as f:
+            opcodes = re.findall(r"^\s*\w+ /\* (\d+) \*/,", f.read(), re.M)
+        for i, opcode in enumerate(opcodes):
+            if int(opcode) != i:
+                fail_exit(
+                    f"{mapping_file.name}: entry {i} has opcode {opcode}. "
+                    "The table must contain every opcode in order."
+                )
 
     def move_mapping_files(self) -> None:
         """
@@ -0,0 +1,262 @@
+// Times the decoding of a table of archs, modes and options. Every group of
+// the table decodes the same code, and the fastest of [loop-count] rounds is
+// printed for each of its platforms.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#define CODE_SIZE (64 * 1024)
+#define MAX_OPTS 2
+
+struct group {
+	const char *name;
+	// fills @buf and returns its size
+	size_t (*fill)(uint8_t *buf);
+	const char *comment;
+};
+
+struct platform {
+	const char *group;
+	cs_arch arch;
+	cs_mode mode;
+	cs_opt opts[MAX_OPTS]; // applied after CS_OPT_SKIPDATA
+	const char *comment;
+};
+
+static uint8_t code[CODE_SIZE];
+static const char *mc_dir = "../MC/X86";
+
+// Pseudo random bytes, the same on every run. The decoded opcodes are
+// spread over the whole opcode table.
+static size_t fill_random(uint8_t *buf)
+{
+	uint32_t x = 2463534242u;
+	size_t i;
+
+	for (i = 0; i < CODE_SIZE; i++) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		buf[i] = (uint8_t)x;
+	}
+
+	return CODE_SIZE;
+}
+
+static bool is_x86_prefix(uint8_t byte)
+{
+	switch (byte) {
+	case 0x26: case 0x2e: case 0x36: case 0x3e: case 0x64: case 0x65:
+	case 0x66: case 0x67: case 0xf0: case 0xf2: case 0xf3:
+	case 0x62: case 0xc4: case 0xc5: case 0x8f:
+		return true;
+	default:
+		return (byte & 0xf0) == 0x40;
+	}
+}
+
+// Appends the encodings of a suite/MC file which start with a prefix.
+static size_t read_mc_file(uint8_t *buf, size_t size, const char *name)
+{
+	char path[512], line[1024];
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/%s", mc_dir, name);
+	f = fopen(path, "r");
+	if (!f) {
+		printf("Cannot open %s\n", path);
+		return size;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		uint8_t insn[16];
+		size_t len = 0;
+		char *p = line;
+
+		if (strncmp(line, "0x", 2))
+			continue;
+		while (len < sizeof(insn) && !strncmp(p, "0x", 2)) {
+			insn[len++] = (uint8_t)strtoul(p, &p, 16);
+			if (*p == ',')
+				p++;
+		}
+		if (!is_x86_prefix(insn[0]) || size + len > CODE_SIZE)
+			continue;
+		memcpy(buf + size, insn, len);
+		size += len;
+	}
+
+	fclose(f);
+	return size;
+}
+
+// The x86-64 instructions of the suite/MC files which start with a prefix
+// (legacy, REX, VEX, EVEX or XOP), repeated to fill the buffer.
+static size_t fill_x86_prefix(uint8_t *buf)
+{
+	static const char *mc_files[] = {
+		"avx512-encodings.s.cs",
+		"x86_64-avx-encoding.s.cs",
+		"x86_64-fma3-encoding.s.cs",
+		"x86_64-fma4-encoding.s.cs",
+		"x86_64-xop-encoding.s.cs",
+		"x86_64-encoding.s.cs",
+		"x86_64-rand-encoding.s.cs",
+		"x86_64-rtm-encoding.s.cs",
+		"address-size.s.cs",
+	};
+	size_t size = 0, corpus_size, i;
+
+	for (i = 0; i < sizeof(mc_files) / sizeof(mc_files[0]); i++)
+		size = read_mc_file(buf, size, mc_files[i]);
+	if (!size) {
+		printf("No instructions found in %s\n", mc_dir);
+		return 0;
+	}
+
+	corpus_size = size;
+	while (size + corpus_size <= CODE_SIZE) {
+		memcpy(buf + size, buf, corpus_size);
+		size += corpus_size;
+	}
+
+	return size;
+}
+
+static const struct group groups[] = {
+	{ "alias", fill_random,
+	  "Printing looks up the alias patterns of every instruction" },
+	{ "arm", fill_random,
+	  "No text, the decoder checks the features of the mode" },
+	{ "x86-prefix", fill_x86_prefix,
+	  "No text, prefixed x86-64 instructions of suite/MC" },
+	{ "x86-detail", fill_random,
+	  "Details with the implicit registers and the operand access" },
+};
+
+static const struct platform platforms[] = {
+	{ "alias", CS_ARCH_AARCH64, CS_MODE_LITTLE_ENDIAN, { { 0 } },
+	  "AArch64" },
+	{ "alias", CS_ARCH_ARM, CS_MODE_ARM, { { 0 } }, "ARM" },
+	{ "alias", CS_ARCH_ARM, CS_MODE_THUMB | CS_MODE_V8 | CS_MODE_MCLASS,
+	  { { 0 } }, "Thumb-2" },
+	{ "alias", CS_ARCH_PPC, CS_MODE_64 | CS_MODE_BIG_ENDIAN, { { 0 } },
+	  "PPC-64" },
+	{ "alias", CS_ARCH_MIPS, CS_MODE_MIPS32R6 | CS_MODE_BIG_ENDIAN,
+	  { { 0 } }, "Mips-32R6" },
+	{ "alias", CS_ARCH_SYSTEMZ, CS_MODE_BIG_ENDIAN | CS_MODE_SYSTEMZ_GENERIC,
+	  { { 0 } }, "SystemZ" },
+	{ "alias", CS_ARCH_LOONGARCH, CS_MODE_LOONGARCH64, { { 0 } },
+	  "LoongArch64" },
+	{ "arm", CS_ARCH_ARM, CS_MODE_ARM | CS_MODE_V8,
+	  { { CS_OPT_NO_TEXT, CS_OPT_ON } }, "ARM v8" },
+	{ "arm", CS_ARCH_ARM, CS_MODE_THUMB | CS_MODE_V8,
+	  { { CS_OPT_NO_TEXT, CS_OPT_ON } }, "Thumb-2 v8" },
+	{ "arm", CS_ARCH_ARM, CS_MODE_THUMB | CS_MODE_V8 | CS_MODE_MCLASS,
+	  { { CS_OPT_NO_TEXT, CS_OPT_ON } }, "Thumb-2 v8 M-class (MVE)" },
+	{ "x86-prefix", CS_ARCH_X86, CS_MODE_64,
+	  { { CS_OPT_NO_TEXT, CS_OPT_ON } }, "X86 64" },
+	{ "x86-detail", CS_ARCH_X86, CS_MODE_64,
+	  { { CS_OPT_DETAIL, CS_OPT_ON },
+	    { CS_OPT_SYNTAX, CS_OPT_SYNTAX_INTEL } }, "X86 64 (Intel)" },
+	{ "x86-detail", CS_ARCH_X86, CS_MODE_64,
+	  { { CS_OPT_DETAIL, CS_OPT_ON },
+	    { CS_OPT_SYNTAX, CS_OPT_SYNTAX_ATT } }, "X86 64 (AT&T)" },
+	{ "x86-detail", CS_ARCH_X86, CS_MODE_32,
+	  { { CS_OPT_DETAIL, CS_OPT_ON },
+	    { CS_OPT_SYNTAX, CS_OPT_SYNTAX_INTEL } }, "X86 32 (Intel)" },
+	{ "x86-detail", CS_ARCH_X86, CS_MODE_16,
+	  { { CS_OPT_DETAIL, CS_OPT_ON },
+	    { CS_OPT_SYNTAX, CS_OPT_SYNTAX_INTEL } }, "X86 16 (Intel)" },
+};
+
+static void bench_platform(const struct platform *p, size_t code_size,
+			   size_t loop_count)
+{
+	csh handle;
+	cs_insn *insn;
+	size_t round, i, count = 0;
+	double time_used, best = 0;
+
+	if (cs_open(p->arch, p->mode, &handle) != CS_ERR_OK) {
+		printf("%-24s not supported\n", p->comment);
+		return;
+	}
+	cs_option(handle, CS_OPT_SKIPDATA, CS_OPT_ON);
+	for (i = 0; i < MAX_OPTS && p->opts[i].type; i++)
+		cs_option(handle, p->opts[i].type, p->opts[i].val);
+
+	// the fastest round is the least disturbed one
+	insn = cs_malloc(handle);
+	for (round = 0; round < loop_count; round++) {
+		const uint8_t *c = code;
+		size_t size = code_size;
+		uint64_t address = 0x1000;
+		clock_t start = clock();
+
+		count = 0;
+		while (cs_disasm_iter(handle, &c, &size, &address, insn))
+			count++;
+		time_used = (double)(clock() - start) / CLOCKS_PER_SEC;
+		if (round == 0 || time_used < best)
+			best = time_used;
+	}
+
+	printf("%-24s %8zu insns %8.1f ns/insn %8.2f Minsns/s\n", p->comment,
+	       count, best * 1e9 / count, count / best / 1e6);
+
+	cs_free(insn, 1);
+	cs_close(&handle);
+}
+
+static void bench_group(const struct group *g, size_t loop_count)
+{
+	size_t code_size, i;
+
+	code_size = g->fill(code);
+	if (!code_size)
+		return;
+
+	printf("%s: %s (%zu bytes)\n", g->name, g->comment, code_size);
+	for (i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++)
+		if (!strcmp(platforms[i].group, g->name))
+			bench_platform(&platforms[i], code_size, loop_count);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *name = "all";
+	size_t loop_count = 20;
+	size_t i;
+	bool found = false;
+
+	if (argc > 1)
+		name = argv[1];
+	if (argc > 2)
+		loop_count = strtoul(argv[2], NULL, 0);
+	if (argc > 3)
+		mc_dir = argv[3];
+
+	for (i = 0; i < sizeof(groups) / sizeof(groups[0]); i++) {
+		if (strcmp(name, "all") && strcmp(name, groups[i].name))
+			continue;
+		found = true;
+		bench_group(&groups[i], loop_count);
+	}
+
+	if (!found) {
+		printf("Usage: %s [group] [loop-count] [mc-dir]\n", argv[0]);
+		printf("The groups are all (default)");
+		for (i = 0; i < sizeof(groups) / sizeof(groups[0]); i++)
+			printf(", %s", groups[i].name);
+		printf("\n");
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+// Compares cs_disasm() to cs_disasm_parallel() with a growing number of threads
+
+#include "./load_bin.inc"
+#include <capstone/capstone.h>
+
+
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    // wall clock, clock() would add up the time of all threads
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int main(int argc, char* argv[])
+{
+    csh handle = 0;
+    cs_insn *insn = NULL;
+    int ret = 0;
+    size_t count, serial_count = 0;
+    size_t round, nthreads;
+    double start_time, serial_time = 0;
+
+    if (cs_open(CS_ARCH_X86, CS_MODE_64, &handle) != CS_ERR_OK)
+    {
+        fputs("Unable to create Capstone handle\n", stderr);
+        ret = 1;
+        goto leave;
+    }
+    cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+    uint8_t *code = NULL;
+    size_t code_len = 0, loop_count = 0;
+    if (!read_file(argc, argv, &code, &code_len, &loop_count))
+    {
+        ret = 1;
+        goto leave;
+    }
+
+    // one thread is the plain cs_disasm() as baseline
+    for (nthreads = 1; nthreads <= 16; nthreads *= 2)
+    {
+        count = 0;
+        start_time = now_ms();
+        for (round = 0; round < loop_count; ++round)
+        {
+            if (nthreads == 1)
+                count = cs_disasm(handle, code, code_len, 0x1000, 0, &insn);
+            else
+                count = cs_disasm_parallel(handle, code, code_len, 0x1000, 0, nthreads, &insn);
+            cs_free(insn, count);
+            insn = NULL;
+        }
+        double time_used = now_ms() - start_time;
+
+        if (nthreads == 1)
+        {
+            serial_count = count;
+            serial_time = time_used;
+        }
+        else if (count != serial_count)
+        {
+            fprintf(stderr, "%zu threads: got %zu instructions, expected %zu\n",
+                nthreads, count, serial_count);
+            ret = 1;
+            goto leave;
+        }
+
+        printf(
+            "%2zu thread(s): disassembled %zu instructions, %.2f ms, speedup %.2fx\n",
+            nthreads,
+            count,
+            time_used,
+            serial_time / time_used
+        );
+    }
+
+leave:
+    if (handle) cs_close(&handle);
+    if (code) free(code);
+    return ret;
+}
@@ -184,6 +184,8 @@ static const TestOptionMapEntry test_option_map[] = {
 	  .opt = { .type = CS_OPT_UNSIGNED, .val = CS_OPT_ON } },
 	{ .str = "CS_OPT_ONLY_OFFSET_BRANCH",
 	  .opt = { .type = CS_OPT_ONLY_OFFSET_BRANCH, .val = CS_OPT_ON } },
+	{ .str = "CS_OPT_NO_TEXT",
+	  .opt = { .type = CS_OPT_NO_TEXT, .val = CS_OPT_ON } },
 	{ .str = "CS_OPT_SYNTAX_DEFAULT",
 	  .opt = { .type = CS_OPT_SYNTAX, .val = CS_OPT_SYNTAX_DEFAULT } },
 	{ .str = "CS_OPT_SYNTAX_INTEL",
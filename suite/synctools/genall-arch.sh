@@ -19,6 +19,9 @@ echo "Generating ${ARCH}MappingInsnName.inc (Copy comments to include/capstone/<
 echo "Generating ${ARCH}MappingInsn.inc"
 ./mapping_insn-arch.py $1/${ARCH}GenAsmMatcher.inc $1/${ARCH}GenInstrInfo.inc $2/${ARCH}MappingInsn.inc > ${ARCH}MappingInsn.inc
 
+echo "Generating ${ARCH}MappingInsnIdx.inc"
+./mapping_insn_idx.py ${ARCH}MappingInsn.inc > ${ARCH}MappingInsnIdx.inc
+
 echo "Generating ${ARCH}GenInstrInfo.inc"
 ./instrinfo-arch.py $1/${ARCH}GenInstrInfo.inc ${ARCH} > ${ARCH}GenInstrInfo.inc
 
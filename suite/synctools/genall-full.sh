@@ -21,6 +21,9 @@ echo "Generating MappingInsnName.inc"
 echo "Generating MappingInsn.inc"
 ./mapping_insn.py $1/X86GenAsmMatcher.inc $1/X86GenInstrInfo.inc $2/X86MappingInsn.inc > X86MappingInsn.inc
 
+echo "Generating MappingInsnIdx.inc"
+./mapping_insn_idx.py X86MappingInsn.inc > X86MappingInsnIdx.inc
+
 echo "Generating MappingInsnOp.inc"
 ./mapping_insn_op.py $1/X86GenAsmMatcher.inc $1/X86GenInstrInfo.inc  $2/X86MappingInsnOp.inc > X86MappingInsnOp.inc 
 
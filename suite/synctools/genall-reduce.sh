@@ -17,6 +17,9 @@ echo "Generating MappingInsnName_reduce.inc"
 echo "Generating MappingInsn_reduce.inc"
 ./mapping_insn.py $1/X86GenAsmMatcher_reduce.inc $1/X86GenInstrInfo_reduce.inc $2/X86MappingInsn_reduce.inc > X86MappingInsn_reduce.inc
 
+echo "Generating MappingInsnIdx_reduce.inc"
+./mapping_insn_idx.py X86MappingInsn_reduce.inc > X86MappingInsnIdx_reduce.inc
+
 echo "Generating MappingInsnOp_reduce.inc"
 ./mapping_insn_op.py $1/X86GenAsmMatcher.inc $1/X86GenInstrInfo_reduce.inc  $2/X86MappingInsnOp_reduce.inc > X86MappingInsnOp_reduce.inc 
 
@@ -0,0 +1,48 @@
+#!/usr/bin/python
+# print MappingInsnIdx.inc file from a MappingInsn.inc file, for Capstone disassembler.
+# This is the reverse map of MappingInsn.inc: internal insn id -> index in insns[].
+# Index 0 is the dummy item, so missing ids map to "not found".
+
+import re
+import sys
+
+if len(sys.argv) == 1:
+    print("Syntax: %s <MappingInsn.inc>" %sys.argv[0])
+    sys.exit(1)
+
+f = open(sys.argv[1])
+lines = f.readlines()
+f.close()
+
+# each entry starts with:
+# {
+#	SP_ADDCCri, SPARC_INS_ADDCC,
+# or, for X86:
+#	X86_AAA, X86_INS_AAA, 0,
+entry = re.compile(r'^\s*(\w+),\s*\w+,(\s*\w+,)?\s*$')
+
+ids = []
+prev = ''
+for line in lines:
+    m = entry.match(line)
+    if m and prev.strip() == '{':
+        ids.append(m.group(1))
+    prev = line
+
+# MappingInsn.inc is included after the dummy item.
+# If the dummy item is part of the given table, it already has index 0.
+first = 0 if ids and ids[0] == '0' else 1
+
+# the last entry of an id wins
+index = {}
+for i, insn_id in enumerate(ids):
+    if insn_id != '0':
+        index[insn_id] = i + first
+
+print("""// This is auto-gen data for Capstone engine (www.capstone-engine.org)
+// By Nguyen Anh Quynh <aquynh@gmail.com>
+""")
+
+for insn_id in ids:
+    if insn_id in index:
+        print("[%s] = %u," %(insn_id, index.pop(insn_id)))
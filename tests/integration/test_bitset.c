@@ -0,0 +1,139 @@
+// This sample code demonstrates the APIs cs_insn_groups_mask() and
+// cs_regs_access_bitset(), which return the groups and the registers of an
+// instruction as bit sets.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	const uint8_t *code;
+	size_t size;
+	const char *comment;
+};
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\xf0\x48\x0f\xc1\x07\xf3\x48\xa5\xc3"
+#define ARM_CODE \
+	"\xed\xff\xff\xeb\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e"
+#define MIPS_CODE \
+	"\x0c\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00"
+
+// check that @set holds exactly the @count registers of @regs
+static void check_regs(const cs_regs_bitset set, const uint16_t *regs,
+		uint8_t count)
+{
+	cs_regs_bitset expected;
+	unsigned int i;
+
+	memset(expected, 0, sizeof(expected));
+	for (i = 0; i < count; i++) {
+		assert(CS_BITSET_HAS(set, regs[i]));
+		expected[regs[i] / 64] |= (uint64_t)1 << (regs[i] % 64);
+	}
+	assert(!memcmp(set, expected, sizeof(expected)));
+}
+
+static void test_platform(const struct platform *p)
+{
+	csh handle;
+	cs_insn *insn;
+	size_t count, i, j;
+	cs_err err;
+	// registers read and written by the whole code
+	cs_regs_bitset all_read, all_write;
+
+	err = cs_open(p->arch, p->mode, &handle);
+	if (err) {
+		if (cs_support(p->arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		}
+		return;
+	}
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	printf("****************\n");
+	printf("Platform: %s\n", p->comment);
+
+	count = cs_disasm(handle, p->code, p->size, 0x1000, 0, &insn);
+	assert(count);
+	memset(all_read, 0, sizeof(all_read));
+	memset(all_write, 0, sizeof(all_write));
+	for (i = 0; i < count; i++) {
+		cs_groups_mask groups;
+		cs_regs_bitset read, write;
+		cs_regs rr, rw;
+		uint8_t rr_count, rw_count;
+
+		assert(cs_insn_groups_mask(handle, &insn[i], groups) ==
+		       CS_ERR_OK);
+		for (j = 0; j < 256; j++)
+			assert(CS_BITSET_HAS(groups, j) ==
+			       cs_insn_group(handle, &insn[i], j));
+
+		assert(cs_regs_access_bitset(handle, &insn[i], read, write) ==
+		       CS_ERR_OK);
+		assert(cs_regs_access(handle, &insn[i], rr, &rr_count, rw,
+				      &rw_count) == CS_ERR_OK);
+		check_regs(read, rr, rr_count);
+		check_regs(write, rw, rw_count);
+		for (j = 0; j < insn[i].detail->regs_read_count; j++)
+			assert(CS_BITSET_HAS(read,
+					     insn[i].detail->regs_read[j]));
+
+		for (j = 0; j < sizeof(read) / sizeof(read[0]); j++) {
+			all_read[j] |= read[j];
+			all_write[j] |= write[j];
+		}
+
+		printf("0x%" PRIx64 ":\t%s\t%s\t// %s%s%s\n", insn[i].address,
+		       insn[i].mnemonic, insn[i].op_str,
+		       CS_BITSET_HAS(groups, CS_GRP_JUMP) ? "jump " : "",
+		       CS_BITSET_HAS(groups, CS_GRP_CALL) ? "call " : "",
+		       CS_BITSET_HAS(groups, CS_GRP_RET) ? "ret" : "");
+	}
+
+	printf("Registers read:");
+	for (j = 0; j < sizeof(all_read) * 8; j++)
+		if (CS_BITSET_HAS(all_read, j))
+			printf(" %s", cs_reg_name(handle, j));
+	printf("\nRegisters written:");
+	for (j = 0; j < sizeof(all_write) * 8; j++)
+		if (CS_BITSET_HAS(all_write, j))
+			printf(" %s", cs_reg_name(handle, j));
+	printf("\n");
+
+	cs_free(insn, count);
+	cs_close(&handle);
+}
+
+static void test()
+{
+	struct platform platforms[] = {
+		{ CS_ARCH_X86, CS_MODE_64, (const uint8_t *)X86_CODE64,
+		  sizeof(X86_CODE64) - 1, "X86 64 (Intel syntax)" },
+		{ CS_ARCH_ARM, CS_MODE_ARM, (const uint8_t *)ARM_CODE,
+		  sizeof(ARM_CODE) - 1, "ARM" },
+		{ CS_ARCH_MIPS, CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)MIPS_CODE, sizeof(MIPS_CODE) - 1,
+		  "MIPS-32 (Big-endian)" },
+	};
+
+	for (size_t i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++)
+		test_platform(&platforms[i]);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,113 @@
+// This sample code demonstrates the API cs_clone(), which creates a new
+// handle with the same setup as an existing one.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#define THUMB_CODE \
+	"\x70\x47\x00\xf0\x10\xe8\xeb\x46\x83\xb0\xc9\x68\x1f\xb1\x30\xbf\xaf\xf3\x20\x84\x18\xbf\x01\x20\x02\x20"
+#define M68K_CODE \
+	"\xd4\x40\x87\x5a\x4e\x71\x02\xb4\xc0\xde\xc0\xde\x5c\x00\x1d\x80\x71\x12\x01\x23\xf2\x3c\x44\x22\x40\x49\x0e\x56\x54\xc5\xf2\x3c\x44\x00\x44\x7a\x00\x00\xf2\x00\x0a\x28\x4E\xB9\x00\x00\x00\x12\x4E\x75"
+
+static size_t disasm(csh handle, const char *code, size_t size, cs_insn **insn)
+{
+	size_t count = cs_disasm(handle, (const uint8_t *)code, size, 0x1000, 0, insn);
+
+	assert(count > 0);
+	return count;
+}
+
+static void check_same(csh ha, cs_insn *a, csh hb, cs_insn *b, size_t count)
+{
+	cs_detail da, db;
+
+	for (size_t i = 0; i < count; i++) {
+		assert(a[i].id == b[i].id);
+		assert(a[i].size == b[i].size);
+		assert(strcmp(a[i].mnemonic, b[i].mnemonic) == 0);
+		assert(strcmp(a[i].op_str, b[i].op_str) == 0);
+		assert(a[i].detail && b[i].detail);
+		// only the part of the arch is allocated
+		memset(&da, 0, sizeof(da));
+		memset(&db, 0, sizeof(db));
+		assert(cs_detail_unpack(ha, &a[i], &da) == CS_ERR_OK);
+		assert(cs_detail_unpack(hb, &b[i], &db) == CS_ERR_OK);
+		assert(memcmp(&da, &db, sizeof(cs_detail)) == 0);
+	}
+}
+
+static void test_platform(cs_arch arch, cs_mode mode, const char *code,
+			  size_t size, const char *comment)
+{
+	csh handle, clone;
+	cs_insn *insn, *clone_insn;
+	size_t count, clone_count;
+	cs_opt_mnem mnem;
+	cs_err err;
+
+	err = cs_open(arch, mode, &handle);
+	if (err) {
+		if (cs_support(arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		}
+		return;
+	}
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+	cs_option(handle, CS_OPT_UNSIGNED, CS_OPT_ON);
+
+	count = disasm(handle, code, size, &insn);
+	mnem.id = insn[0].id;
+	mnem.mnemonic = "first";
+	cs_option(handle, CS_OPT_MNEMONIC, (size_t)&mnem);
+	cs_free(insn, count);
+	count = disasm(handle, code, size, &insn);
+
+	// The clone has the same options and customized mnemonics.
+	err = cs_clone(handle, &clone);
+	assert(err == CS_ERR_OK);
+	clone_count = disasm(clone, code, size, &clone_insn);
+	assert(clone_count == count);
+	check_same(handle, insn, clone, clone_insn, count);
+	assert(strstr(clone_insn[0].mnemonic, "first"));
+	cs_free(clone_insn, clone_count);
+
+	// Options set later only change the handle they are set on.
+	mnem.mnemonic = NULL;
+	cs_option(clone, CS_OPT_MNEMONIC, (size_t)&mnem);
+	cs_free(insn, count);
+	count = disasm(handle, code, size, &insn);
+	assert(strstr(insn[0].mnemonic, "first"));
+
+	// The clone keeps working after the original handle is closed.
+	cs_close(&handle);
+	clone_count = disasm(clone, code, size, &clone_insn);
+	assert(clone_count == count);
+	assert(!strstr(clone_insn[0].mnemonic, "first"));
+	printf("%s: %zu instructions\n", comment, clone_count);
+
+	cs_free(insn, count);
+	cs_free(clone_insn, clone_count);
+	cs_close(&clone);
+}
+
+static void test()
+{
+	test_platform(CS_ARCH_ARM, CS_MODE_THUMB, THUMB_CODE,
+		      sizeof(THUMB_CODE) - 1, "Thumb-2");
+	test_platform(CS_ARCH_M68K, CS_MODE_BIG_ENDIAN | CS_MODE_M68K_040,
+		      M68K_CODE, sizeof(M68K_CODE) - 1, "M68K");
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
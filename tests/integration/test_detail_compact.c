@@ -0,0 +1,220 @@
+// This sample code demonstrates the compact detail encoding
+// (CS_OPT_DETAIL_COMPACT) and the cs_detail_*() APIs to read it.
+// The compact details must give the same information as the full ones.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	const uint8_t *code;
+	size_t size;
+	size_t op_size;
+	const char *comment;
+};
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\xf0\x48\x0f\xc1\x07\xf3\x48\xa5"
+#define ARM_CODE \
+	"\xed\xff\xff\xeb\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e"
+#define PPC_CODE \
+	"\x43\x20\x0c\x07\x41\x56\xff\x17\x80\x20\x00\x00\x80\x3f\x00\x00\x10\x43\x23\x0e"
+#define MIPS_CODE \
+	"\x0c\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00"
+
+static void check_lists(csh full, const cs_insn *a, csh compact,
+		const cs_insn *b)
+{
+	const uint16_t *ra, *rb;
+	const uint8_t *ga, *gb;
+	uint8_t ca, cb;
+
+	ra = cs_detail_regs_read(full, a, &ca);
+	rb = cs_detail_regs_read(compact, b, &cb);
+	assert(ra && rb && ca == cb);
+	assert(!memcmp(ra, rb, ca * sizeof(*ra)));
+
+	ra = cs_detail_regs_write(full, a, &ca);
+	rb = cs_detail_regs_write(compact, b, &cb);
+	assert(ra && rb && ca == cb);
+	assert(!memcmp(ra, rb, ca * sizeof(*ra)));
+
+	ga = cs_detail_groups(full, a, &ca);
+	gb = cs_detail_groups(compact, b, &cb);
+	assert(ga && gb && ca == cb);
+	assert(!memcmp(ga, gb, ca));
+	if (ca)
+		assert(cs_insn_group(compact, b, ga[0]));
+}
+
+static void check_same(const struct platform *p, csh full, const cs_insn *a,
+		csh compact, const cs_insn *b)
+{
+	cs_regs rra, rwa, rrb, rwb;
+	uint8_t rca, wca, rcb, wcb;
+	int n, i;
+
+	assert(a->id == b->id && a->size == b->size);
+	assert(!strcmp(a->mnemonic, b->mnemonic));
+	assert(!strcmp(a->op_str, b->op_str));
+
+	check_lists(full, a, compact, b);
+
+	n = cs_detail_op_count(full, a);
+	assert(n >= 0 && n == cs_detail_op_count(compact, b));
+	for (i = 0; i < n; i++)
+		assert(!memcmp(cs_detail_op(full, a, i),
+			       cs_detail_op(compact, b, i), p->op_size));
+	assert(!cs_detail_op(compact, b, n));
+
+	if (cs_regs_access(full, a, rra, &rca, rwa, &wca) == CS_ERR_OK) {
+		assert(cs_regs_access(compact, b, rrb, &rcb, rwb, &wcb) ==
+		       CS_ERR_OK);
+		assert(rca == rcb && wca == wcb);
+		assert(!memcmp(rra, rrb, rca * sizeof(rra[0])));
+		assert(!memcmp(rwa, rwb, wca * sizeof(rwa[0])));
+	}
+}
+
+static void test_platform(const struct platform *p)
+{
+	csh full, compact;
+	cs_insn *a, *b, *insn;
+	size_t count, i;
+	cs_err err;
+
+	err = cs_open(p->arch, p->mode, &full);
+	if (err) {
+		if (cs_support(p->arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		}
+		return;
+	}
+	assert(cs_open(p->arch, p->mode, &compact) == CS_ERR_OK);
+	cs_option(full, CS_OPT_DETAIL, CS_OPT_ON);
+	cs_option(compact, CS_OPT_DETAIL, CS_OPT_ON | CS_OPT_DETAIL_COMPACT);
+
+	printf("****************\n");
+	printf("Platform: %s\n", p->comment);
+
+	count = cs_disasm(full, p->code, p->size, 0x1000, 0, &a);
+	assert(count);
+	assert(cs_disasm(compact, p->code, p->size, 0x1000, 0, &b) == count);
+	for (i = 0; i < count; i++) {
+		check_same(p, full, &a[i], compact, &b[i]);
+		printf("0x%" PRIx64 ":\t%s\t%s\t// %d operands\n", b[i].address,
+		       b[i].mnemonic, b[i].op_str,
+		       cs_detail_op_count(compact, &b[i]));
+	}
+
+	// the same with cs_disasm_iter()
+	insn = cs_malloc(compact);
+	const uint8_t *code = p->code;
+	size_t size = p->size;
+	uint64_t address = 0x1000;
+	for (i = 0; cs_disasm_iter(compact, &code, &size, &address, insn); i++) {
+		assert(i < count);
+		check_same(p, full, &a[i], compact, insn);
+	}
+	assert(i == count);
+
+	cs_free(insn, 1);
+	cs_free(a, count);
+	cs_free(b, count);
+	cs_close(&full);
+	cs_close(&compact);
+}
+
+// the heap hands out memory which is not zeroed, as a reused heap would
+static void *dirty_malloc(size_t size)
+{
+	void *p = malloc(size);
+
+	if (p)
+		memset(p, 0xab, size);
+	return p;
+}
+
+// insns are decoded into memory from cs_mem_malloc(), so nothing may be
+// left over from it, also for fields the archs only set for some insns
+static void test_dirty_heap()
+{
+	// mov pc, r0 is not an alias
+	static const uint8_t code[] = { 0x87, 0x46 };
+	const uint8_t *p = code;
+	size_t size = sizeof(code);
+	uint64_t address = 0x1000;
+	csh handle;
+	cs_insn *insn;
+
+	assert(cs_open(CS_ARCH_ARM, CS_MODE_THUMB, &handle) == CS_ERR_OK);
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	assert(cs_disasm(handle, code, sizeof(code), 0x1000, 0, &insn) == 1);
+	assert(!insn->is_alias && !insn->alias_id);
+	assert(!cs_insn_group(handle, insn, CS_GRP_RET));
+	cs_free(insn, 1);
+
+	insn = cs_malloc(handle);
+	assert(cs_disasm_iter(handle, &p, &size, &address, insn));
+	assert(!insn->is_alias && !insn->alias_id);
+	assert(!cs_insn_group(handle, insn, CS_GRP_RET));
+	cs_free(insn, 1);
+
+	cs_close(&handle);
+
+	// abs a5, a6. Xtensa relies on the core to clear the detail.
+	static const uint8_t xtensa_code[] = { 0x60, 0x51, 0x60 };
+	p = xtensa_code;
+	size = sizeof(xtensa_code);
+	if (cs_open(CS_ARCH_XTENSA, CS_MODE_XTENSA, &handle) != CS_ERR_OK)
+		return;
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	insn = cs_malloc(handle);
+	assert(cs_disasm_iter(handle, &p, &size, &address, insn));
+	assert(insn->detail->xtensa.op_count == 2);
+	assert(!insn->detail->regs_read_count && !insn->detail->groups_count);
+	cs_free(insn, 1);
+
+	cs_close(&handle);
+}
+
+static void test()
+{
+	struct platform platforms[] = {
+		{ CS_ARCH_X86, CS_MODE_64, (const uint8_t *)X86_CODE64,
+		  sizeof(X86_CODE64) - 1, sizeof(cs_x86_op),
+		  "X86 64 (Intel syntax)" },
+		{ CS_ARCH_ARM, CS_MODE_ARM, (const uint8_t *)ARM_CODE,
+		  sizeof(ARM_CODE) - 1, sizeof(cs_arm_op), "ARM" },
+		{ CS_ARCH_PPC, CS_MODE_BIG_ENDIAN, (const uint8_t *)PPC_CODE,
+		  sizeof(PPC_CODE) - 1, sizeof(cs_ppc_op), "PPC-64" },
+		{ CS_ARCH_MIPS, CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)MIPS_CODE, sizeof(MIPS_CODE) - 1,
+		  sizeof(cs_mips_op), "MIPS-32 (Big-endian)" },
+	};
+
+	for (size_t i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++)
+		test_platform(&platforms[i]);
+}
+
+int main()
+{
+	cs_opt_mem mem = { dirty_malloc, calloc, realloc, free, vsnprintf };
+
+	cs_option(0, CS_OPT_MEM, (size_t)&mem);
+
+	test();
+	test_dirty_heap();
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+// This sample code demonstrates how to fill only some parts of the detail
+// with CS_OPT_DETAIL_GROUPS, CS_OPT_DETAIL_OPERANDS, ...
+// The selected parts must be the same as with the full detail, the others
+// must be empty. The archs which can't leave out a part refuse the option.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	const uint8_t *code;
+	size_t size;
+	size_t op_size;
+	cs_opt_value with_ops; // parts which need CS_OPT_DETAIL_OPERANDS
+	const char *comment;
+};
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\xf0\x48\x0f\xc1\x07\xf3\x48\xa5\x62\xf1\x7c\x48\xc2\xc1\x02"
+#define ARM_CODE \
+	"\xed\xff\xff\xeb\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e\x04\xf0\x9d\xe4"
+#define MIPS_CODE \
+	"\x0c\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00"
+// stwu r1, -0x10(r1); cmpwi cr1, r3, 0; bdnz 0x1014; blr
+#define PPC_CODE \
+	"\x94\x21\xff\xf0\x2c\x83\x00\x00\x42\x00\x00\x0c\x4e\x80\x00\x20"
+// bl 4; jirl $ra, $t0, 0; jr $t0; ret
+#define LOONGARCH_CODE \
+	"\x00\x04\x00\x54\x81\x01\x00\x4c\x80\x01\x00\x4c\x20\x00\x00\x4c"
+#define RISCV_CODE "\x37\x34\x00\x00\x97\x82\x00\x00"
+
+static const cs_opt_value parts[] = {
+	CS_OPT_DETAIL_GROUPS,
+	CS_OPT_DETAIL_OPERANDS,
+	CS_OPT_DETAIL_IMPLICIT_REGS,
+	CS_OPT_DETAIL_ARCH_EXTRA,
+	CS_OPT_DETAIL_GROUPS | CS_OPT_DETAIL_IMPLICIT_REGS,
+	CS_OPT_DETAIL_OPERANDS | CS_OPT_DETAIL_IMPLICIT_REGS,
+};
+
+static void check_parts(const struct platform *p, cs_opt_value part,
+			csh full, const cs_insn *a, csh h, const cs_insn *b)
+{
+	const cs_detail *da = a->detail, *db = b->detail;
+	int n, i;
+
+	assert(a->id == b->id && a->size == b->size);
+	assert(!strcmp(a->mnemonic, b->mnemonic));
+	assert(!strcmp(a->op_str, b->op_str));
+
+	if (part & CS_OPT_DETAIL_GROUPS) {
+		assert(da->groups_count == db->groups_count);
+		assert(!memcmp(da->groups, db->groups, da->groups_count));
+	} else
+		assert(!db->groups_count);
+
+	if (part & CS_OPT_DETAIL_IMPLICIT_REGS) {
+		assert(da->regs_read_count == db->regs_read_count);
+		assert(!memcmp(da->regs_read, db->regs_read,
+			       da->regs_read_count * sizeof(da->regs_read[0])));
+		assert(da->regs_write_count == db->regs_write_count);
+		assert(!memcmp(da->regs_write, db->regs_write,
+			       da->regs_write_count *
+				       sizeof(da->regs_write[0])));
+	} else
+		assert(!db->regs_read_count && !db->regs_write_count);
+
+	n = cs_detail_op_count(h, b);
+	if (!(part & CS_OPT_DETAIL_OPERANDS)) {
+		assert(!n);
+	} else {
+		assert(n == cs_detail_op_count(full, a));
+		for (i = 0; i < n; i++)
+			assert(!memcmp(cs_detail_op(full, a, i),
+				       cs_detail_op(h, b, i), p->op_size));
+	}
+
+	if (p->arch == CS_ARCH_X86 && (part & CS_OPT_DETAIL_ARCH_EXTRA)) {
+		assert(!memcmp(da->x86.prefix, db->x86.prefix,
+			       sizeof(da->x86.prefix)));
+		assert(da->x86.eflags == db->x86.eflags);
+	}
+}
+
+static void test_platform(const struct platform *p)
+{
+	csh full, h;
+	cs_insn *a, *b;
+	size_t count, i, j;
+	cs_err err;
+
+	err = cs_open(p->arch, p->mode, &full);
+	if (err) {
+		if (cs_support(p->arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		}
+		return;
+	}
+	cs_option(full, CS_OPT_DETAIL, CS_OPT_ON);
+
+	printf("****************\n");
+	printf("Platform: %s\n", p->comment);
+
+	count = cs_disasm(full, p->code, p->size, 0x1000, 0, &a);
+	assert(count);
+	for (j = 0; j < sizeof(parts) / sizeof(parts[0]); j++) {
+		assert(cs_open(p->arch, p->mode, &h) == CS_ERR_OK);
+		err = cs_option(h, CS_OPT_DETAIL, CS_OPT_ON | parts[j]);
+		if ((parts[j] & p->with_ops) &&
+		    !(parts[j] & CS_OPT_DETAIL_OPERANDS)) {
+			assert(err == CS_ERR_OPTION);
+			printf("Parts 0x%x: refused\n", parts[j]);
+			cs_close(&h);
+			continue;
+		}
+		assert(err == CS_ERR_OK);
+		assert(cs_disasm(h, p->code, p->size, 0x1000, 0, &b) == count);
+		for (i = 0; i < count; i++)
+			check_parts(p, parts[j], full, &a[i], h, &b[i]);
+		printf("Parts 0x%x: %zu instructions\n", parts[j], count);
+		cs_free(b, count);
+		cs_close(&h);
+	}
+
+	cs_free(a, count);
+	cs_close(&full);
+}
+
+// an arch which always fills the whole detail refuses any part
+static void test_unsupported()
+{
+	csh h;
+	cs_insn *insn;
+	size_t count;
+
+	if (cs_open(CS_ARCH_RISCV, CS_MODE_RISCV64, &h) != CS_ERR_OK)
+		return;
+
+	printf("****************\n");
+	printf("Platform: RISCV64 (unsupported)\n");
+
+	assert(cs_option(h, CS_OPT_DETAIL,
+			 CS_OPT_ON | CS_OPT_DETAIL_GROUPS) == CS_ERR_OPTION);
+	// the detail option stays as it was
+	count = cs_disasm(h, (const uint8_t *)RISCV_CODE,
+			  sizeof(RISCV_CODE) - 1, 0x1000, 0, &insn);
+	assert(count && !insn[0].detail);
+	cs_free(insn, count);
+
+	assert(cs_option(h, CS_OPT_DETAIL, CS_OPT_ON) == CS_ERR_OK);
+	printf("Parts 0x%x: refused\n", CS_OPT_DETAIL_GROUPS);
+	cs_close(&h);
+}
+
+static void test()
+{
+	struct platform platforms[] = {
+		{ CS_ARCH_X86, CS_MODE_64, (const uint8_t *)X86_CODE64,
+		  sizeof(X86_CODE64) - 1, sizeof(cs_x86_op), 0,
+		  "X86 64 (Intel syntax)" },
+		{ CS_ARCH_ARM, CS_MODE_ARM, (const uint8_t *)ARM_CODE,
+		  sizeof(ARM_CODE) - 1, sizeof(cs_arm_op),
+		  CS_OPT_DETAIL_IMPLICIT_REGS | CS_OPT_DETAIL_ARCH_EXTRA,
+		  "ARM" },
+		{ CS_ARCH_MIPS, CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)MIPS_CODE, sizeof(MIPS_CODE) - 1,
+		  sizeof(cs_mips_op), CS_OPT_DETAIL_ARCH_EXTRA,
+		  "MIPS-32 (Big-endian)" },
+		{ CS_ARCH_PPC, CS_MODE_BIG_ENDIAN, (const uint8_t *)PPC_CODE,
+		  sizeof(PPC_CODE) - 1, sizeof(cs_ppc_op),
+		  CS_OPT_DETAIL_IMPLICIT_REGS | CS_OPT_DETAIL_ARCH_EXTRA,
+		  "PPC-64" },
+		{ CS_ARCH_LOONGARCH, CS_MODE_LOONGARCH64,
+		  (const uint8_t *)LOONGARCH_CODE, sizeof(LOONGARCH_CODE) - 1,
+		  sizeof(cs_loongarch_op), CS_OPT_DETAIL_ARCH_EXTRA,
+		  "LoongArch64" },
+	};
+
+	for (size_t i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++)
+		test_platform(&platforms[i]);
+	test_unsupported();
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
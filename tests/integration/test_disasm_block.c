@@ -0,0 +1,217 @@
+// This sample code demonstrates the API cs_disasm_block(), which decodes one
+// basic block at a time, up to and including its jump, call or return.
+// The instructions of the blocks must be the same as the ones of cs_disasm().
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#define MAX_BLOCKS 8
+
+struct expected_block {
+	size_t count;
+	cs_block_end end;
+	bool has_target;
+	uint64_t target;
+};
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	const uint8_t *code;
+	size_t size;
+	const char *comment;
+	struct expected_block blocks[MAX_BLOCKS];
+};
+
+#define X86_CODE64 \
+	"\x55\x48\x89\x04\x24\xe9\xea\xbe\xad\xde\xff\x25\x00\x00\x00\x00\xe8\x00\x00\x00\x00\xc3"
+// it eq; beq; nop; b .
+#define THUMB_CODE "\x08\xbf\x01\xe0\x00\xbf\xfe\xe7"
+// addiu; b (delay slot: nop); jr $ra (delay slot: addiu)
+#define MIPS_CODE \
+	"\x24\x02\x00\x01\x10\x00\x00\x03\x00\x00\x00\x00\x03\xe0\x00\x08\x24\x04\x00\x05"
+// mov; ba (delay slot: nop); ba,a (no delay slot); nop; call (delay slot:
+// nop); ret (delay slot: nop)
+#define SPARC_CODE \
+	"\x82\x10\x20\x01\x10\x80\x00\x02\x01\x00\x00\x00\x30\x80\x00\x02\x01\x00\x00\x00\x40\x00\x00\x05\x01\x00\x00\x00\x81\xc7\xe0\x08\x01\x00\x00\x00"
+// mov; bra (delay slot: nop); mov; rts (delay slot: nop)
+#define SH_CODE "\xe0\x01\xa0\x02\x00\x09\xe0\x02\x00\x0b\x00\x09"
+
+static void check_insn(csh handle, const cs_insn *a, const cs_insn *b)
+{
+	const uint16_t *ra, *rb;
+	const uint8_t *ga, *gb;
+	uint8_t ca, cb;
+
+	assert(a->address == b->address && a->id == b->id);
+	assert(a->size == b->size);
+	assert(!strcmp(a->mnemonic, b->mnemonic));
+	assert(!strcmp(a->op_str, b->op_str));
+	assert(!a->detail == !b->detail);
+	if (!a->detail)
+		return;
+
+	assert(cs_detail_op_count(handle, a) == cs_detail_op_count(handle, b));
+	ra = cs_detail_regs_read(handle, a, &ca);
+	rb = cs_detail_regs_read(handle, b, &cb);
+	assert(ra && rb && ca == cb && !memcmp(ra, rb, ca * sizeof(*ra)));
+	ga = cs_detail_groups(handle, a, &ca);
+	gb = cs_detail_groups(handle, b, &cb);
+	assert(ga && gb && ca == cb && !memcmp(ga, gb, ca));
+}
+
+static void test_platform(const struct platform *p, size_t detail)
+{
+	csh handle;
+	cs_insn *insn;
+	cs_block block;
+	size_t count, i, j, k, pos;
+	cs_err err;
+
+	err = cs_open(p->arch, p->mode, &handle);
+	if (err) {
+		if (cs_support(p->arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		}
+		return;
+	}
+	cs_option(handle, CS_OPT_DETAIL, detail);
+
+	printf("****************\n");
+	printf("Platform: %s, detail 0x%zx\n", p->comment, detail);
+
+	count = cs_disasm(handle, p->code, p->size, 0x1000, 0, &insn);
+	assert(count);
+
+	for (i = 0, j = 0, pos = 0; pos < p->size; i++) {
+		const struct expected_block *e = &p->blocks[i];
+
+		assert(i < MAX_BLOCKS && e->count);
+		assert(cs_disasm_block(handle, p->code + pos, p->size - pos,
+				       0x1000 + pos, &block) == e->count);
+		assert(block.count == e->count && block.end == e->end);
+		assert(block.has_target == e->has_target);
+		if (e->has_target)
+			assert(block.target == e->target);
+
+		printf("Block 0x%" PRIx64 "-0x%" PRIx64 ":", 0x1000 + pos,
+		       block.next);
+		for (k = 0; k < block.count; k++, j++) {
+			assert(j < count);
+			check_insn(handle, &block.insn[k], &insn[j]);
+			printf(" %s;", block.insn[k].mnemonic);
+		}
+		if (block.has_target)
+			printf(" -> 0x%" PRIx64, block.target);
+		printf("\n");
+
+		assert(block.next == insn[j - 1].address + insn[j - 1].size);
+		pos = (size_t)(block.next - 0x1000);
+		cs_free(block.insn, block.count);
+	}
+	assert(j == count && !p->blocks[i].count);
+
+	cs_free(insn, count);
+	cs_close(&handle);
+}
+
+// a block never starts inside an IT block left over by the previous one
+static void test_it_block()
+{
+	csh handle;
+	cs_block block;
+
+	if (cs_open(CS_ARCH_ARM, CS_MODE_THUMB, &handle) != CS_ERR_OK)
+		return;
+
+	// only "it eq", the buffer ends before its conditional insn
+	assert(cs_disasm_block(handle, (const uint8_t *)THUMB_CODE, 2, 0x1000,
+			       &block) == 1);
+	assert(block.end == CS_BLOCK_END_NONE && block.next == 0x1002);
+	cs_free(block.insn, block.count);
+
+	assert(cs_disasm_block(handle, (const uint8_t *)THUMB_CODE + 4, 4,
+			       0x1004, &block) == 2);
+	assert(!strcmp(block.insn[0].mnemonic, "nop"));
+	cs_free(block.insn, block.count);
+
+	cs_close(&handle);
+}
+
+static void test()
+{
+	struct platform platforms[] = {
+		{ CS_ARCH_X86,
+		  CS_MODE_64,
+		  (const uint8_t *)X86_CODE64,
+		  sizeof(X86_CODE64) - 1,
+		  "X86 64 (Intel syntax)",
+		  {
+			  { 3, CS_BLOCK_END_JUMP, true, 0xffffffffdeadcef4 },
+			  { 1, CS_BLOCK_END_JUMP, false, 0 },
+			  { 1, CS_BLOCK_END_CALL, true, 0x1015 },
+			  { 1, CS_BLOCK_END_RET, false, 0 },
+		  } },
+		{ CS_ARCH_ARM,
+		  CS_MODE_THUMB,
+		  (const uint8_t *)THUMB_CODE,
+		  sizeof(THUMB_CODE) - 1,
+		  "Thumb (IT block)",
+		  {
+			  { 2, CS_BLOCK_END_JUMP, true, 0x1008 },
+			  { 2, CS_BLOCK_END_JUMP, true, 0x1006 },
+		  } },
+		{ CS_ARCH_MIPS,
+		  CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)MIPS_CODE,
+		  sizeof(MIPS_CODE) - 1,
+		  "MIPS-32 (Big-endian)",
+		  {
+			  { 3, CS_BLOCK_END_JUMP, true, 0x1014 },
+			  { 2, CS_BLOCK_END_RET, false, 0 },
+		  } },
+		{ CS_ARCH_SPARC,
+		  CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)SPARC_CODE,
+		  sizeof(SPARC_CODE) - 1,
+		  "Sparc",
+		  {
+			  { 3, CS_BLOCK_END_JUMP, true, 0x100c },
+			  { 1, CS_BLOCK_END_JUMP, true, 0x1014 },
+			  { 3, CS_BLOCK_END_CALL, true, 0x1028 },
+			  { 2, CS_BLOCK_END_RET, false, 0 },
+		  } },
+		{ CS_ARCH_SH,
+		  CS_MODE_SH4A | CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)SH_CODE,
+		  sizeof(SH_CODE) - 1,
+		  "SH4A",
+		  {
+			  { 3, CS_BLOCK_END_JUMP, true, 0x100a },
+			  { 3, CS_BLOCK_END_RET, false, 0 },
+		  } },
+	};
+	// no detail, full detail & compact detail
+	size_t details[] = { CS_OPT_OFF, CS_OPT_ON,
+			     CS_OPT_ON | CS_OPT_DETAIL_COMPACT };
+
+	for (size_t i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++)
+		for (size_t j = 0; j < sizeof(details) / sizeof(details[0]); j++)
+			test_platform(&platforms[i], details[j]);
+
+	test_it_block();
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,120 @@
+// This sample code demonstrates the API cs_disasm_cb(), which hands every
+// decoded instruction to a callback instead of returning them in an array.
+// The instructions must be the same as the ones of cs_disasm().
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xeb\x04\xff\xff\xff\xff\xf0\x48\x0f\xc1\x07\xf3\x48\xa5\xc3"
+#define ADDRESS 0x1000
+
+struct walk {
+	csh handle;
+	const cs_insn *expected;
+	size_t count;
+	size_t seen;
+	size_t stop_at;	// stop after this many insns
+	bool follow;	// follow direct jumps
+};
+
+static cs_cb_action CAPSTONE_API check_insn(csh handle, cs_insn *insn,
+					    uint64_t *next, void *user_data)
+{
+	struct walk *w = user_data;
+	const cs_insn *e;
+
+	assert(handle == w->handle && w->seen < w->count);
+	e = &w->expected[w->seen++];
+	assert(insn->address == e->address && insn->id == e->id);
+	assert(insn->size == e->size);
+	assert(*next == insn->address + insn->size);
+	assert(!strcmp(insn->mnemonic, e->mnemonic));
+	assert(!strcmp(insn->op_str, e->op_str));
+	assert(insn->detail && insn->detail->x86.op_count ==
+				       e->detail->x86.op_count);
+	printf("0x%" PRIx64 ":\t%s\t%s\n", insn->address, insn->mnemonic,
+	       insn->op_str);
+
+	if (w->seen == w->stop_at)
+		return CS_CB_STOP;
+	if (w->follow && cs_insn_group(handle, insn, CS_GRP_JUMP) &&
+	    insn->detail->x86.operands[0].type == X86_OP_IMM) {
+		*next = insn->detail->x86.operands[0].imm;
+		return CS_CB_SKIP;
+	}
+
+	return CS_CB_CONTINUE;
+}
+
+static void test()
+{
+	struct walk w = { 0 };
+	cs_insn *insn;
+	size_t count;
+
+	assert(cs_open(CS_ARCH_X86, CS_MODE_64, &w.handle) == CS_ERR_OK);
+	cs_option(w.handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	count = cs_disasm(w.handle, (const uint8_t *)X86_CODE64,
+			  sizeof(X86_CODE64) - 1, ADDRESS, 0, &insn);
+	// the 4 bytes after the jmp are not valid code
+	assert(count == 3);
+	w.expected = insn;
+	w.count = count;
+
+	printf("****************\n");
+	printf("Linear sweep\n");
+	assert(cs_disasm_cb(w.handle, (const uint8_t *)X86_CODE64,
+			    sizeof(X86_CODE64) - 1, ADDRESS, check_insn,
+			    &w) == count);
+	assert(w.seen == count);
+
+	printf("****************\n");
+	printf("Stop after 2 instructions\n");
+	w.seen = 0;
+	w.stop_at = 2;
+	assert(cs_disasm_cb(w.handle, (const uint8_t *)X86_CODE64,
+			    sizeof(X86_CODE64) - 1, ADDRESS, check_insn,
+			    &w) == 2);
+	cs_free(insn, count);
+
+	// the same, following the jmp over the invalid bytes
+	count = cs_disasm(w.handle, (const uint8_t *)X86_CODE64 + 14,
+			  sizeof(X86_CODE64) - 1 - 14, ADDRESS + 14, 0, &insn);
+	assert(count == 3);
+	cs_insn all[6];
+	cs_insn *head;
+	assert(cs_disasm(w.handle, (const uint8_t *)X86_CODE64, 10, ADDRESS, 0,
+			 &head) == 3);
+	memcpy(all, head, 3 * sizeof(*head));
+	memcpy(all + 3, insn, 3 * sizeof(*insn));
+
+	printf("****************\n");
+	printf("Follow jumps\n");
+	w.expected = all;
+	w.count = 6;
+	w.seen = 0;
+	w.stop_at = 0;
+	w.follow = true;
+	assert(cs_disasm_cb(w.handle, (const uint8_t *)X86_CODE64,
+			    sizeof(X86_CODE64) - 1, ADDRESS, check_insn,
+			    &w) == 6);
+	assert(w.seen == 6);
+
+	cs_free(head, 3);
+	cs_free(insn, count);
+	cs_close(&w.handle);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+// This sample code demonstrates the API cs_disasm_into(), which decodes
+// into instruction and detail buffers owned by the caller.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff"
+
+#define BATCH 2
+
+static void check_same(cs_insn *a, cs_insn *b)
+{
+	assert(a->id == b->id);
+	assert(a->address == b->address);
+	assert(a->size == b->size);
+	assert(memcmp(a->bytes, b->bytes, a->size) == 0);
+	assert(strcmp(a->mnemonic, b->mnemonic) == 0);
+	assert(strcmp(a->op_str, b->op_str) == 0);
+	assert(a->detail && b->detail);
+	assert(a->detail->regs_read_count == b->detail->regs_read_count);
+	assert(a->detail->regs_write_count == b->detail->regs_write_count);
+	assert(a->detail->groups_count == b->detail->groups_count);
+	assert(a->detail->x86.op_count == b->detail->x86.op_count);
+	assert(memcmp(a->detail->x86.operands, b->detail->x86.operands,
+		      sizeof(cs_x86_op) * a->detail->x86.op_count) == 0);
+}
+
+static void test()
+{
+	csh handle;
+	cs_err err;
+	cs_insn *all;
+	size_t all_count;
+	cs_insn insn[BATCH];
+	cs_detail detail[BATCH];
+	const uint8_t *code = (const uint8_t *)X86_CODE64;
+	size_t size = sizeof(X86_CODE64) - 1;
+	uint64_t address = 0x1000;
+	size_t i = 0, n;
+
+	err = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
+	if (err) {
+		if (cs_support(CS_ARCH_X86)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		} else
+			return;
+	}
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	all_count = cs_disasm(handle, code, size, address, 0, &all);
+	assert(all_count == 6);
+
+	// Details are requested, but no buffer for them is given.
+	n = cs_disasm_into(handle, &code, &size, &address, insn, NULL, BATCH);
+	assert(n == 0 && cs_errno(handle) == CS_ERR_DETAIL);
+
+	// Decode the buffer in batches, reusing the same arrays.
+	while ((n = cs_disasm_into(handle, &code, &size, &address, insn, detail,
+				   BATCH))) {
+		for (size_t k = 0; k < n; k++, i++) {
+			assert(insn[k].detail == &detail[k]);
+			check_same(&all[i], &insn[k]);
+			printf("0x%" PRIx64 ":\t%s\t%s\n", insn[k].address,
+			       insn[k].mnemonic, insn[k].op_str);
+		}
+	}
+	assert(i == all_count);
+	assert(size == 0);
+	assert(address == 0x1000 + sizeof(X86_CODE64) - 1);
+
+	cs_free(all, all_count);
+	cs_close(&handle);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,104 @@
+// This sample code demonstrates the API cs_disasm_parallel(), which splits
+// the disassembling of large buffers over multiple threads.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff"
+#define MIPS_CODE \
+	"\x0c\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00\x34\x21\x34\x56"
+
+// large enough to get split over several threads
+#define CODE_SIZE (256 * 1024)
+
+static void check_same(csh handle, cs_insn *a, cs_insn *b)
+{
+	cs_detail da, db;
+	assert(a->id == b->id);
+	assert(a->address == b->address);
+	assert(a->size == b->size);
+	assert(memcmp(a->bytes, b->bytes, a->size) == 0);
+	assert(strcmp(a->mnemonic, b->mnemonic) == 0);
+	assert(strcmp(a->op_str, b->op_str) == 0);
+	assert(a->detail && b->detail);
+	// only the part of the arch is allocated
+	memset(&da, 0, sizeof(da));
+	memset(&db, 0, sizeof(db));
+	assert(cs_detail_unpack(handle, a, &da) == CS_ERR_OK);
+	assert(cs_detail_unpack(handle, b, &db) == CS_ERR_OK);
+	assert(memcmp(&da, &db, sizeof(cs_detail)) == 0);
+}
+
+static void test_platform(cs_arch arch, cs_mode mode, const char *pattern,
+			  size_t pattern_size, size_t insn_count)
+{
+	csh handle;
+	cs_err err;
+	cs_insn *serial, *parallel;
+	size_t serial_count, count, i, t;
+	uint8_t *code;
+
+	err = cs_open(arch, mode, &handle);
+	if (err) {
+		if (cs_support(arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		} else
+			return;
+	}
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+
+	code = malloc(CODE_SIZE);
+	assert(code);
+	for (i = 0; i < CODE_SIZE; i++)
+		code[i] = pattern[i % pattern_size];
+
+	serial_count = cs_disasm(handle, code, CODE_SIZE, 0x1000, 0, &serial);
+	assert(serial_count == insn_count);
+
+	for (t = 1; t <= 4; t++) {
+		count = cs_disasm_parallel(handle, code, CODE_SIZE, 0x1000, 0,
+					   t, &parallel);
+		assert(count == serial_count);
+		for (i = 0; i < count; i++)
+			check_same(handle, &serial[i], &parallel[i]);
+		printf("%zu thread(s): %zu instructions\n", t, count);
+		cs_free(parallel, count);
+	}
+
+	// An invalid instruction ends the result, like with cs_disasm().
+	memset(code + serial[serial_count / 2].address - 0x1000, 0xff, 4);
+	count = cs_disasm_parallel(handle, code, CODE_SIZE, 0x1000, 0, 4,
+				   &parallel);
+	assert(count == serial_count / 2);
+	cs_free(parallel, count);
+
+	cs_free(serial, serial_count);
+	free(code);
+	cs_close(&handle);
+}
+
+static void test()
+{
+	// fixed-width instructions
+	test_platform(CS_ARCH_MIPS, CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN,
+		      MIPS_CODE, sizeof(MIPS_CODE) - 1, CODE_SIZE / 4);
+	// variable-width instructions, 6 in each 26 bytes of the pattern
+	test_platform(CS_ARCH_X86, CS_MODE_64, X86_CODE64,
+		      sizeof(X86_CODE64) - 1,
+		      CODE_SIZE / (sizeof(X86_CODE64) - 1) * 6 + 2);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
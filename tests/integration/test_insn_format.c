@@ -0,0 +1,131 @@
+// This sample code demonstrates the API cs_insn_format(), which prints the
+// text of an instruction disassembled with CS_OPT_NO_TEXT.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	const uint8_t *code;
+	size_t size;
+	const char *comment;
+};
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\xf0\x48\x0f\xc1\x07\xf3\x48\xa5"
+#define ARM_CODE \
+	"\xed\xff\xff\xeb\x04\xe0\x2d\xe5\x00\x00\x00\x00\xe0\x83\x22\xe5\xf1\x02\x03\x0e"
+#define THUMB_CODE \
+	"\x70\x47\x00\xf0\x10\xe8\xeb\x46\x83\xb0\xc9\x68\x1f\xb1\x30\xbf\xaf\xf3\x20\x84"
+// ite eq; moveq r0, #0x17; movne.w r0, #0xffffffff
+#define THUMB_IT_CODE "\x0c\xbf\x17\x20\x4f\xf0\xff\x30"
+// vpt.i8 eq, q0, q0; vaddt.i32 q0, q1, q2
+#define THUMB_VPT_CODE "\x41\xfe\x00\x0f\x22\xef\x44\x08"
+#define PPC_CODE \
+	"\x43\x20\x0c\x07\x41\x56\xff\x17\x80\x20\x00\x00\x80\x3f\x00\x00\x10\x43\x23\x0e"
+#define MIPS_CODE \
+	"\x0c\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00"
+#define RISCV_CODE \
+	"\x37\x34\x00\x00\x97\x82\x00\x00\x01\x45\x82\x80\x13\x01\x01\xff"
+
+static void test_platform(const struct platform *p)
+{
+	csh handle;
+	cs_insn *text, *insn;
+	size_t count, i;
+	char buf[sizeof(insn->mnemonic) + sizeof(insn->op_str)];
+	char expected[sizeof(buf)];
+	cs_err err;
+
+	err = cs_open(p->arch, p->mode, &handle);
+	if (err) {
+		if (cs_support(p->arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		}
+		return;
+	}
+
+	printf("****************\n");
+	printf("Platform: %s\n", p->comment);
+
+	// reference text
+	count = cs_disasm(handle, p->code, p->size, 0x1000, 0, &text);
+	assert(count);
+
+	// decode without text, then print every insn on demand
+	cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON);
+	cs_option(handle, CS_OPT_NO_TEXT, CS_OPT_ON);
+	insn = cs_malloc(handle);
+	const uint8_t *code = p->code;
+	size_t size = p->size;
+	uint64_t address = 0x1000;
+	for (i = 0; cs_disasm_iter(handle, &code, &size, &address, insn); i++) {
+		cs_detail detail, after;
+
+		assert(i < count);
+		assert(insn->mnemonic[0] == '\0');
+		memset(&detail, 0, sizeof(detail));
+		memset(&after, 0, sizeof(after));
+		assert(cs_detail_unpack(handle, insn, &detail) == CS_ERR_OK);
+		assert(cs_insn_format(handle, insn, buf));
+		snprintf(expected, sizeof(expected), "%s%s%s", text[i].mnemonic,
+			 text[i].op_str[0] ? " " : "", text[i].op_str);
+		assert(!strcmp(buf, expected));
+		// the detail stays as it was
+		assert(cs_detail_unpack(handle, insn, &after) == CS_ERR_OK);
+		assert(!memcmp(&detail, &after, sizeof(detail)));
+		printf("0x%" PRIx64 ":\t%s\n", insn->address, buf);
+	}
+	assert(i == count);
+
+	// an insn with text is printed as it is
+	assert(cs_insn_format(handle, &text[0], buf));
+	assert(!strncmp(buf, text[0].mnemonic, strlen(text[0].mnemonic)));
+
+	cs_free(insn, 1);
+	cs_free(text, count);
+	cs_close(&handle);
+}
+
+static void test()
+{
+	struct platform platforms[] = {
+		{ CS_ARCH_X86, CS_MODE_64, (const uint8_t *)X86_CODE64,
+		  sizeof(X86_CODE64) - 1, "X86 64 (Intel syntax)" },
+		{ CS_ARCH_ARM, CS_MODE_ARM, (const uint8_t *)ARM_CODE,
+		  sizeof(ARM_CODE) - 1, "ARM" },
+		{ CS_ARCH_ARM, CS_MODE_THUMB, (const uint8_t *)THUMB_CODE,
+		  sizeof(THUMB_CODE) - 1, "Thumb-2" },
+		{ CS_ARCH_ARM, CS_MODE_THUMB, (const uint8_t *)THUMB_IT_CODE,
+		  sizeof(THUMB_IT_CODE) - 1, "Thumb-2 (IT block)" },
+		{ CS_ARCH_ARM, CS_MODE_THUMB | CS_MODE_MCLASS | CS_MODE_V8,
+		  (const uint8_t *)THUMB_VPT_CODE, sizeof(THUMB_VPT_CODE) - 1,
+		  "Thumb-2 MVE (VPT block)" },
+		{ CS_ARCH_PPC, CS_MODE_BIG_ENDIAN, (const uint8_t *)PPC_CODE,
+		  sizeof(PPC_CODE) - 1, "PPC-64" },
+		{ CS_ARCH_MIPS, CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)MIPS_CODE, sizeof(MIPS_CODE) - 1,
+		  "MIPS-32 (Big-endian)" },
+		{ CS_ARCH_RISCV, CS_MODE_RISCV64 | CS_MODE_RISCVC,
+		  (const uint8_t *)RISCV_CODE, sizeof(RISCV_CODE) - 1,
+		  "RISCV64 compressed" },
+	};
+
+	for (size_t i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++)
+		test_platform(&platforms[i]);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -0,0 +1,95 @@
+// This sample code demonstrates the API cs_insn_size(), which only returns
+// the length of an instruction, without disassembling it.
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <capstone/platform.h>
+#include <capstone/capstone.h>
+
+struct platform {
+	cs_arch arch;
+	cs_mode mode;
+	const uint8_t *code;
+	size_t size;
+	const char *comment;
+};
+
+#define X86_CODE64 \
+	"\x55\x48\x8b\x05\xb8\x13\x00\x00\xe9\xea\xbe\xad\xde\xff\x25\x23\x01\x00\x00\xe8\xdf\xbe\xad\xde\x74\xff\x62\xf1\x7c\x48\x10\x44\x24\x01\xf3\x48\xa5"
+#define THUMB_CODE \
+	"\x70\x47\x00\xf0\x10\xe8\xeb\x46\x83\xb0\xc9\x68\x1f\xb1\x30\xbf\xaf\xf3\x20\x84"
+#define SYSZ_CODE \
+	"\xed\x00\x00\x00\x00\x1a\x5a\x0f\x1f\xff\xc2\x09\x80\x00\x00\x00\x07\xf7"
+#define RISCV_CODE \
+	"\x37\x34\x00\x00\x97\x82\x00\x00\x01\x45\x82\x80\x13\x01\x01\xff"
+#define MIPS_CODE \
+	"\x0c\x10\x00\x97\x00\x00\x00\x00\x24\x02\x00\x0c\x8f\xa2\x00\x00"
+
+static void test_platform(const struct platform *p)
+{
+	csh handle;
+	cs_insn *insn;
+	const uint8_t *code = p->code;
+	size_t size = p->size;
+	uint64_t address = 0x1000;
+	cs_err err;
+
+	err = cs_open(p->arch, p->mode, &handle);
+	if (err) {
+		if (cs_support(p->arch)) {
+			printf("Failed on cs_open() with error returned: %u\n",
+			       err);
+			abort();
+		}
+		return;
+	}
+
+	printf("%s:", p->comment);
+	insn = cs_malloc(handle);
+	while (size) {
+		size_t len = cs_insn_size(handle, code, size, address);
+		const uint8_t *start = code;
+		assert(cs_disasm_iter(handle, &code, &size, &address, insn));
+		assert(len == (size_t)(code - start));
+		printf(" %zu", len);
+	}
+	printf("\n");
+
+	// Too short for the first instruction.
+	size_t first = cs_insn_size(handle, p->code, p->size, 0x1000);
+	assert(cs_insn_size(handle, p->code, first - 1, 0x1000) == 0);
+
+	cs_free(insn, 1);
+	cs_close(&handle);
+}
+
+static void test()
+{
+	struct platform platforms[] = {
+		{ CS_ARCH_X86, CS_MODE_64, (const uint8_t *)X86_CODE64,
+		  sizeof(X86_CODE64) - 1, "X86 64" },
+		{ CS_ARCH_ARM, CS_MODE_THUMB, (const uint8_t *)THUMB_CODE,
+		  sizeof(THUMB_CODE) - 1, "Thumb-2" },
+		{ CS_ARCH_SYSTEMZ, CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)SYSZ_CODE, sizeof(SYSZ_CODE) - 1, "SystemZ" },
+		{ CS_ARCH_RISCV, CS_MODE_RISCV64 | CS_MODE_RISCVC,
+		  (const uint8_t *)RISCV_CODE, sizeof(RISCV_CODE) - 1,
+		  "RISCV64 compressed" },
+		{ CS_ARCH_MIPS, CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN,
+		  (const uint8_t *)MIPS_CODE, sizeof(MIPS_CODE) - 1,
+		  "MIPS-32 (Big-endian)" },
+	};
+
+	for (size_t i = 0; i < sizeof(platforms) / sizeof(platforms[0]); i++)
+		test_platform(&platforms[i]);
+}
+
+int main()
+{
+	test();
+
+	return 0;
+}
@@ -316,6 +316,55 @@ bool test_printuint64_bang()
 	return true;
 }
 
+static bool test_print_num_digits()
+{
+	printf("Test test_print_num_digits\n");
+
+	SStream OS = { 0 };
+	SStream_Init(&OS);
+	char cmp_buf[64];
+	uint64_t val = 1;
+	int i;
+
+	// Every digit count, and the values around the carries.
+	for (i = 0; i < 64; i++, val <<= 1) {
+		uint64_t vals[] = { val, val - 1, val * 10 - 1, val * 10,
+				    val * 10 + 1 };
+		for (size_t k = 0; k < sizeof(vals) / sizeof(vals[0]); k++) {
+			uint64_t v = vals[k];
+			SStream_Flush(&OS, NULL);
+			printUInt64(&OS, v);
+			snprintf(cmp_buf, sizeof(cmp_buf),
+				 v > HEX_THRESHOLD ? "0x%" PRIx64 : "%" PRIu64,
+				 v);
+			CHECK_OS_EQUAL_RET_FALSE(OS, cmp_buf);
+
+			SStream_Flush(&OS, NULL);
+			printExpr(&OS, v);
+			snprintf(cmp_buf, sizeof(cmp_buf), "%" PRIu64, v);
+			CHECK_OS_EQUAL_RET_FALSE(OS, cmp_buf);
+
+			SStream_Flush(&OS, NULL);
+			printInt32BangDec(&OS, (int32_t)v);
+			if ((int32_t)v >= 0)
+				snprintf(cmp_buf, sizeof(cmp_buf), "#%" PRIu32,
+					 (uint32_t)v);
+			else
+				snprintf(cmp_buf, sizeof(cmp_buf), "#-%" PRIu32,
+					 -(uint32_t)v);
+			CHECK_OS_EQUAL_RET_FALSE(OS, cmp_buf);
+		}
+	}
+
+	SStream_Flush(&OS, NULL);
+	printInt32BangDec(&OS, INT32_MIN);
+	CHECK_OS_EQUAL_RET_FALSE(OS, "#-2147483648");
+	SStream_Flush(&OS, NULL);
+	printExpr(&OS, UINT64_MAX);
+	CHECK_OS_EQUAL_RET_FALSE(OS, "18446744073709551615");
+	return true;
+}
+
 bool test_trimls() {
 	printf("Test test_replc\n");
 
@@ -398,6 +447,28 @@ bool test_copy_mnem_opstr() {
 	CHECK_STR_EQUAL_RET_FALSE(mnem_6, "AAA");
 	CHECK_STR_EQUAL_RET_FALSE(opstr_6, "");
 
+	// The end of the mnemonic is kept over trimming and replacing.
+	char mnem_8[8] = { 0 };
+	char opstr_8[8] = { 0 };
+	SStream_Flush(&OS, NULL);
+	SStream_concat0(&OS, "\t A");
+	SStream_concat(&OS, "%s", "AA\tB");
+	SStream_concat1(&OS, 'B');
+	SStream_trimls(&OS);
+	SStream_extract_mnem_opstr(&OS, mnem_8, sizeof(mnem_8), opstr_8, sizeof(opstr_8));
+	CHECK_STR_EQUAL_RET_FALSE(mnem_8, "AAA");
+	CHECK_STR_EQUAL_RET_FALSE(opstr_8, "BB");
+
+	SStream_replc_str(&OS, '\t', ".CC ");
+	SStream_extract_mnem_opstr(&OS, mnem_8, sizeof(mnem_8), opstr_8, sizeof(opstr_8));
+	CHECK_STR_EQUAL_RET_FALSE(mnem_8, "AAA.CC");
+	CHECK_STR_EQUAL_RET_FALSE(opstr_8, "BB");
+
+	SStream_replc(&OS, ' ', '.');
+	SStream_extract_mnem_opstr(&OS, mnem_8, sizeof(mnem_8), opstr_8, sizeof(opstr_8));
+	CHECK_STR_EQUAL_RET_FALSE(mnem_8, "AAA.CC.");
+	CHECK_STR_EQUAL_RET_FALSE(opstr_8, "");
+
 	return true;
 }
 
@@ -508,6 +579,42 @@ bool test_replc_str()
 	return true;
 }
 
+static bool test_mnem_only()
+{
+	printf("Test test_mnem_only\n");
+
+	SStream OS = { 0 };
+	SStream_Init(&OS);
+	SStream_MnemOnly(&OS);
+	SStream_concat0(&OS, "\t");
+	SStream_concat0(&OS, "add");
+	SStream_concat(&OS, "%s", "eq\tr0, ");
+	CHECK_OS_EQUAL_RET_FALSE(OS, "\taddeq");
+	CHECK_INT_EQUAL_RET_FALSE(OS.index, 6);
+	printInt32(&OS, 1);
+	SStream_concat1(&OS, 'A');
+	CHECK_OS_EQUAL_RET_FALSE(OS, "\taddeq");
+
+	/// Stays closed after the mnemonic was cut.
+	SStream_Close(&OS);
+	SStream_Open(&OS);
+	SStream_concat0(&OS, "r1");
+	CHECK_OS_EQUAL_RET_FALSE(OS, "\taddeq");
+
+	/// Without operands the stream is never closed by itself.
+	SStream_Flush(&OS, NULL);
+	SStream_MnemOnly(&OS);
+	SStream_concat0(&OS, "nop");
+	SStream_concat1(&OS, 'w');
+	CHECK_OS_EQUAL_RET_FALSE(OS, "nopw");
+	SStream_Close(&OS);
+	SStream_Open(&OS);
+	SStream_concat0(&OS, " r1");
+	CHECK_OS_EQUAL_RET_FALSE(OS, "nopw");
+
+	return true;
+}
+
 int main()
 {
 	bool result = true;
@@ -521,10 +628,12 @@ int main()
 	result &= test_printint64_bang();
 	result &= test_printuint32_bang();
 	result &= test_printuint64_bang();
+	result &= test_print_num_digits();
 	result &= test_replc();
 	result &= test_replc_str();
 	result &= test_copy_mnem_opstr();
 	result &= test_trimls();
+	result &= test_mnem_only();
 	if (result) {
 		printf("All tests passed.\n");
 	} else {
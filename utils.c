@@ -58,7 +58,7 @@ int cs_snprintf(char *buffer, size_t size, const char *fmt, ...)
 	return ret;
 }
 
-bool arr_exist8(unsigned char *arr, unsigned char max, unsigned int id)
+bool arr_exist8(const unsigned char *arr, unsigned char max, unsigned int id)
 {
 	int i;
 
@@ -70,7 +70,7 @@ bool arr_exist8(unsigned char *arr, unsigned char max, unsigned int id)
 	return false;
 }
 
-bool arr_exist(uint16_t *arr, unsigned char max, unsigned int id)
+bool arr_exist(const uint16_t *arr, unsigned char max, unsigned int id)
 {
 	int i;
 
@@ -27,6 +27,7 @@ unsigned int count_positive8(const unsigned char *list);
 char *cs_strdup(const char *str);
 
 #define MIN(x, y) ((x) < (y) ? (x) : (y))
+#define MAX(x, y) ((x) > (y) ? (x) : (y))
 
 // we need this since Windows doesn't have snprintf()
 int cs_snprintf(char *buffer, size_t size, const char *fmt, ...);
@@ -34,8 +35,8 @@ int cs_snprintf(char *buffer, size_t size, const char *fmt, ...);
 #define CS_AC_IGNORE (1 << 7)
 
 // check if an id is existent in an array
-bool arr_exist8(unsigned char *arr, unsigned char max, unsigned int id);
-bool arr_exist(uint16_t *arr, unsigned char max, unsigned int id);
+bool arr_exist8(const unsigned char *arr, unsigned char max, unsigned int id);
+bool arr_exist(const uint16_t *arr, unsigned char max, unsigned int id);
 bool arr_exist_int(int *table, size_t table_size, int id);
 
 uint16_t readBytes16(MCInst *MI, const uint8_t *Bytes);